@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdbool.h>
+#include <string.h>
 
 // --- Constantes ---
 #define MAX_FILA 5   // Capacidade máxima da Fila de Peças Futuras
@@ -9,26 +10,16 @@
 
 // --- Estruturas de Dados ---
 
-// Estrutura para representar uma peça
-typedef struct {
-    char nome; // Tipo da peça ('I', 'O', 'T', 'L')
-    int id;    // Identificador único da peça
-} Peca;
-
-// Estrutura para a Fila Circular (FIFO)
-typedef struct {
-    Peca itens[MAX_FILA];
-    int frente;   // Índice da frente (remoção)
-    int tras;     // Índice do final (inserção)
-    int contador; // Número atual de elementos
-    int proximo_id; // Contador para gerar IDs únicos
-} FilaPecas;
-
-// Estrutura para a Pilha Linear (LIFO)
-typedef struct {
-    Peca itens[MAX_PILHA];
-    int topo;     // Índice do topo (-1 para pilha vazia)
-} PilhaPecas;
+// Peca, FilaPecas e PilhaPecas vêm do núcleo compartilhado: capacidades
+// fixas e pilha de reserva, sem as trocas do nível Mestre.
+#define NUCLEO_CAPACIDADE_FILA MAX_FILA
+#define NUCLEO_CAPACIDADE_PILHA MAX_PILHA
+#define NUCLEO_COM_RESERVA
+#define NUCLEO_FILA_EXTRA GeradorPecas gerador; // Gerador de tipos da partida
+#include "../Comum/gerador_pecas.h"
+#include "../Comum/nucleo_pecas.h"
+
+_Static_assert(GERADOR_NUM_TIPOS == NUCLEO_NUM_TIPOS, "um tipo de peca por valor sorteado");
 
 // --- Protótipos das Funções ---
 
@@ -37,7 +28,7 @@ Peca gerarPeca(FilaPecas *fila);
 void exibirEstadoAtual(FilaPecas *fila, PilhaPecas *pilha);
 
 // Funções da Fila (Queue - FIFO)
-void inicializarFila(FilaPecas *fila);
+void inicializarFila(FilaPecas *fila, uint64_t semente);
 bool estaCheiaFila(FilaPecas *fila);
 bool estaVaziaFila(FilaPecas *fila);
 void enqueue(FilaPecas *fila, Peca novaPeca);
@@ -63,17 +54,8 @@ void usarPecaReservada(PilhaPecas *pilha);
  * @return Peca A nova peça gerada.
  */
 Peca gerarPeca(FilaPecas *fila) {
-    Peca novaPeca;
-    const char tipos[] = {'I', 'O', 'T', 'L'};
-    int num_tipos = sizeof(tipos) / sizeof(tipos[0]);
-    
-    // Sorteia um tipo de peça
-    novaPeca.nome = tipos[rand() % num_tipos];
-    
-    // Atribui e incrementa o ID único
-    novaPeca.id = fila->proximo_id++;
-    
-    return novaPeca;
+    // Sorteia um tipo de peça e atribui o próximo ID único
+    return nucleoCriarPeca(fila, geradorSortearTipo(&fila->gerador));
 }
 
 /**
@@ -130,60 +112,43 @@ void exibirEstadoAtual(FilaPecas *fila, PilhaPecas *pilha) {
 
 // --- Funções da Fila (Queue - FIFO) ---
 
-void inicializarFila(FilaPecas *fila) {
-    fila->frente = 0;
-    fila->tras = MAX_FILA - 1; // Para manter o cálculo consistente no loop de inicialização
-    fila->contador = 0;
-    fila->proximo_id = 0;
+void inicializarFila(FilaPecas *fila, uint64_t semente) {
+    nucleoIniciarFila(fila);
     
-    // Inicializa o gerador de números aleatórios
-    srand((unsigned int)time(NULL));
+    // A mesma semente reproduz a mesma sequência de peças
+    geradorSemear(&fila->gerador, semente);
 
     // Pré-popula a fila para que ela comece cheia (5 elementos)
     printf("--- Inicializando Fila com %d pecas ---\n", MAX_FILA);
     for (int i = 0; i < MAX_FILA; i++) {
-        Peca p = gerarPeca(fila);
-        // Enqueue direto na inicialização para garantir que começa cheio
-        fila->itens[i] = p;
-        fila->contador++;
+        nucleoEnqueue(fila, gerarPeca(fila));
     }
-    fila->tras = MAX_FILA - 1; // Ajusta 'tras' para a posição correta após inicialização
-    printf("Fila inicializada. Proximo ID a ser gerado: %d\n\n", fila->proximo_id);
+    printf("Fila inicializada (semente: %llu). Proximo ID a ser gerado: %d\n\n",
+           (unsigned long long)semente, fila->proximo_id);
 }
 
 bool estaCheiaFila(FilaPecas *fila) {
-    return fila->contador == MAX_FILA;
+    return nucleoFilaCheia(fila);
 }
 
 bool estaVaziaFila(FilaPecas *fila) {
-    return fila->contador == 0;
+    return nucleoFilaVazia(fila);
 }
 
 void enqueue(FilaPecas *fila, Peca novaPeca) {
     // Note: No contexto deste desafio, esta função é chamada após um dequeue,
     // garantindo que a fila não esteja cheia, mas mantemos a validação.
-    if (estaCheiaFila(fila)) {
+    if (!nucleoEnqueue(fila, novaPeca)) {
         printf("\nERRO: Fila cheia. Impossivel enfileirar.\n");
-        return;
     }
-    
-    fila->tras = (fila->tras + 1) % MAX_FILA;
-    fila->itens[fila->tras] = novaPeca;
-    fila->contador++;
 }
 
 Peca dequeue(FilaPecas *fila) {
     Peca pecaRemovida = {'\0', -1}; 
     
-    if (estaVaziaFila(fila)) {
+    if (!nucleoDequeue(fila, &pecaRemovida)) {
         printf("\nERRO: Fila vazia. Impossivel desenfileirar.\n");
-        return pecaRemovida;
     }
-    
-    pecaRemovida = fila->itens[fila->frente];
-    fila->frente = (fila->frente + 1) % MAX_FILA;
-    fila->contador--;
-    
     return pecaRemovida;
 }
 
@@ -191,39 +156,32 @@ Peca dequeue(FilaPecas *fila) {
 // --- Funções da Pilha (Stack - LIFO) ---
 
 void inicializarPilha(PilhaPecas *pilha) {
-    pilha->topo = -1; // Pilha começa vazia
+    nucleoIniciarPilha(pilha); // Pilha começa vazia
 }
 
 bool estaCheiaPilha(PilhaPecas *pilha) {
-    return pilha->topo == MAX_PILHA - 1;
+    return nucleoPilhaCheia(pilha);
 }
 
 bool estaVaziaPilha(PilhaPecas *pilha) {
-    return pilha->topo == -1;
+    return nucleoPilhaVazia(pilha);
 }
 
 void push(PilhaPecas *pilha, Peca peca) {
-    if (estaCheiaPilha(pilha)) {
+    if (!nucleoPush(pilha, peca)) {
         printf("\nERRO: Pilha de reserva cheia. Impossivel reservar a peca [%c %d].\n", peca.nome, peca.id);
         return;
     }
     
-    pilha->topo++;
-    pilha->itens[pilha->topo] = peca;
     printf("\nSUCESSO: Peça [%c %d] reservada (PUSH) para a Pilha.\n", peca.nome, peca.id);
 }
 
 Peca pop(PilhaPecas *pilha) {
     Peca pecaRemovida = {'\0', -1};
     
-    if (estaVaziaPilha(pilha)) {
+    if (!nucleoPop(pilha, &pecaRemovida)) {
         printf("\nERRO: Pilha de reserva vazia. Nao ha pecas para usar.\n");
-        return pecaRemovida;
     }
-    
-    pecaRemovida = pilha->itens[pilha->topo];
-    pilha->topo--;
-    
     return pecaRemovida;
 }
 
@@ -317,14 +275,23 @@ void exibirMenu(void) {
 
 // --- Função Principal ---
 
-int main() {
+// TETRIS_SEM_MAIN permite incluir este arquivo em outro programa (ex.: benchmarks).
+#ifndef TETRIS_SEM_MAIN
+
+int main(int argc, char *argv[]) {
     FilaPecas filaPrincipal;
     PilhaPecas pilhaReserva;
     int opcao = -1;
 
     // 1. Inicializa a Fila e a Pilha
     inicializarPilha(&pilhaReserva);
-    inicializarFila(&filaPrincipal);
+    // Sem --semente, a semente vem do relógio (e é exibida para reproduzir a partida)
+    uint64_t semente = (uint64_t)time(NULL);
+    if (argc != 1 && !(argc == 3 && strcmp(argv[1], "--semente") == 0 && geradorLerSemente(argv[2], &semente))) {
+        fprintf(stderr, "Uso: %s [--semente N]\n", argv[0]);
+        return 1;
+    }
+    inicializarFila(&filaPrincipal, semente);
     
     do {
         // 2. Exibe o estado atual (Fila e Pilha)
@@ -364,4 +331,6 @@ int main() {
     } while (opcao != 0);
 
     return 0;
-}
\ No newline at end of file
+}
+
+#endif // TETRIS_SEM_MAIN
@@ -0,0 +1,79 @@
+#ifndef ANEL_CIRCULAR_H
+#define ANEL_CIRCULAR_H
+
+// Buffer circular (anel) especializado pela capacidade em tempo de compilação.
+//
+// Os índices avançam sem o operador '%':
+//   - capacidade potência de dois: máscara (i + 1) & (CAP - 1);
+//   - demais capacidades: comparação com a capacidade (i + 1 == CAP ? 0 : i + 1).
+// Como CAP é uma constante, o compilador elimina o ramo não usado.
+
+#include <stdbool.h>
+
+// --- Aritmética de Índices ---
+
+#define ANEL_POTENCIA_DE_DOIS(cap) ((cap) > 0 && ((cap) & ((cap) - 1)) == 0)
+
+// Próximo índice circular após i (0 <= i < cap)
+#define ANEL_AVANCAR(i, cap)                                                  \
+    (ANEL_POTENCIA_DE_DOIS(cap) ? (((i) + 1) & ((cap) - 1))                   \
+                                : ((i) + 1 == (cap) ? 0 : (i) + 1))
+
+// Índice circular base + desloc (0 <= base < cap, 0 <= desloc <= cap)
+#define ANEL_INDICE(base, desloc, cap)                                        \
+    (ANEL_POTENCIA_DE_DOIS(cap) ? (((base) + (desloc)) & ((cap) - 1))         \
+                                : ((base) + (desloc) >= (cap) ? (base) + (desloc) - (cap) \
+                                                              : (base) + (desloc)))
+
+// Versões para capacidade conhecida só em tempo de execução: sempre por
+// comparação, que custa menos que a divisão inteira exigida por '%'.
+#define ANEL_AVANCAR_DINAMICO(i, cap) ((i) + 1 == (cap) ? 0 : (i) + 1)
+#define ANEL_INDICE_DINAMICO(base, desloc, cap)                               \
+    ((base) + (desloc) >= (cap) ? (base) + (desloc) - (cap) : (base) + (desloc))
+
+// --- Anel Tipado ---
+
+/**
+ * @brief Define um anel de elementos TIPO com capacidade fixa CAP.
+ * * Gera a struct NOME e as funções static inline NOME_inicializar,
+ * NOME_cheio, NOME_vazio, NOME_inserir, NOME_remover e NOME_frente.
+ * NOME_inserir e NOME_remover retornam false se o anel estiver cheio/vazio.
+ */
+#define ANEL_DEFINIR(NOME, TIPO, CAP)                                         \
+    typedef struct {                                                          \
+        TIPO itens[CAP];                                                      \
+        int frente;   /* Índice da frente (remoção) */                        \
+        int tras;     /* Índice do final (inserção) */                        \
+        int contador; /* Número atual de elementos */                         \
+    } NOME;                                                                   \
+                                                                              \
+    static inline void NOME##_inicializar(NOME *anel) {                       \
+        anel->frente = 0;                                                     \
+        anel->tras = (CAP) - 1;                                               \
+        anel->contador = 0;                                                   \
+    }                                                                         \
+                                                                              \
+    static inline bool NOME##_cheio(const NOME *anel) { return anel->contador == (CAP); } \
+    static inline bool NOME##_vazio(const NOME *anel) { return anel->contador == 0; } \
+                                                                              \
+    static inline bool NOME##_inserir(NOME *anel, TIPO item) {                \
+        if (NOME##_cheio(anel)) return false;                                 \
+        anel->tras = ANEL_AVANCAR(anel->tras, (CAP));                         \
+        anel->itens[anel->tras] = item;                                       \
+        anel->contador++;                                                     \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    static inline bool NOME##_remover(NOME *anel, TIPO *item) {               \
+        if (NOME##_vazio(anel)) return false;                                 \
+        *item = anel->itens[anel->frente];                                    \
+        anel->frente = ANEL_AVANCAR(anel->frente, (CAP));                     \
+        anel->contador--;                                                     \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    static inline TIPO *NOME##_frente(NOME *anel) {                           \
+        return NOME##_vazio(anel) ? (TIPO *)0 : &anel->itens[anel->frente];   \
+    }
+
+#endif // ANEL_CIRCULAR_H
@@ -0,0 +1,133 @@
+#ifndef GERADOR_PECAS_H
+#define GERADOR_PECAS_H
+
+// Gerador pseudoaleatório de tipos de peça, reprodutível e com estado próprio.
+//
+// Núcleo: xoshiro256** (Blackman & Vigna), semeado por SplitMix64 a partir de
+// uma semente de 64 bits. Cada saída de 64 bits rende 32 tipos de peça de
+// 2 bits; como há exatamente 4 tipos, o sorteio não tem viés de módulo.
+// O estado fica dentro de cada sessão (sem variáveis globais), então
+// sessões diferentes podem gerar peças em threads diferentes.
+//
+// Sortear os tipos um a um ou em lote consome os bits na mesma ordem:
+// a sequência de peças depende apenas da semente.
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// --- Constantes ---
+#define GERADOR_BITS_TIPO 2                       // Bits por tipo de peça
+#define GERADOR_NUM_TIPOS (1 << GERADOR_BITS_TIPO) // 'I', 'O', 'T', 'L'
+#define GERADOR_TIPOS_POR_SAIDA (64 / GERADOR_BITS_TIPO)
+
+// --- Estrutura de Dados ---
+
+typedef struct {
+    uint64_t estado[4];  // Estado do xoshiro256**
+    uint64_t reserva;    // Bits já sorteados e ainda não consumidos
+    int tiposRestantes;  // Tipos de peça ainda disponíveis em 'reserva'
+    uint64_t semente;    // Semente original (para reproduzir a sessão)
+} GeradorPecas;
+
+// --- Implementação ---
+
+static inline uint64_t geradorRotacionar(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Passo do SplitMix64, usado apenas para expandir a semente.
+ */
+static inline uint64_t geradorSplitMix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief (Re)inicia o gerador a partir de uma semente de 64 bits.
+ */
+static inline void geradorSemear(GeradorPecas *gerador, uint64_t semente) {
+    gerador->semente = semente;
+    for (int i = 0; i < 4; i++) {
+        gerador->estado[i] = geradorSplitMix64(&semente);
+    }
+    gerador->reserva = 0;
+    gerador->tiposRestantes = 0;
+}
+
+/**
+ * @brief Próxima saída de 64 bits do xoshiro256**.
+ */
+static inline uint64_t geradorProximo64(GeradorPecas *gerador) {
+    uint64_t *s = gerador->estado;
+    uint64_t resultado = geradorRotacionar(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = geradorRotacionar(s[3], 45);
+
+    return resultado;
+}
+
+/**
+ * @brief Sorteia um tipo de peça (0 a GERADOR_NUM_TIPOS - 1).
+ */
+static inline int geradorSortearTipo(GeradorPecas *gerador) {
+    if (gerador->tiposRestantes == 0) {
+        gerador->reserva = geradorProximo64(gerador);
+        gerador->tiposRestantes = GERADOR_TIPOS_POR_SAIDA;
+    }
+    int tipo = (int)(gerador->reserva & (GERADOR_NUM_TIPOS - 1));
+    gerador->reserva >>= GERADOR_BITS_TIPO;
+    gerador->tiposRestantes--;
+    return tipo;
+}
+
+/**
+ * @brief Sorteia n tipos de peça de uma vez.
+ * * Esvazia primeiro a reserva, depois consome saídas inteiras de 64 bits
+ * (32 tipos por saída) e guarda as sobras na reserva.
+ */
+static inline void geradorSortearTipos(GeradorPecas *gerador, uint8_t *tipos, size_t n) {
+    size_t i = 0;
+
+    while (i < n && gerador->tiposRestantes > 0) {
+        tipos[i++] = (uint8_t)geradorSortearTipo(gerador);
+    }
+    while (n - i >= GERADOR_TIPOS_POR_SAIDA) {
+        uint64_t bits = geradorProximo64(gerador);
+        for (int j = 0; j < GERADOR_TIPOS_POR_SAIDA; j++) {
+            tipos[i++] = (uint8_t)(bits & (GERADOR_NUM_TIPOS - 1));
+            bits >>= GERADOR_BITS_TIPO;
+        }
+    }
+    while (i < n) {
+        tipos[i++] = (uint8_t)geradorSortearTipo(gerador);
+    }
+}
+
+/**
+ * @brief Lê uma semente de 64 bits (decimal, ou hexadecimal com 0x) de um argumento.
+ * @return false se o texto não for um inteiro sem sinal que caiba em 64 bits.
+ */
+static inline bool geradorLerSemente(const char *texto, uint64_t *valor) {
+    char *fim;
+    // strtoull aceitaria "-1" (como 2^64 - 1) e espaços iniciais
+    if (*texto < '0' || *texto > '9') return false;
+    errno = 0;
+    unsigned long long v = strtoull(texto, &fim, 0);
+    if (*fim != '\0' || errno == ERANGE) return false;
+    *valor = (uint64_t)v;
+    return true;
+}
+
+#endif // GERADOR_PECAS_H
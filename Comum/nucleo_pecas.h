@@ -0,0 +1,286 @@
+#ifndef NUCLEO_PECAS_H
+#define NUCLEO_PECAS_H
+
+// Núcleo compartilhado pelos três níveis (Novato, Aventureiro e Mestre):
+// a peça, a fila circular de peças futuras, a pilha de reserva e as
+// primitivas sobre elas, todas static inline e sem mensagens. Cada nível
+// mantém as próprias funções públicas (enqueue, dequeue, push, ...) com as
+// mensagens que já exibia, e elas só delegam para cá.
+//
+// Chaves de compilação, definidas antes de incluir este arquivo:
+//   NUCLEO_CAPACIDADE_FILA N   fila com vetor fixo de N peças (sem: vetor
+//                              alocado, com o campo 'capacidade');
+//   NUCLEO_CAPACIDADE_PILHA N  o mesmo para a pilha;
+//   NUCLEO_COM_RESERVA         define a pilha de reserva e push/pop;
+//   NUCLEO_COM_TROCA           define as trocas entre fila e pilha (exige
+//                              NUCLEO_COM_RESERVA);
+//   NUCLEO_FILA_EXTRA          campos acrescentados ao final da FilaPecas.
+//
+// Com capacidade fixa, o avanço dos índices é especializado pela constante
+// (Comum/anel_circular.h); com capacidade dinâmica, usa comparação.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "anel_circular.h"
+
+#if defined(NUCLEO_COM_TROCA) && !defined(NUCLEO_COM_RESERVA)
+#error "NUCLEO_COM_TROCA exige NUCLEO_COM_RESERVA"
+#endif
+
+// --- Constantes ---
+#define NUCLEO_NUM_TIPOS 4
+
+// Tipos de peça, indexados pelo valor sorteado
+static const char TIPOS_PECA[NUCLEO_NUM_TIPOS] = {'I', 'O', 'T', 'L'};
+
+// --- Estruturas de Dados ---
+
+// Estrutura para representar uma peça
+typedef struct {
+    char nome; // Tipo da peça ('I', 'O', 'T', 'L')
+    int id;    // Identificador único da peça
+} Peca;
+
+// Estrutura para a Fila Circular (FIFO)
+typedef struct {
+#ifdef NUCLEO_CAPACIDADE_FILA
+    Peca itens[NUCLEO_CAPACIDADE_FILA];
+#else
+    Peca *itens;    // Vetor alocado com 'capacidade' posições
+    int capacidade; // Capacidade definida na inicialização
+#endif
+    int frente;   // Índice da frente (remoção)
+    int tras;     // Índice do final (inserção)
+    int contador; // Número atual de elementos
+    int proximo_id; // Contador para gerar IDs únicos
+#ifdef NUCLEO_FILA_EXTRA
+    NUCLEO_FILA_EXTRA
+#endif
+} FilaPecas;
+
+#ifdef NUCLEO_COM_RESERVA
+// Estrutura para a Pilha Linear (LIFO)
+typedef struct {
+#ifdef NUCLEO_CAPACIDADE_PILHA
+    Peca itens[NUCLEO_CAPACIDADE_PILHA];
+#else
+    Peca *itens;    // Vetor alocado com 'capacidade' posições
+    int capacidade; // Capacidade definida na inicialização
+#endif
+    int topo;     // Índice do topo (-1 para pilha vazia)
+} PilhaPecas;
+#endif
+
+// --- Capacidades e Índices ---
+
+#ifdef NUCLEO_CAPACIDADE_FILA
+#define NUCLEO_CAP_FILA(fila) (NUCLEO_CAPACIDADE_FILA)
+#define NUCLEO_AVANCAR_FILA(i, fila) ANEL_AVANCAR((i), NUCLEO_CAPACIDADE_FILA)
+#define NUCLEO_INDICE_FILA(base, desloc, fila) ANEL_INDICE((base), (desloc), NUCLEO_CAPACIDADE_FILA)
+#else
+#define NUCLEO_CAP_FILA(fila) ((fila)->capacidade)
+#define NUCLEO_AVANCAR_FILA(i, fila) ANEL_AVANCAR_DINAMICO((i), (fila)->capacidade)
+#define NUCLEO_INDICE_FILA(base, desloc, fila) ANEL_INDICE_DINAMICO((base), (desloc), (fila)->capacidade)
+#endif
+
+#ifdef NUCLEO_CAPACIDADE_PILHA
+#define NUCLEO_CAP_PILHA(pilha) (NUCLEO_CAPACIDADE_PILHA)
+#else
+#define NUCLEO_CAP_PILHA(pilha) ((pilha)->capacidade)
+#endif
+
+// --- Fila ---
+
+/**
+ * @brief Deixa a fila vazia: a primeira inserção vai para a posição 0.
+ * * Não toca em 'itens' nem em 'capacidade' (a alocação é do nível).
+ */
+static inline void nucleoIniciarFila(FilaPecas *fila) {
+    fila->frente = 0;
+    fila->tras = NUCLEO_CAP_FILA(fila) - 1;
+    fila->contador = 0;
+    fila->proximo_id = 0;
+}
+
+static inline bool nucleoFilaCheia(const FilaPecas *fila) { return fila->contador == NUCLEO_CAP_FILA(fila); }
+static inline bool nucleoFilaVazia(const FilaPecas *fila) { return fila->contador == 0; }
+
+/**
+ * @brief Cria a próxima peça da fila com o tipo sorteado (índice em TIPOS_PECA).
+ */
+static inline Peca nucleoCriarPeca(FilaPecas *fila, int tipo) {
+    Peca peca;
+    peca.nome = TIPOS_PECA[tipo];
+    peca.id = fila->proximo_id++;
+    return peca;
+}
+
+/**
+ * @brief Insere a peça no final da fila.
+ * @return false se a fila estiver cheia (nada muda).
+ */
+static inline bool nucleoEnqueue(FilaPecas *fila, Peca peca) {
+    if (nucleoFilaCheia(fila)) return false;
+    fila->tras = NUCLEO_AVANCAR_FILA(fila->tras, fila);
+    fila->itens[fila->tras] = peca;
+    fila->contador++;
+    return true;
+}
+
+/**
+ * @brief Remove a peça da frente da fila.
+ * @return false se a fila estiver vazia (*peca não é alterada).
+ */
+static inline bool nucleoDequeue(FilaPecas *fila, Peca *peca) {
+    if (nucleoFilaVazia(fila)) return false;
+    *peca = fila->itens[fila->frente];
+    fila->frente = NUCLEO_AVANCAR_FILA(fila->frente, fila);
+    fila->contador--;
+    return true;
+}
+
+// --- Fila em Bloco ---
+// Um bloco de n posições a partir de 'inicio' ocupa no máximo dois trechos
+// contíguos do vetor: [inicio, fim do vetor) e [0, restante). Cada trecho é
+// copiado com um único memcpy, sem calcular o índice circular por peça.
+
+/**
+ * @brief Tamanho do primeiro trecho contíguo de n posições a partir de 'inicio';
+ * as n - trecho restantes começam na posição 0.
+ */
+static inline int nucleoTrechoFila(const FilaPecas *fila, int inicio, int n) {
+    (void)fila; // Sem uso quando a capacidade é fixa
+    int ateOFim = NUCLEO_CAP_FILA(fila) - inicio;
+    return n < ateOFim ? n : ateOFim;
+}
+
+/**
+ * @brief Insere as n peças de 'origem', em ordem, no final da fila.
+ * @return false se n < 0 ou se não houver espaço para as n (nada muda).
+ */
+static inline bool nucleoEnqueueN(FilaPecas *fila, const Peca *origem, int n) {
+    if (n < 0 || n > NUCLEO_CAP_FILA(fila) - fila->contador) return false;
+    if (n == 0) return true;
+    int inicio = NUCLEO_AVANCAR_FILA(fila->tras, fila);
+    int trecho = nucleoTrechoFila(fila, inicio, n);
+    memcpy(&fila->itens[inicio], origem, (size_t)trecho * sizeof(Peca));
+    memcpy(fila->itens, origem + trecho, (size_t)(n - trecho) * sizeof(Peca));
+    fila->tras = NUCLEO_INDICE_FILA(inicio, n - 1, fila);
+    fila->contador += n;
+    return true;
+}
+
+/**
+ * @brief Copia as n primeiras peças da fila (da frente ao final) para 'destino',
+ * sem removê-las.
+ * @return false se n < 0 ou se a fila tiver menos de n peças.
+ */
+static inline bool nucleoEspiarN(const FilaPecas *fila, Peca *destino, int n) {
+    if (n < 0 || n > fila->contador) return false;
+    int trecho = nucleoTrechoFila(fila, fila->frente, n);
+    memcpy(destino, &fila->itens[fila->frente], (size_t)trecho * sizeof(Peca));
+    memcpy(destino + trecho, fila->itens, (size_t)(n - trecho) * sizeof(Peca));
+    return true;
+}
+
+/**
+ * @brief Remove as n primeiras peças da fila, copiando-as em ordem para 'destino'.
+ * @return false se n < 0 ou se a fila tiver menos de n peças (nada muda).
+ */
+static inline bool nucleoDequeueN(FilaPecas *fila, Peca *destino, int n) {
+    if (!nucleoEspiarN(fila, destino, n)) return false;
+    fila->frente = NUCLEO_INDICE_FILA(fila->frente, n, fila);
+    fila->contador -= n;
+    return true;
+}
+
+// --- Pilha ---
+
+#ifdef NUCLEO_COM_RESERVA
+static inline void nucleoIniciarPilha(PilhaPecas *pilha) { pilha->topo = -1; }
+static inline bool nucleoPilhaCheia(const PilhaPecas *pilha) { return pilha->topo == NUCLEO_CAP_PILHA(pilha) - 1; }
+static inline bool nucleoPilhaVazia(const PilhaPecas *pilha) { return pilha->topo == -1; }
+static inline int nucleoTamanhoPilha(const PilhaPecas *pilha) { return pilha->topo + 1; }
+
+/**
+ * @brief Empilha a peça.
+ * @return false se a pilha estiver cheia (nada muda).
+ */
+static inline bool nucleoPush(PilhaPecas *pilha, Peca peca) {
+    if (nucleoPilhaCheia(pilha)) return false;
+    pilha->itens[++pilha->topo] = peca;
+    return true;
+}
+
+/**
+ * @brief Desempilha a peça do topo.
+ * @return false se a pilha estiver vazia (*peca não é alterada).
+ */
+static inline bool nucleoPop(PilhaPecas *pilha, Peca *peca) {
+    if (nucleoPilhaVazia(pilha)) return false;
+    *peca = pilha->itens[pilha->topo--];
+    return true;
+}
+#endif // NUCLEO_COM_RESERVA
+
+// --- Trocas ---
+
+#ifdef NUCLEO_COM_TROCA
+_Static_assert(sizeof(Peca) == sizeof(uint64_t), "Peca ocupa 8 bytes");
+
+/**
+ * @brief Troca duas peças copiando cada uma inteira (8 bytes).
+ * * Copiada campo a campo (1 + 4 bytes), a peça gravada seria lida depois
+ * por inteiro, e essa leitura larga não aproveita as duas escritas
+ * estreitas que ainda estão no store buffer: a troca seguinte espera.
+ */
+static inline void nucleoTrocarPecas(Peca *a, Peca *b) {
+    uint64_t pecaA, pecaB;
+    memcpy(&pecaA, a, sizeof(pecaA));
+    memcpy(&pecaB, b, sizeof(pecaB));
+    memcpy(a, &pecaB, sizeof(pecaB));
+    memcpy(b, &pecaA, sizeof(pecaA));
+}
+
+/**
+ * @brief Troca a peça da frente da fila com a do topo da pilha.
+ * @return false se a fila ou a pilha estiver vazia.
+ */
+static inline bool nucleoTrocarFrenteTopo(FilaPecas *fila, PilhaPecas *pilha) {
+    if (nucleoFilaVazia(fila) || nucleoPilhaVazia(pilha)) return false;
+    nucleoTrocarPecas(&fila->itens[fila->frente], &pilha->itens[pilha->topo]);
+    return true;
+}
+
+/**
+ * @brief Troca as n peças contíguas a partir de 'fila' com as n que descem a
+ * partir de 'pilha' (fila[i] com pilha[-i]).
+ */
+static inline void nucleoTrocarTrecho(Peca *fila, Peca *pilha, int n) {
+    for (int i = 0; i < n; i++) {
+        nucleoTrocarPecas(&fila[i], pilha - i);
+    }
+}
+
+/**
+ * @brief Troca as n primeiras peças da fila com as n do topo da pilha
+ * (i-ésima da frente com a i-ésima a partir do topo).
+ * * A fila é percorrida em até dois trechos contíguos; a pilha, do topo para
+ * baixo, sempre em um só.
+ * @return false se n <= 0 ou se a fila ou a pilha tiver menos de n peças.
+ */
+static inline bool nucleoTrocarBloco(FilaPecas *fila, PilhaPecas *pilha, int n) {
+    if (n <= 0 || fila->contador < n || nucleoTamanhoPilha(pilha) < n) return false;
+    int trecho = nucleoTrechoFila(fila, fila->frente, n);
+    Peca *topo = &pilha->itens[pilha->topo];
+    nucleoTrocarTrecho(&fila->itens[fila->frente], topo, trecho);
+    // Só há segundo trecho se a fila deu a volta (com n = tamanho da pilha,
+    // topo - trecho apontaria para antes do vetor)
+    if (n > trecho) nucleoTrocarTrecho(fila->itens, topo - trecho, n - trecho);
+    return true;
+}
+#endif // NUCLEO_COM_TROCA
+
+#endif // NUCLEO_PECAS_H
@@ -0,0 +1,347 @@
+#define _POSIX_C_SOURCE 200809L // pthreads, clock_gettime
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "analisador_pecas.h"
+
+// Nomes das políticas, na ordem de PoliticaJogo
+static const char *NOMES_POLITICAS[NUM_POLITICAS] = {"aleatoria", "guardar-I", "evitar-repeticao"};
+
+// Trabalho e resultados de uma thread (uma linha de cache própria no início)
+typedef struct {
+    _Alignas(64) pthread_t thread;
+    long long numPecas;
+    long long numPassos;
+    uint64_t semente;
+    int capacidadeFila;
+    int capacidadePilha;
+    bool ok;
+    HistogramasPecas hist;
+} ParteAnalise;
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Semente de cada thread, derivada da semente base e do índice.
+ */
+static uint64_t sementeDaParte(uint64_t sementeBase, int indice) {
+    return sementeBase ^ ((uint64_t)(indice + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * @brief Secas e repetições de numPecas tipos sorteados, na ordem de gerarPeca.
+ * * Os tipos são sorteados em blocos com geradorSortearTipos, que consome os
+ * bits do gerador na mesma ordem que as chamadas a gerarPeca.
+ */
+static void analisarSequencia(GeradorPecas *gerador, long long numPecas, HistogramasPecas *h) {
+    uint8_t bloco[ANALISADOR_BLOCO];
+    long long secas[GERADOR_NUM_TIPOS][ANALISADOR_MAX_SECA + 1] = {{0}};
+    long long sequencias[ANALISADOR_MAX_SEQUENCIA + 1] = {0};
+    long long maiorSeca[GERADOR_NUM_TIPOS] = {0};
+    long long primeira[GERADOR_NUM_TIPOS]; // Posição da primeira peça de cada tipo (-1 = nenhuma)
+    long long ultima[GERADOR_NUM_TIPOS];   // Posição da última peça de cada tipo
+    int anterior = -1;
+    long long sequencia = 0;
+
+    for (int t = 0; t < GERADOR_NUM_TIPOS; t++) primeira[t] = ultima[t] = -1;
+
+    for (long long base = 0; base < numPecas; base += ANALISADOR_BLOCO) {
+        int n = numPecas - base < ANALISADOR_BLOCO ? (int)(numPecas - base) : ANALISADOR_BLOCO;
+        geradorSortearTipos(gerador, bloco, (size_t)n);
+
+        for (int i = 0; i < n; i++) {
+            int tipo = bloco[i];
+            long long posicao = base + i;
+
+            if (ultima[tipo] >= 0) {
+                long long seca = posicao - ultima[tipo] - 1;
+                secas[tipo][seca < ANALISADOR_MAX_SECA ? seca : ANALISADOR_MAX_SECA]++;
+                if (seca > maiorSeca[tipo]) maiorSeca[tipo] = seca;
+            } else {
+                primeira[tipo] = posicao;
+            }
+            ultima[tipo] = posicao;
+
+            // Sem desvio: a peça repete a anterior em 1 de cada 4 vezes, o que
+            // um 'if' erraria com frequência. A sequência que termina vai para
+            // o histograma (o balde 0 recebe só o início e é descartado).
+            bool repete = tipo == anterior;
+            sequencias[sequencia < ANALISADOR_MAX_SEQUENCIA ? sequencia : ANALISADOR_MAX_SEQUENCIA] += !repete;
+            sequencia = repete ? sequencia + 1 : 1;
+            anterior = tipo;
+        }
+    }
+    if (sequencia > 0) sequencias[sequencia < ANALISADOR_MAX_SEQUENCIA ? sequencia : ANALISADOR_MAX_SEQUENCIA]++;
+
+    // Repetições, contagens por tipo e somas das secas saem dos histogramas
+    long long numSequencias = 0;
+    for (int s = 1; s <= ANALISADOR_MAX_SEQUENCIA; s++) {
+        h->sequencias[s] += sequencias[s];
+        numSequencias += sequencias[s];
+    }
+    h->repeticoes += numPecas - numSequencias;
+
+    for (int t = 0; t < GERADOR_NUM_TIPOS; t++) {
+        if (primeira[t] < 0) continue;
+        long long ocorrencias = 1;
+        for (int s = 0; s <= ANALISADOR_MAX_SECA; s++) {
+            h->secas[t][s] += secas[t][s];
+            ocorrencias += secas[t][s];
+        }
+        h->porTipo[t] += ocorrencias;
+        // As secas cobrem o trecho da primeira à última peça do tipo, menos as peças do tipo
+        h->somaSecas[t] += (ultima[t] - primeira[t] + 1) - ocorrencias;
+        if (maiorSeca[t] > h->maiorSeca[t]) h->maiorSeca[t] = maiorSeca[t];
+    }
+    h->pecas += numPecas;
+}
+
+/**
+ * @brief Verdadeiro se há uma peça do tipo na fila.
+ */
+static bool filaTemTipo(const FilaPecas *fila, char tipo) {
+    // Percorre os dois trechos contíguos da fila, sem '%' por posição
+    int trecho = nucleoTrechoFila(fila, fila->frente, fila->contador);
+    for (int i = 0; i < trecho; i++) {
+        if (fila->itens[fila->frente + i].nome == tipo) return true;
+    }
+    for (int i = 0; i < fila->contador - trecho; i++) {
+        if (fila->itens[i].nome == tipo) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Escolhe a próxima ação (1 a 5) da política.
+ * @param ultimaJogada Tipo da última peça jogada ('\0' antes da primeira).
+ */
+static int escolherAcao(PoliticaJogo politica, FilaPecas *fila, PilhaPecas *pilha,
+                        GeradorPecas *sorteio, char ultimaJogada) {
+    char frente = fila->itens[fila->frente].nome;
+    char topo = estaVaziaPilha(pilha) ? '\0' : pilha->itens[pilha->topo].nome;
+
+    switch (politica) {
+        case POLITICA_ALEATORIA:
+            // Sorteio por multiplicação (sem '%'): parte alta de r * 5
+            return 1 + (int)(((geradorProximo64(sorteio) >> 32) * 5ULL) >> 32);
+
+        case POLITICA_GUARDAR_I:
+            if (frente == 'I' && !estaCheiaPilha(pilha)) return 2;
+            if (topo == 'I' && !filaTemTipo(fila, 'I')) return 3;
+            return 1;
+
+        case POLITICA_EVITAR_REPETICAO:
+            if (frente != ultimaJogada) return 1;
+            if (topo != '\0' && topo != ultimaJogada) return 3;
+            if (!estaCheiaPilha(pilha)) return 2;
+            return 1; // Sem alternativa: repete o tipo
+
+        default:
+            return 1;
+    }
+}
+
+/**
+ * @brief Joga numPassos ações de cada política em uma sessão real e conta os
+ * passos em que a Troca Múltipla seria aceita.
+ * * Todas as políticas partem da mesma semente (mesma sequência de peças).
+ * @return false se faltar memória para a sessão.
+ */
+static bool analisarPoliticas(const ParteAnalise *parte, HistogramasPecas *h) {
+    for (int p = 0; p < NUM_POLITICAS; p++) {
+        FilaPecas fila;
+        PilhaPecas pilha;
+        GeradorPecas sorteio;
+        char ultimaJogada = '\0';
+
+        if (!inicializarPilha(&pilha, parte->capacidadePilha)) return false;
+        if (!inicializarFila(&fila, parte->capacidadeFila, parte->semente)) {
+            liberarPilha(&pilha);
+            return false;
+        }
+        geradorSemear(&sorteio, parte->semente ^ 0xC0FFEEULL);
+
+        for (long long passo = 0; passo < parte->numPassos; passo++) {
+            // Mesma condição de trocarPecaMultipla
+            if (fila.contador >= tamanhoTroca && getTamanhoPilha(&pilha) >= tamanhoTroca) h->trocaAceita[p]++;
+
+            int opcao = escolherAcao((PoliticaJogo)p, &fila, &pilha, &sorteio, ultimaJogada);
+            char jogada = opcao == 1 ? fila.itens[fila.frente].nome
+                        : opcao == 3 && !estaVaziaPilha(&pilha) ? pilha.itens[pilha.topo].nome : '\0';
+
+            if (executarAcao(&fila, &pilha, opcao)) {
+                if (jogada != '\0') ultimaJogada = jogada;
+            } else {
+                h->acoesRecusadas[p]++;
+            }
+        }
+        h->passos[p] += parte->numPassos;
+
+        liberarFila(&fila);
+        liberarPilha(&pilha);
+    }
+    return true;
+}
+
+/**
+ * @brief Corpo de cada thread: só escreve nos próprios histogramas.
+ */
+static void *trabalhadorAnalise(void *arg) {
+    ParteAnalise *parte = arg;
+    GeradorPecas gerador;
+
+    geradorSemear(&gerador, parte->semente);
+    analisarSequencia(&gerador, parte->numPecas, &parte->hist);
+    parte->ok = analisarPoliticas(parte, &parte->hist);
+    return NULL;
+}
+
+/**
+ * @brief Soma os histogramas de uma thread no resultado final.
+ */
+static void somarHistogramas(HistogramasPecas *destino, const HistogramasPecas *origem) {
+    destino->pecas += origem->pecas;
+    for (int t = 0; t < GERADOR_NUM_TIPOS; t++) {
+        destino->porTipo[t] += origem->porTipo[t];
+        for (int s = 0; s <= ANALISADOR_MAX_SECA; s++) destino->secas[t][s] += origem->secas[t][s];
+        destino->somaSecas[t] += origem->somaSecas[t];
+        if (origem->maiorSeca[t] > destino->maiorSeca[t]) destino->maiorSeca[t] = origem->maiorSeca[t];
+    }
+    destino->repeticoes += origem->repeticoes;
+    for (int s = 0; s <= ANALISADOR_MAX_SEQUENCIA; s++) destino->sequencias[s] += origem->sequencias[s];
+    for (int p = 0; p < NUM_POLITICAS; p++) {
+        destino->passos[p] += origem->passos[p];
+        destino->trocaAceita[p] += origem->trocaAceita[p];
+        destino->acoesRecusadas[p] += origem->acoesRecusadas[p];
+    }
+}
+
+/**
+ * @brief Menor seca s tal que a fração q das secas do tipo é <= s.
+ * @return ANALISADOR_MAX_SECA se o percentil cair no último balde.
+ */
+static int percentilSeca(const HistogramasPecas *h, int tipo, double q) {
+    long long total = 0, acumulado = 0;
+    for (int s = 0; s <= ANALISADOR_MAX_SECA; s++) total += h->secas[tipo][s];
+    if (total == 0) return 0;
+
+    long long alvo = (long long)(q * (double)total);
+    if (alvo < 1) alvo = 1;
+    for (int s = 0; s <= ANALISADOR_MAX_SECA; s++) {
+        acumulado += h->secas[tipo][s];
+        if (acumulado >= alvo) return s;
+    }
+    return ANALISADOR_MAX_SECA;
+}
+
+// --- Análise ---
+
+/**
+ * @brief Divide numPecas peças e numPassos passos de cada política entre
+ * numThreads threads, cada uma com o próprio gerador, e soma os resultados.
+ * * A thread principal processa a primeira parte; se uma thread não puder
+ * ser criada, a parte dela também é processada pela thread principal.
+ * @return false se os parâmetros forem inválidos ou faltar memória.
+ */
+bool analisarPecas(long long numPecas, long long numPassos, int numThreads, uint64_t semente,
+                   int capacidadeFila, int capacidadePilha, HistogramasPecas *resultado) {
+    memset(resultado, 0, sizeof(*resultado));
+    if (numPecas <= 0 || numPassos < 0 || numThreads <= 0 || capacidadeFila <= 0 || capacidadePilha <= 0) {
+        return false;
+    }
+    if (numThreads > ANALISADOR_MAX_THREADS) numThreads = ANALISADOR_MAX_THREADS;
+
+    ParteAnalise *partes = aligned_alloc(64, (size_t)numThreads * sizeof(ParteAnalise));
+    bool *criada = calloc((size_t)numThreads, sizeof(bool));
+    if (partes == NULL || criada == NULL) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para %d threads de analise.\n", numThreads);
+        free(partes);
+        free(criada);
+        return false;
+    }
+    memset(partes, 0, (size_t)numThreads * sizeof(ParteAnalise));
+
+    for (int i = 0; i < numThreads; i++) {
+        ParteAnalise *parte = &partes[i];
+        // As primeiras partes recebem o resto da divisão
+        parte->numPecas = numPecas / numThreads + (i < numPecas % numThreads);
+        parte->numPassos = numPassos / numThreads + (i < numPassos % numThreads);
+        parte->semente = sementeDaParte(semente, i);
+        parte->capacidadeFila = capacidadeFila;
+        parte->capacidadePilha = capacidadePilha;
+        if (i > 0) criada[i] = pthread_create(&parte->thread, NULL, trabalhadorAnalise, parte) == 0;
+    }
+
+    for (int i = 0; i < numThreads; i++) {
+        if (!criada[i]) trabalhadorAnalise(&partes[i]);
+    }
+
+    bool ok = true;
+    for (int i = 0; i < numThreads; i++) {
+        if (criada[i]) pthread_join(partes[i].thread, NULL);
+        ok = ok && partes[i].ok;
+        somarHistogramas(resultado, &partes[i].hist);
+    }
+    if (!ok) fprintf(stderr, "ERRO: Memoria insuficiente para as sessoes da analise.\n");
+
+    free(partes);
+    free(criada);
+    return ok;
+}
+
+/**
+ * @brief Modo --analisar: executa a análise e exibe o relatório.
+ * @return Código de saída do programa (0 = sucesso).
+ */
+int executarAnalisador(long long numPecas, long long numPassos, int numThreads, uint64_t semente,
+                       int capacidadeFila, int capacidadePilha) {
+    HistogramasPecas *h = malloc(sizeof(HistogramasPecas));
+    if (h == NULL) return 1;
+
+    double inicio = tempoAtual();
+    if (!analisarPecas(numPecas, numPassos, numThreads, semente, capacidadeFila, capacidadePilha, h)) {
+        free(h);
+        return 1;
+    }
+    double decorrido = tempoAtual() - inicio;
+    if (numThreads > ANALISADOR_MAX_THREADS) numThreads = ANALISADOR_MAX_THREADS;
+
+    printf("Analise de pecas: %lld pecas | Threads: %d | Semente: %llu\n",
+           h->pecas, numThreads, (unsigned long long)semente);
+    printf("Tempo: %.3f s | Taxa: %.0f pecas/s\n", decorrido, decorrido > 0 ? (double)h->pecas / decorrido : 0.0);
+
+    printf("\nTipo  Frequencia  Seca media  p50  p90  p99  Maior\n");
+    for (int t = 0; t < GERADOR_NUM_TIPOS; t++) {
+        long long contadas = 0;
+        for (int s = 0; s <= ANALISADOR_MAX_SECA; s++) contadas += h->secas[t][s];
+        printf("  %c   %9.4f%%  %10.3f  %3d  %3d  %3d  %5lld\n", TIPOS_PECA[t],
+               100.0 * (double)h->porTipo[t] / (double)h->pecas,
+               contadas > 0 ? (double)h->somaSecas[t] / (double)contadas : 0.0,
+               percentilSeca(h, t, 0.50), percentilSeca(h, t, 0.90), percentilSeca(h, t, 0.99),
+               h->maiorSeca[t]);
+    }
+
+    printf("\nRepeticoes (peca igual a anterior): %.4f%%\n", 100.0 * (double)h->repeticoes / (double)h->pecas);
+    printf("Sequencias de pecas iguais:");
+    for (int s = 1; s <= ANALISADOR_MAX_SEQUENCIA; s++) {
+        if (h->sequencias[s] == 0) continue;
+        printf(" %d%s:%lld", s, s == ANALISADOR_MAX_SEQUENCIA ? "+" : "", h->sequencias[s]);
+    }
+    printf("\n");
+
+    if (numPassos > 0) {
+        printf("\nTroca Multipla (%d pecas na fila e na pilha), fila %d, pilha %d:\n",
+               tamanhoTroca, capacidadeFila, capacidadePilha);
+        for (int p = 0; p < NUM_POLITICAS; p++) {
+            printf("  %-17s %lld passos | aceita em %.4f%% | acoes recusadas: %.4f%%\n", NOMES_POLITICAS[p],
+                   h->passos[p], 100.0 * (double)h->trocaAceita[p] / (double)h->passos[p],
+                   100.0 * (double)h->acoesRecusadas[p] / (double)h->passos[p]);
+        }
+    }
+
+    free(h);
+    return 0;
+}
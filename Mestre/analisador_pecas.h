@@ -0,0 +1,67 @@
+#ifndef ANALISADOR_PECAS_H
+#define ANALISADOR_PECAS_H
+
+// Analisador Monte Carlo da sequência de peças do simulador Mestre.
+//
+// Mede, sobre a sequência de tipos produzida por gerarPeca (o GeradorPecas
+// da sessão):
+//   - secas: quantas peças passam entre duas peças do mesmo tipo;
+//   - repetições: peças iguais à anterior e o comprimento das sequências;
+//   - com que frequência a Troca Múltipla (ação 5) seria aceita (tamanhoTroca
+//     peças na fila e na pilha) quando uma sessão real é jogada por algumas
+//     políticas simples.
+//
+// As peças são divididas entre as threads; cada uma tem o próprio gerador
+// (semente derivada da semente base e do índice da thread) e os próprios
+// histogramas, somados pela thread principal ao final. Nenhum dado é
+// compartilhado durante a simulação.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tetris_stack_mestre.h"
+
+// --- Constantes ---
+#define ANALISADOR_MAX_SECA 128       // Secas maiores caem no último balde
+#define ANALISADOR_MAX_SEQUENCIA 16   // Sequências maiores caem no último balde
+#define ANALISADOR_BLOCO 4096         // Tipos sorteados de uma vez por thread
+#define ANALISADOR_MAX_THREADS 256
+#define ANALISADOR_PASSOS_PADRAO 10000000 // Passos de cada política por padrão (--passos M)
+
+// Políticas de jogo simuladas
+typedef enum {
+    POLITICA_ALEATORIA,         // Ação de 1 a 5 sorteada
+    POLITICA_GUARDAR_I,         // Reserva as peças I e só as usa quando não há I na fila
+    POLITICA_EVITAR_REPETICAO,  // Não joga duas peças seguidas do mesmo tipo
+    NUM_POLITICAS
+} PoliticaJogo;
+
+// --- Estruturas de Dados ---
+
+typedef struct {
+    long long pecas;
+    long long porTipo[GERADOR_NUM_TIPOS];
+
+    // Secas: peças entre duas do mesmo tipo (a primeira ocorrência não conta)
+    long long secas[GERADOR_NUM_TIPOS][ANALISADOR_MAX_SECA + 1];
+    long long somaSecas[GERADOR_NUM_TIPOS];
+    long long maiorSeca[GERADOR_NUM_TIPOS];
+
+    // Repetições
+    long long repeticoes;                               // Peças iguais à anterior
+    long long sequencias[ANALISADOR_MAX_SEQUENCIA + 1]; // Sequências de peças iguais, por comprimento
+
+    // Políticas
+    long long passos[NUM_POLITICAS];
+    long long trocaAceita[NUM_POLITICAS];   // Passos em que a ação 5 seria aceita
+    long long acoesRecusadas[NUM_POLITICAS];
+} HistogramasPecas;
+
+// --- Protótipos das Funções ---
+
+bool analisarPecas(long long numPecas, long long numPassos, int numThreads, uint64_t semente,
+                   int capacidadeFila, int capacidadePilha, HistogramasPecas *resultado);
+int executarAnalisador(long long numPecas, long long numPassos, int numThreads, uint64_t semente,
+                       int capacidadeFila, int capacidadePilha);
+
+#endif // ANALISADOR_PECAS_H
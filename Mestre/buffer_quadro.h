@@ -0,0 +1,130 @@
+#ifndef BUFFER_QUADRO_H
+#define BUFFER_QUADRO_H
+
+// Buffer de texto reutilizável para montar um quadro inteiro de saída e
+// emiti-lo com uma única chamada write(). A memória cresce sob demanda e é
+// reaproveitada entre quadros (bufferLimpar não libera nada).
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+// --- Constantes ---
+#define BUFFER_QUADRO_INICIAL 1024 // Capacidade inicial, em bytes
+
+// --- Estrutura de Dados ---
+
+typedef struct {
+    char *dados;       // Conteúdo (não terminado em '\0')
+    size_t tamanho;    // Bytes em uso
+    size_t capacidade; // Bytes alocados
+} BufferQuadro;
+
+// Pares de dígitos "00".."99" para a conversão rápida de inteiros
+static const char BUFFER_PARES_DIGITOS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// --- Implementação ---
+
+static inline void bufferLimpar(BufferQuadro *buffer) {
+    buffer->tamanho = 0;
+}
+
+static inline void bufferLiberar(BufferQuadro *buffer) {
+    free(buffer->dados);
+    buffer->dados = NULL;
+    buffer->tamanho = buffer->capacidade = 0;
+}
+
+/**
+ * @brief Garante espaço para mais 'extra' bytes, dobrando a capacidade se preciso.
+ * * Encerra o programa se a memória acabar (a saída não tem como prosseguir).
+ */
+static inline void bufferGarantir(BufferQuadro *buffer, size_t extra) {
+    if (buffer->tamanho + extra <= buffer->capacidade) return;
+
+    size_t nova = buffer->capacidade ? buffer->capacidade : BUFFER_QUADRO_INICIAL;
+    while (nova < buffer->tamanho + extra) nova *= 2;
+
+    char *dados = realloc(buffer->dados, nova);
+    if (dados == NULL) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para o buffer de saida.\n");
+        exit(1);
+    }
+    buffer->dados = dados;
+    buffer->capacidade = nova;
+}
+
+static inline void bufferAcrescentar(BufferQuadro *buffer, const char *texto, size_t n) {
+    bufferGarantir(buffer, n);
+    memcpy(buffer->dados + buffer->tamanho, texto, n);
+    buffer->tamanho += n;
+}
+
+static inline void bufferAcrescentarTexto(BufferQuadro *buffer, const char *texto) {
+    bufferAcrescentar(buffer, texto, strlen(texto));
+}
+
+static inline void bufferAcrescentarChar(BufferQuadro *buffer, char c) {
+    bufferGarantir(buffer, 1);
+    buffer->dados[buffer->tamanho++] = c;
+}
+
+/**
+ * @brief Acrescenta um inteiro em decimal, dois dígitos por vez (sem printf).
+ */
+static inline void bufferAcrescentarInt(BufferQuadro *buffer, long long valor) {
+    char temp[24];
+    char *fim = temp + sizeof(temp);
+    char *p = fim;
+    unsigned long long v = valor < 0 ? 0ULL - (unsigned long long)valor : (unsigned long long)valor;
+
+    while (v >= 100) {
+        unsigned idx = (unsigned)(v % 100) * 2;
+        v /= 100;
+        *--p = BUFFER_PARES_DIGITOS[idx + 1];
+        *--p = BUFFER_PARES_DIGITOS[idx];
+    }
+    if (v >= 10) {
+        *--p = BUFFER_PARES_DIGITOS[v * 2 + 1];
+        *--p = BUFFER_PARES_DIGITOS[v * 2];
+    } else {
+        *--p = (char)('0' + v);
+    }
+    if (valor < 0) *--p = '-';
+
+    bufferAcrescentar(buffer, p, (size_t)(fim - p));
+}
+
+static inline bool bufferIguais(const BufferQuadro *a, const BufferQuadro *b) {
+    return a->tamanho == b->tamanho && (a->tamanho == 0 || memcmp(a->dados, b->dados, a->tamanho) == 0);
+}
+
+/**
+ * @brief Emite o conteúdo do buffer em um descritor com uma única write()
+ * (repetida apenas em caso de escrita parcial ou interrupção).
+ * * O stdio é esvaziado antes, para não inverter a ordem das mensagens.
+ * @return false se a escrita falhar.
+ */
+static inline bool bufferEmitir(const BufferQuadro *buffer, int descritor) {
+    size_t enviados = 0;
+
+    fflush(stdout);
+    while (enviados < buffer->tamanho) {
+        ssize_t n = write(descritor, buffer->dados + enviados, buffer->tamanho - enviados);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        enviados += (size_t)n;
+    }
+    return true;
+}
+
+#endif // BUFFER_QUADRO_H
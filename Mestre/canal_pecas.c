@@ -0,0 +1,102 @@
+#define _POSIX_C_SOURCE 200809L // pthreads, nanosleep
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "canal_pecas.h"
+
+// --- Constantes ---
+#define CANAL_LOTE_PRODUTOR 256      // Peças geradas por publicação
+#define CANAL_CEDENCIAS_ANTES_DE_DORMIR 256
+#define CANAL_SONO_PRODUTOR_NS 50000 // Pausa do produtor com o canal cheio há muito tempo
+
+/**
+ * @brief Laço da thread produtora: gera peças em lote nas posições livres
+ * e as publica com uma única escrita de 'tras' por lote.
+ */
+static void *produtorPecas(void *arg) {
+    CanalPecas *canal = arg;
+    unsigned tentativas = 0;
+
+    while (!atomic_load_explicit(&canal->encerrar, memory_order_relaxed)) {
+        uint64_t t = atomic_load_explicit(&canal->tras, memory_order_relaxed);
+        uint64_t livres = canal->capacidade - (t - canal->frenteVista);
+
+        if (livres == 0) {
+            canal->frenteVista = atomic_load_explicit(&canal->frente, memory_order_acquire);
+            livres = canal->capacidade - (t - canal->frenteVista);
+        }
+        if (livres == 0) {
+            // Canal cheio: o consumidor está folgado, então a espera pode crescer
+            canal->esperasProdutor++;
+            if (tentativas < CANAL_GIROS_ANTES_DE_CEDER + CANAL_CEDENCIAS_ANTES_DE_DORMIR) {
+                canalPausar(&tentativas);
+            } else {
+                struct timespec sono = {0, CANAL_SONO_PRODUTOR_NS};
+                nanosleep(&sono, NULL);
+            }
+            continue;
+        }
+        tentativas = 0;
+
+        // Trecho contíguo a partir de t, sem passar do fim do vetor
+        uint64_t inicio = t & canal->mascara;
+        uint64_t n = livres;
+        if (n > canal->capacidade - inicio) n = canal->capacidade - inicio;
+        if (n > CANAL_LOTE_PRODUTOR) n = CANAL_LOTE_PRODUTOR;
+
+        gerarPecas(&canal->origem, canal->itens + inicio, (int)n);
+        atomic_store_explicit(&canal->tras, t + n, memory_order_release);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Cria o canal, liga-o à fila e inicia a thread produtora.
+ * * A capacidade é arredondada para a próxima potência de dois.
+ * @return false se faltar memória ou a thread não puder ser criada.
+ */
+bool canalIniciar(CanalPecas *canal, FilaPecas *fila, uint64_t capacidade) {
+    uint64_t cap = 1;
+    while (cap < capacidade) cap <<= 1;
+
+    memset(canal, 0, sizeof(*canal));
+    canal->itens = malloc(cap * sizeof(Peca));
+    if (canal->itens == NULL) {
+        fprintf(stderr, "ERRO: Nao foi possivel alocar o canal de pecas (%llu posicoes).\n",
+                (unsigned long long)cap);
+        return false;
+    }
+    canal->capacidade = cap;
+    canal->mascara = cap - 1;
+
+    // O produtor continua a sequência de peças da fila
+    canal->origem.gerador = fila->gerador;
+    canal->origem.proximo_id = fila->proximo_id;
+    canal->origem.canal = NULL;
+    canal->origem.tabuleiro = NULL;
+
+    if (pthread_create(&canal->produtor, NULL, produtorPecas, canal) != 0) {
+        fprintf(stderr, "ERRO: Nao foi possivel iniciar a thread produtora de pecas.\n");
+        free(canal->itens);
+        canal->itens = NULL;
+        return false;
+    }
+    fila->canal = canal;
+    return true;
+}
+
+/**
+ * @brief Encerra a thread produtora e desliga o canal da fila.
+ * * As peças já geradas e não consumidas são descartadas; o gerador da
+ * fila não acompanha o do produtor enquanto o canal está ligado.
+ */
+void canalEncerrar(CanalPecas *canal, FilaPecas *fila) {
+    atomic_store_explicit(&canal->encerrar, true, memory_order_relaxed);
+    pthread_join(canal->produtor, NULL);
+    free(canal->itens);
+    canal->itens = NULL;
+    if (fila->canal == canal) fila->canal = NULL;
+}
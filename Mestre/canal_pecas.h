@@ -0,0 +1,100 @@
+#ifndef CANAL_PECAS_H
+#define CANAL_PECAS_H
+
+// Canal de peças pré-geradas entre uma thread produtora e o laço do jogo.
+//
+// É um anel circular de Peca (como a FilaPecas), com um único produtor e um
+// único consumidor e sem travas: o produtor só escreve 'tras', o consumidor
+// só escreve 'frente', e cada índice fica na sua própria linha de cache.
+// Os índices crescem sem parar e a posição no anel é índice & mascara
+// (a capacidade é arredondada para potência de dois).
+//
+// Com um canal ligado à fila (fila->canal), gerarPeca apenas consome a
+// próxima peça do canal; a geração sai do caminho crítico das ações.
+// O produtor herda o gerador e o proximo_id da fila, então a sequência de
+// peças é a mesma de uma sessão sem canal com a mesma semente.
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "tetris_stack_mestre.h"
+
+// --- Constantes ---
+#define CANAL_LINHA_CACHE 64       // Tamanho da linha de cache, em bytes
+#define CANAL_CAPACIDADE_PADRAO 4096
+#define CANAL_GIROS_ANTES_DE_CEDER 64 // Esperas ativas antes de ceder a CPU
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CANAL_PAUSA_CPU() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define CANAL_PAUSA_CPU() __asm__ __volatile__("yield")
+#else
+#define CANAL_PAUSA_CPU() ((void)0)
+#endif
+
+// --- Estrutura de Dados ---
+
+typedef struct CanalPecas {
+    // Linha do consumidor
+    _Alignas(CANAL_LINHA_CACHE) _Atomic uint64_t frente; // Próxima posição a consumir
+    uint64_t trasVisto;          // Último 'tras' lido pelo consumidor
+    uint64_t esperasConsumidor;  // Vezes em que o consumidor achou o canal vazio
+
+    // Linha do produtor
+    _Alignas(CANAL_LINHA_CACHE) _Atomic uint64_t tras;   // Próxima posição a produzir
+    uint64_t frenteVista;        // Último 'frente' lido pelo produtor
+    uint64_t esperasProdutor;    // Vezes em que o produtor achou o canal cheio
+
+    // Campos fixos após canalIniciar
+    _Alignas(CANAL_LINHA_CACHE) Peca *itens;
+    uint64_t capacidade;
+    uint64_t mascara;
+    _Atomic bool encerrar;
+    FilaPecas origem;            // Gerador e proximo_id usados pelo produtor
+    pthread_t produtor;
+} CanalPecas;
+
+// --- Protótipos das Funções ---
+
+bool canalIniciar(CanalPecas *canal, FilaPecas *fila, uint64_t capacidade);
+void canalEncerrar(CanalPecas *canal, FilaPecas *fila);
+
+// --- Implementação (caminho crítico) ---
+
+/**
+ * @brief Espera curta: pausa da CPU nas primeiras tentativas, depois cede a CPU.
+ */
+static inline void canalPausar(unsigned *tentativas) {
+    if (++*tentativas < CANAL_GIROS_ANTES_DE_CEDER) {
+        CANAL_PAUSA_CPU();
+    } else {
+        sched_yield();
+    }
+}
+
+/**
+ * @brief Consome a próxima peça do canal (lado do consumidor).
+ * * Só espera se o produtor estiver atrasado; nesse caso gira e cede a CPU.
+ */
+static inline Peca canalReceber(CanalPecas *canal) {
+    uint64_t f = atomic_load_explicit(&canal->frente, memory_order_relaxed);
+
+    if (f == canal->trasVisto) {
+        unsigned tentativas = 0;
+        canal->trasVisto = atomic_load_explicit(&canal->tras, memory_order_acquire);
+        while (f == canal->trasVisto) {
+            canal->esperasConsumidor++;
+            canalPausar(&tentativas);
+            canal->trasVisto = atomic_load_explicit(&canal->tras, memory_order_acquire);
+        }
+    }
+
+    Peca peca = canal->itens[f & canal->mascara];
+    atomic_store_explicit(&canal->frente, f + 1, memory_order_release);
+    return peca;
+}
+
+#endif // CANAL_PECAS_H
@@ -0,0 +1,310 @@
+#define _POSIX_C_SOURCE 200809L // mmap, posix_madvise
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "diario_acoes.h"
+#include "../Comum/anel_circular.h"
+#include "historico_acoes.h"
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Peça de reposição produzida pela ação, em forma compacta.
+ * * Só as ações 1 e 2 geram peças; a nova peça é sempre o final da fila.
+ */
+static PecaCompacta pecaDeReposicao(int opcao, bool executada, const FilaPecas *fila) {
+    if (!executada || (opcao != 1 && opcao != 2)) return PECA_COMPACTA_VAZIA;
+    return compactarPeca(fila->itens[fila->tras]);
+}
+
+static inline uint64_t misturarHash(uint64_t hash, uint64_t valor) {
+    return (hash ^ valor) * 0x100000001B3ULL; // Primo do FNV-1a de 64 bits
+}
+
+/**
+ * @brief Grava todo o conteúdo de um vetor, repetindo em escritas parciais.
+ */
+static bool gravarTudo(int fd, const void *dados, size_t tamanho) {
+    const char *p = dados;
+    while (tamanho > 0) {
+        ssize_t n = write(fd, p, tamanho);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        tamanho -= (size_t)n;
+    }
+    return true;
+}
+
+static void acrescentarRegistro(DiarioAcoes *diario, RegistroDiario registro) {
+    diario->lote[diario->numLote++] = registro;
+    if (diario->numLote == DIARIO_REGISTROS_POR_LOTE) diarioDescarregar(diario);
+}
+
+// --- Gravação ---
+
+/**
+ * @brief Hash do estado lógico da sessão (conteúdo da fila a partir da frente,
+ * conteúdo da pilha, topo e próximo id).
+ * * Não depende de onde as peças estão no vetor circular nem do canal de peças.
+ */
+uint64_t diarioHashEstado(const FilaPecas *fila, const PilhaPecas *pilha) {
+    uint64_t hash = 0xCBF29CE484222325ULL; // Base do FNV-1a de 64 bits
+
+    hash = misturarHash(hash, (uint64_t)(uint32_t)fila->contador);
+    hash = misturarHash(hash, (uint64_t)(uint32_t)fila->proximo_id);
+    for (int i = 0, idx = fila->frente; i < fila->contador; i++) {
+        hash = misturarHash(hash, compactarPeca(fila->itens[idx]));
+        idx = ANEL_AVANCAR_DINAMICO(idx, fila->capacidade);
+    }
+    hash = misturarHash(hash, (uint64_t)(uint32_t)pilha->topo);
+    for (int i = 0; i <= pilha->topo; i++) {
+        hash = misturarHash(hash, compactarPeca(pilha->itens[i]));
+    }
+    return hash;
+}
+
+/**
+ * @brief Cria (ou trunca) o diário e grava o cabeçalho da sessão.
+ * * Deve ser chamado logo após a inicialização da fila e da pilha, antes da primeira ação.
+ * @param capacidadeHistorico Capacidade do histórico de desfazer/refazer da sessão (0 = sem histórico).
+ * @return false se o arquivo não puder ser criado ou faltar memória.
+ */
+bool diarioAbrir(DiarioAcoes *diario, const char *caminho, const FilaPecas *fila,
+                 const PilhaPecas *pilha, int capacidadeHistorico) {
+    memset(diario, 0, sizeof(*diario));
+    diario->fd = -1;
+    diario->intervaloVerificacao = DIARIO_INTERVALO_PADRAO;
+
+    diario->lote = malloc(DIARIO_REGISTROS_POR_LOTE * sizeof(RegistroDiario));
+    if (diario->lote == NULL) {
+        fprintf(stderr, "ERRO: Nao foi possivel alocar o buffer do diario.\n");
+        return false;
+    }
+
+    diario->fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (diario->fd < 0) {
+        fprintf(stderr, "ERRO: Nao foi possivel criar o diario '%s'.\n", caminho);
+        free(diario->lote);
+        diario->lote = NULL;
+        return false;
+    }
+
+    CabecalhoDiario cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, DIARIO_MAGICA, sizeof(cabecalho.magica));
+    cabecalho.versao = DIARIO_VERSAO;
+    cabecalho.tamanhoRegistro = sizeof(RegistroDiario);
+    cabecalho.semente = fila->gerador.semente;
+    cabecalho.capacidadeFila = fila->capacidade;
+    cabecalho.capacidadePilha = pilha->capacidade;
+    cabecalho.tamanhoTroca = tamanhoTroca;
+    cabecalho.intervaloVerificacao = diario->intervaloVerificacao;
+    cabecalho.capacidadeHistorico = capacidadeHistorico;
+
+    if (!gravarTudo(diario->fd, &cabecalho, sizeof(cabecalho))) {
+        fprintf(stderr, "ERRO: Falha ao gravar o cabecalho do diario '%s'.\n", caminho);
+        diario->erro = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Acrescenta o registro de uma ação já executada (ou recusada).
+ * * A cada intervaloVerificacao ações acrescenta também um ponto de verificação.
+ */
+void diarioRegistrar(DiarioAcoes *diario, int opcao, bool executada,
+                     const FilaPecas *fila, const PilhaPecas *pilha) {
+    RegistroDiario registro = {(uint8_t)opcao, executada, 0, pecaDeReposicao(opcao, executada, fila)};
+    acrescentarRegistro(diario, registro);
+    diario->acoes++;
+
+    if (++diario->desdeVerificacao == diario->intervaloVerificacao) {
+        RegistroDiario marca = {DIARIO_VERIFICACAO, 0, 0, PECA_COMPACTA_VAZIA};
+        RegistroDiario hash;
+        uint64_t valor = diarioHashEstado(fila, pilha);
+        memcpy(&hash, &valor, sizeof(hash));
+        acrescentarRegistro(diario, marca);
+        acrescentarRegistro(diario, hash);
+        diario->desdeVerificacao = 0;
+    }
+}
+
+/**
+ * @brief Grava os registros acumulados em uma única escrita.
+ * @return false se houve falha de gravação (agora ou antes).
+ */
+bool diarioDescarregar(DiarioAcoes *diario) {
+    if (diario->numLote > 0 && diario->fd >= 0 && !diario->erro) {
+        if (!gravarTudo(diario->fd, diario->lote, diario->numLote * sizeof(RegistroDiario))) {
+            fprintf(stderr, "ERRO: Falha ao gravar o diario de acoes.\n");
+            diario->erro = true;
+        }
+    }
+    diario->numLote = 0;
+    return !diario->erro;
+}
+
+/**
+ * @brief Grava o que falta e fecha o diário.
+ * @return false se alguma gravação falhou.
+ */
+bool diarioFechar(DiarioAcoes *diario) {
+    bool ok = diarioDescarregar(diario);
+    if (diario->fd >= 0 && close(diario->fd) != 0) ok = false;
+    diario->fd = -1;
+    free(diario->lote);
+    diario->lote = NULL;
+    return ok;
+}
+
+// --- Leitura e Reprodução ---
+
+/**
+ * @brief Mapeia o diário para leitura e valida o cabeçalho.
+ * @return false se o arquivo não existir, não for um diário ou tiver outra versão.
+ */
+bool diarioMapear(DiarioMapeado *mapeado, const char *caminho) {
+    memset(mapeado, 0, sizeof(*mapeado));
+
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "ERRO: Nao foi possivel abrir o diario '%s'.\n", caminho);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(CabecalhoDiario)) {
+        fprintf(stderr, "ERRO: '%s' nao e um diario de acoes valido.\n", caminho);
+        close(fd);
+        return false;
+    }
+
+    size_t tamanho = (size_t)info.st_size;
+    void *mapa = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        fprintf(stderr, "ERRO: Nao foi possivel mapear o diario '%s'.\n", caminho);
+        return false;
+    }
+    posix_madvise(mapa, tamanho, POSIX_MADV_SEQUENTIAL);
+
+    const CabecalhoDiario *cabecalho = mapa;
+    if (memcmp(cabecalho->magica, DIARIO_MAGICA, sizeof(cabecalho->magica)) != 0 ||
+        cabecalho->versao != DIARIO_VERSAO || cabecalho->tamanhoRegistro != sizeof(RegistroDiario) ||
+        cabecalho->capacidadeFila <= 0 || cabecalho->capacidadePilha <= 0 || cabecalho->tamanhoTroca <= 0 ||
+        cabecalho->capacidadeHistorico < 0) {
+        fprintf(stderr, "ERRO: '%s' nao e um diario de acoes valido (versao %d esperada).\n",
+                caminho, DIARIO_VERSAO);
+        munmap(mapa, tamanho);
+        return false;
+    }
+
+    mapeado->mapa = mapa;
+    mapeado->tamanho = tamanho;
+    mapeado->cabecalho = cabecalho;
+    mapeado->registros = (const RegistroDiario *)(cabecalho + 1);
+    mapeado->numRegistros = (tamanho - sizeof(CabecalhoDiario)) / sizeof(RegistroDiario);
+    return true;
+}
+
+void diarioDesmapear(DiarioMapeado *mapeado) {
+    if (mapeado->mapa != NULL) munmap(mapeado->mapa, mapeado->tamanho);
+    memset(mapeado, 0, sizeof(*mapeado));
+}
+
+/**
+ * @brief Recria a sessão do diário e reexecuta todas as ações sem impressão.
+ * * Confere o resultado de cada ação (executada e peça de reposição) e o hash
+ * do estado em cada ponto de verificação. Ao final exibe o estado e o resumo.
+ * @return 0 se a reprodução bateu com o diário, 1 em caso de erro ou divergência.
+ */
+int diarioReproduzir(const char *caminho) {
+    DiarioMapeado mapeado;
+    if (!diarioMapear(&mapeado, caminho)) return 1;
+
+    const CabecalhoDiario *cabecalho = mapeado.cabecalho;
+    FilaPecas fila;
+    PilhaPecas pilha;
+    HistoricoAcoes historico;
+    HistoricoAcoes *historicoAtivo = NULL;
+
+    modoSilencioso = true;
+    tamanhoTroca = cabecalho->tamanhoTroca;
+    if (!inicializarPilha(&pilha, cabecalho->capacidadePilha)) {
+        diarioDesmapear(&mapeado);
+        return 1;
+    }
+    if (!inicializarFila(&fila, cabecalho->capacidadeFila, cabecalho->semente)) {
+        liberarPilha(&pilha);
+        diarioDesmapear(&mapeado);
+        return 1;
+    }
+    if (cabecalho->capacidadeHistorico > 0) {
+        if (!historicoInicializar(&historico, cabecalho->capacidadeHistorico, tamanhoTroca, false)) {
+            liberarFila(&fila);
+            liberarPilha(&pilha);
+            diarioDesmapear(&mapeado);
+            return 1;
+        }
+        historicoAtivo = &historico;
+    }
+
+    long long acoes = 0, divergentes = 0, primeiraDivergente = -1;
+    long long verificacoes = 0, verificacoesFalhas = 0;
+    double inicio = tempoAtual();
+
+    for (size_t i = 0; i < mapeado.numRegistros; i++) {
+        const RegistroDiario *registro = &mapeado.registros[i];
+
+        if (registro->codigo == DIARIO_VERIFICACAO) {
+            if (i + 1 == mapeado.numRegistros) break; // Ponto de verificação incompleto
+            uint64_t esperado;
+            memcpy(&esperado, &mapeado.registros[++i], sizeof(esperado));
+            verificacoes++;
+            if (esperado != diarioHashEstado(&fila, &pilha)) {
+                verificacoesFalhas++;
+                if (primeiraDivergente < 0) primeiraDivergente = acoes;
+            }
+            continue;
+        }
+
+        bool executada = historicoAtivo != NULL
+                             ? historicoAplicar(historicoAtivo, &fila, &pilha, registro->codigo)
+                             : executarAcao(&fila, &pilha, registro->codigo);
+        if (executada != (registro->executada != 0) ||
+            pecaDeReposicao(registro->codigo, executada, &fila) != registro->peca) {
+            divergentes++;
+            if (primeiraDivergente < 0) primeiraDivergente = acoes;
+        }
+        acoes++;
+    }
+
+    double decorrido = tempoAtual() - inicio;
+    modoSilencioso = false;
+
+    exibirEstadoAtual(&fila, &pilha);
+    printf("Reproducao: %lld acoes (%lld divergentes) | %lld pontos de verificacao (%lld divergentes)\n",
+           acoes, divergentes, verificacoes, verificacoesFalhas);
+    printf("Semente: %llu\n", (unsigned long long)cabecalho->semente);
+    printf("Tempo: %.6f s | Taxa: %.0f acoes/s\n",
+           decorrido, decorrido > 0 ? (double)acoes / decorrido : 0.0);
+    if (primeiraDivergente >= 0) {
+        fprintf(stderr, "ERRO: A reproducao diverge do diario a partir da acao %lld.\n",
+                primeiraDivergente + 1);
+    }
+
+    if (historicoAtivo != NULL) historicoLiberar(historicoAtivo);
+    liberarFila(&fila);
+    liberarPilha(&pilha);
+    diarioDesmapear(&mapeado);
+    return primeiraDivergente >= 0 ? 1 : 0;
+}
@@ -0,0 +1,95 @@
+#ifndef DIARIO_ACOES_H
+#define DIARIO_ACOES_H
+
+// Diário binário de ações (somente acréscimo) e reprodução determinística.
+//
+// Formato do arquivo:
+//   CabecalhoDiario (64 bytes): semente e parâmetros da sessão
+//   RegistroDiario  (8 bytes) por ação: código, se foi executada e a peça
+//                   de reposição gerada (ações 1 e 2), em forma compacta;
+//                   desfazer e refazer (6 e 7, com --historico) também entram
+//   A cada 'intervaloVerificacao' ações, um ponto de verificação: um registro
+//   com código DIARIO_VERIFICACAO seguido de 8 bytes com o hash do estado.
+//
+// Os registros são acumulados em memória e gravados em lotes de
+// DIARIO_REGISTROS_POR_LOTE. A reprodução mapeia o arquivo com mmap,
+// recria a sessão a partir da semente e reexecuta as ações, conferindo o
+// resultado de cada uma e o hash do estado em cada ponto de verificação.
+// Um registro incompleto no final (gravação interrompida) é ignorado.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tetris_stack_mestre.h"
+#include "peca_compacta.h"
+
+// --- Constantes ---
+#define DIARIO_MAGICA "TTRSDIAR"
+#define DIARIO_VERSAO 1
+#define DIARIO_VERIFICACAO 0xFF          // Código do registro de ponto de verificação
+#define DIARIO_INTERVALO_PADRAO 4096     // Ações entre pontos de verificação
+#define DIARIO_REGISTROS_POR_LOTE 8192   // Registros gravados por write()
+
+// --- Estruturas de Dados ---
+
+typedef struct {
+    char magica[8];               // DIARIO_MAGICA (sem o '\0')
+    uint32_t versao;              // DIARIO_VERSAO
+    uint32_t tamanhoRegistro;     // sizeof(RegistroDiario)
+    uint64_t semente;             // Semente do gerador da sessão
+    int32_t capacidadeFila;
+    int32_t capacidadePilha;
+    int32_t tamanhoTroca;
+    int32_t intervaloVerificacao; // Ações entre pontos de verificação
+    int32_t capacidadeHistorico;  // Capacidade do histórico (códigos 6 e 7), ou 0
+    uint8_t reservado[20];
+} CabecalhoDiario;
+
+typedef struct {
+    uint8_t codigo;       // Código da ação (1 a 7) ou DIARIO_VERIFICACAO
+    uint8_t executada;    // 1 se a ação foi executada, 0 se foi recusada
+    uint16_t reservado;
+    PecaCompacta peca;    // Peça de reposição gerada, ou PECA_COMPACTA_VAZIA
+} RegistroDiario;
+
+_Static_assert(sizeof(CabecalhoDiario) == 64, "cabecalho do diario deve ter 64 bytes");
+_Static_assert(sizeof(RegistroDiario) == 8, "registro do diario deve ter 8 bytes");
+
+// Diário aberto para gravação
+typedef struct DiarioAcoes {
+    int fd;
+    RegistroDiario *lote;      // Registros ainda não gravados
+    size_t numLote;
+    int intervaloVerificacao;
+    int desdeVerificacao;      // Ações desde o último ponto de verificação
+    long long acoes;           // Ações registradas
+    bool erro;                 // Houve falha de gravação
+} DiarioAcoes;
+
+// Diário mapeado para leitura (reprodução e análises)
+typedef struct {
+    const CabecalhoDiario *cabecalho;
+    const RegistroDiario *registros;
+    size_t numRegistros;
+    void *mapa;
+    size_t tamanho;
+} DiarioMapeado;
+
+// --- Protótipos das Funções ---
+
+// Gravação
+bool diarioAbrir(DiarioAcoes *diario, const char *caminho, const FilaPecas *fila,
+                 const PilhaPecas *pilha, int capacidadeHistorico);
+void diarioRegistrar(DiarioAcoes *diario, int opcao, bool executada,
+                     const FilaPecas *fila, const PilhaPecas *pilha);
+bool diarioDescarregar(DiarioAcoes *diario);
+bool diarioFechar(DiarioAcoes *diario);
+
+// Leitura e reprodução
+bool diarioMapear(DiarioMapeado *mapeado, const char *caminho);
+void diarioDesmapear(DiarioMapeado *mapeado);
+uint64_t diarioHashEstado(const FilaPecas *fila, const PilhaPecas *pilha);
+int diarioReproduzir(const char *caminho);
+
+#endif // DIARIO_ACOES_H
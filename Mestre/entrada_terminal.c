@@ -0,0 +1,177 @@
+#define _POSIX_C_SOURCE 200809L // sigaction, termios
+
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "entrada_terminal.h"
+
+#define TECLA_ESC 0x1b
+#define TECLA_CTRL_C 0x03
+#define TECLA_CTRL_D 0x04
+
+// Terminal em modo bruto a restaurar no exit() ou em um sinal (um por processo)
+static int fdRestaurar = -1;
+static struct termios modoRestaurar;
+static bool restauracaoRegistrada = false;
+
+// --- Decodificador ---
+
+void decodificadorIniciar(DecodificadorTeclas *d) {
+    d->estado = DECODIFICADOR_TEXTO;
+}
+
+/**
+ * @brief Código da seta pelo byte final da sequência ('A' a 'D'), ou -1.
+ */
+static int codigoSeta(unsigned char final) {
+    switch (final) {
+        case 'A': return 2; // Cima: reservar
+        case 'B': return 1; // Baixo: jogar
+        case 'C': return 4; // Direita: troca simples
+        case 'D': return 3; // Esquerda: usar a reservada
+        default: return -1;
+    }
+}
+
+/**
+ * @brief Consome um byte da entrada.
+ * @return true se o byte completou uma tecla reconhecida (*codigo recebe a ação
+ * ou TECLA_SAIR); false se ainda faltam bytes ou a tecla é ignorada.
+ */
+bool decodificadorConsumir(DecodificadorTeclas *d, unsigned char c, int *codigo) {
+    switch (d->estado) {
+        case DECODIFICADOR_ESCAPE:
+            if (c == '[') {
+                d->estado = DECODIFICADOR_CSI;
+                return false;
+            }
+            if (c == 'O') {
+                d->estado = DECODIFICADOR_SS3;
+                return false;
+            }
+            // ESC solto: é descartado e o byte vale como tecla comum
+            d->estado = DECODIFICADOR_TEXTO;
+            break;
+
+        case DECODIFICADOR_CSI:
+            // Parâmetros e intermediários (0x20-0x3f) até o byte final (0x40-0x7e)
+            if (c >= 0x20 && c <= 0x3f) return false;
+            d->estado = DECODIFICADOR_TEXTO;
+            *codigo = codigoSeta(c);
+            return *codigo >= 0;
+
+        case DECODIFICADOR_SS3:
+            d->estado = DECODIFICADOR_TEXTO;
+            *codigo = codigoSeta(c);
+            return *codigo >= 0;
+
+        case DECODIFICADOR_TEXTO:
+            break;
+    }
+
+    if (c == TECLA_ESC) {
+        d->estado = DECODIFICADOR_ESCAPE;
+        return false;
+    }
+    if (c >= '1' && c <= '5') {
+        *codigo = c - '0';
+        return true;
+    }
+    if (c == ' ') {
+        *codigo = 1;
+        return true;
+    }
+    if (c == '0' || c == 'q' || c == TECLA_CTRL_C || c == TECLA_CTRL_D) {
+        *codigo = TECLA_SAIR;
+        return true;
+    }
+    return false;
+}
+
+// --- Modo Bruto ---
+
+static void restaurarTerminal(void) {
+    if (fdRestaurar >= 0) tcsetattr(fdRestaurar, TCSAFLUSH, &modoRestaurar);
+}
+
+/**
+ * @brief Restaura o terminal e repete o sinal com a ação padrão.
+ * * Só usa funções seguras em tratadores de sinal (tcsetattr, sigaction, raise).
+ */
+static void tratarSinal(int sinal) {
+    restaurarTerminal();
+    struct sigaction padrao = {0};
+    padrao.sa_handler = SIG_DFL;
+    sigaction(sinal, &padrao, NULL);
+    raise(sinal);
+}
+
+/**
+ * @brief Prepara a leitura de teclas de fd; em um terminal, liga o modo bruto.
+ * @return false se o terminal não puder ser configurado.
+ */
+bool entradaAbrir(EntradaTerminal *entrada, int fd) {
+    entrada->fd = fd;
+    entrada->modoBruto = false;
+    decodificadorIniciar(&entrada->decodificador);
+    if (!isatty(fd)) return true;
+
+    if (tcgetattr(fd, &entrada->original) != 0) return false;
+    struct termios bruto = entrada->original;
+    bruto.c_lflag &= ~(tcflag_t)(ICANON | ECHO | ISIG | IEXTEN);
+    bruto.c_iflag &= ~(tcflag_t)(IXON | ICRNL);
+    bruto.c_cc[VMIN] = 0;  // read() volta na hora, com o que houver
+    bruto.c_cc[VTIME] = 0;
+
+    fdRestaurar = fd;
+    modoRestaurar = entrada->original;
+    if (!restauracaoRegistrada) {
+        atexit(restaurarTerminal);
+        struct sigaction acao = {0};
+        acao.sa_handler = tratarSinal;
+        sigaction(SIGTERM, &acao, NULL);
+        sigaction(SIGHUP, &acao, NULL);
+        restauracaoRegistrada = true;
+    }
+    if (tcsetattr(fd, TCSAFLUSH, &bruto) != 0) {
+        fdRestaurar = -1;
+        return false;
+    }
+    entrada->modoBruto = true;
+    return true;
+}
+
+/**
+ * @brief Lê os bytes disponíveis e devolve os códigos das teclas completas.
+ * * Deve ser chamada depois que poll/ppoll indicar dados: em um pipe sem
+ * dados, read() esperaria.
+ * @param codigos Vetor com espaço para maxCodigos códigos (um por byte lido, no máximo).
+ * @return Número de códigos, ou -1 no fim da entrada (ou erro de leitura).
+ */
+int entradaLer(EntradaTerminal *entrada, int *codigos, int maxCodigos) {
+    unsigned char bytes[ENTRADA_MAX_BYTES];
+    size_t pedir = maxCodigos < ENTRADA_MAX_BYTES ? (size_t)maxCodigos : sizeof(bytes);
+    ssize_t n = read(entrada->fd, bytes, pedir);
+    if (n < 0) return errno == EINTR || errno == EAGAIN ? 0 : -1;
+    // Em modo bruto (VMIN = 0), 0 bytes só quer dizer que nada chegou
+    if (n == 0) return entrada->modoBruto ? 0 : -1;
+
+    int numCodigos = 0;
+    for (ssize_t i = 0; i < n; i++) {
+        int codigo;
+        if (decodificadorConsumir(&entrada->decodificador, bytes[i], &codigo)) codigos[numCodigos++] = codigo;
+    }
+    return numCodigos;
+}
+
+/**
+ * @brief Devolve o terminal ao modo original (nada a fazer fora de um terminal).
+ */
+void entradaFechar(EntradaTerminal *entrada) {
+    if (!entrada->modoBruto) return;
+    tcsetattr(entrada->fd, TCSAFLUSH, &entrada->original);
+    entrada->modoBruto = false;
+    fdRestaurar = -1;
+}
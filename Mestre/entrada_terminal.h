@@ -0,0 +1,62 @@
+#ifndef ENTRADA_TERMINAL_H
+#define ENTRADA_TERMINAL_H
+
+// Entrada de teclas sem bloqueio do simulador Mestre.
+//
+// Com a entrada em um terminal, entradaAbrir o coloca em modo bruto
+// (termios sem ICANON, ECHO e ISIG, VMIN = VTIME = 0): cada tecla chega ao
+// processo assim que é pressionada, sem esperar o Enter, e read() nunca
+// espera. O modo original volta em entradaFechar, no exit() e nos sinais
+// SIGTERM e SIGHUP. Pipes e arquivos são lidos como estão.
+//
+// Quem chama só lê depois de poll/ppoll indicar dados (entradaLer nunca é
+// chamada às cegas), então a thread da simulação nunca fica parada na entrada.
+//
+// O decodificador converte os bytes em códigos de ação, guardando o estado
+// entre leituras (uma sequência de escape pode chegar partida):
+//   '1'..'5'          ações 1 a 5
+//   seta para baixo   1 (jogar)            espaço  1 (jogar)
+//   seta para cima    2 (reservar)
+//   seta esquerda     3 (usar a reservada)
+//   seta direita      4 (troca simples)
+//   '0', 'q', Ctrl+C, Ctrl+D   TECLA_SAIR
+// As setas são aceitas como CSI ("ESC [ A", também com parâmetros, como
+// "ESC [ 1 ; 5 A") e SS3 ("ESC O A"); as demais sequências são ignoradas.
+
+#include <stdbool.h>
+#include <termios.h>
+
+// --- Constantes ---
+#define TECLA_SAIR 0
+#define ENTRADA_MAX_BYTES 256 // Bytes lidos por chamada de entradaLer
+
+// --- Estruturas de Dados ---
+
+typedef enum {
+    DECODIFICADOR_TEXTO,  // Fora de uma sequência de escape
+    DECODIFICADOR_ESCAPE, // Depois de ESC
+    DECODIFICADOR_CSI,    // Depois de "ESC [" (parâmetros até o byte final)
+    DECODIFICADOR_SS3     // Depois de "ESC O"
+} EstadoDecodificador;
+
+typedef struct {
+    EstadoDecodificador estado;
+} DecodificadorTeclas;
+
+typedef struct {
+    int fd;
+    bool modoBruto;           // O terminal foi colocado em modo bruto
+    struct termios original;  // Modo a restaurar
+    DecodificadorTeclas decodificador;
+} EntradaTerminal;
+
+// --- Protótipos das Funções ---
+
+void decodificadorIniciar(DecodificadorTeclas *d);
+bool decodificadorConsumir(DecodificadorTeclas *d, unsigned char c, int *codigo);
+
+bool entradaAbrir(EntradaTerminal *entrada, int fd);
+int entradaLer(EntradaTerminal *entrada, int *codigos, int maxCodigos);
+void entradaFechar(EntradaTerminal *entrada);
+
+#endif // ENTRADA_TERMINAL_H
@@ -0,0 +1,93 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime
+
+#include <string.h>
+
+#include "estatisticas_acoes.h"
+
+EstatisticasSimulador estatisticas;
+
+static const char *NOMES_OPERACOES[ESTAT_NUM_OPERACOES] = {
+    "jogar", "reservar", "usar", "troca_simples", "troca_multipla",
+    "desfazer", "refazer", "renderizar"
+};
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Limite superior (ns) do balde onde cai o percentil pedido.
+ */
+static uint64_t percentilNs(const EstatisticasOperacao *op, double percentil) {
+    uint64_t total = op->executadas + op->recusadas;
+    if (total == 0) return 0;
+
+    uint64_t alvo = (uint64_t)(percentil * (double)total);
+    if (alvo >= total) alvo = total - 1;
+    uint64_t acumulado = 0;
+    for (int b = 0; b < ESTATISTICAS_BALDES; b++) {
+        acumulado += op->baldes[b];
+        if (acumulado > alvo) {
+            uint64_t limite = (2ULL << b) - 1;
+            return limite < op->maxNs ? limite : op->maxNs;
+        }
+    }
+    return op->maxNs;
+}
+
+// --- Funções Públicas ---
+
+void estatisticasZerar(void) {
+    memset(estatisticas.operacoes, 0, sizeof(estatisticas.operacoes));
+}
+
+/**
+ * @brief Exibe os contadores e os percentis de latência de cada operação.
+ * * No formato JSON, um único objeto com uma entrada por operação (incluindo
+ * o histograma completo); no texto, uma tabela.
+ */
+void estatisticasExibir(FILE *saida, FormatoEstatisticas formato) {
+    if (!ESTATISTICAS_COMPILADAS) {
+        fprintf(saida, formato == ESTATISTICAS_JSON
+                ? "{\"estatisticas\":null}\n"
+                : "\nEstatisticas desativadas na compilacao (TETRIS_SEM_ESTATISTICAS).\n");
+        return;
+    }
+
+    if (formato == ESTATISTICAS_JSON) {
+        fprintf(saida, "{\"operacoes\":[");
+        for (int i = 0; i < ESTAT_NUM_OPERACOES; i++) {
+            const EstatisticasOperacao *op = &estatisticas.operacoes[i];
+            uint64_t total = op->executadas + op->recusadas;
+            fprintf(saida,
+                    "%s{\"op\":\"%s\",\"executadas\":%llu,\"recusadas\":%llu,\"ns_media\":%.1f,"
+                    "\"ns_p50\":%llu,\"ns_p99\":%llu,\"ns_max\":%llu,\"histograma\":[",
+                    i > 0 ? "," : "", NOMES_OPERACOES[i],
+                    (unsigned long long)op->executadas, (unsigned long long)op->recusadas,
+                    total > 0 ? (double)op->somaNs / (double)total : 0.0,
+                    (unsigned long long)percentilNs(op, 0.50), (unsigned long long)percentilNs(op, 0.99),
+                    (unsigned long long)op->maxNs);
+            for (int b = 0; b < ESTATISTICAS_BALDES; b++) {
+                fprintf(saida, "%s%llu", b > 0 ? "," : "", (unsigned long long)op->baldes[b]);
+            }
+            fprintf(saida, "]}");
+        }
+        fprintf(saida, "]}\n");
+        return;
+    }
+
+    fprintf(saida,
+            "\n=======================================================================\n"
+            "                     ESTATISTICAS DAS OPERACOES\n"
+            "=======================================================================\n"
+            "%-15s %10s %10s %7s %10s %10s %10s\n",
+            "Operacao", "Executadas", "Recusadas", "Recusa", "Media ns", "p99 ns", "Max ns");
+    for (int i = 0; i < ESTAT_NUM_OPERACOES; i++) {
+        const EstatisticasOperacao *op = &estatisticas.operacoes[i];
+        uint64_t total = op->executadas + op->recusadas;
+        if (total == 0) continue;
+        fprintf(saida, "%-15s %10llu %10llu %6.1f%% %10.0f %10llu %10llu\n",
+                NOMES_OPERACOES[i], (unsigned long long)op->executadas, (unsigned long long)op->recusadas,
+                100.0 * (double)op->recusadas / (double)total, (double)op->somaNs / (double)total,
+                (unsigned long long)percentilNs(op, 0.99), (unsigned long long)op->maxNs);
+    }
+    fprintf(saida, "-----------------------------------------------------------------------\n");
+}
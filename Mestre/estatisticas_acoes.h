@@ -0,0 +1,113 @@
+#ifndef ESTATISTICAS_ACOES_H
+#define ESTATISTICAS_ACOES_H
+
+// Contadores e histogramas de latência das ações do simulador Mestre.
+//
+// Para cada ação do menu (1 a 7) são contadas as execuções e as recusas
+// (caminhos de AVISO), e a duração de cada chamada entra em um histograma
+// de baldes logarítmicos (balde b = [2^b, 2^(b+1)) ns). A renderização do
+// quadro e do menu tem a sua própria linha, para comparar o custo do
+// terminal com o da lógica.
+//
+// A coleta só acontece com estatisticas.ativa; compilando com
+// -DTETRIS_SEM_ESTATISTICAS as chamadas de registro viram código vazio.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// --- Constantes ---
+#define ESTATISTICAS_BALDES 40 // Baldes do histograma (até ~2^40 ns, cerca de 18 minutos)
+
+// Operações medidas (as ações 1 a 7 usam o índice codigo - 1)
+enum {
+    ESTAT_JOGAR,
+    ESTAT_RESERVAR,
+    ESTAT_USAR,
+    ESTAT_TROCA_SIMPLES,
+    ESTAT_TROCA_MULTIPLA,
+    ESTAT_DESFAZER,
+    ESTAT_REFAZER,
+    ESTAT_RENDERIZAR,
+    ESTAT_NUM_OPERACOES
+};
+
+typedef enum {
+    ESTATISTICAS_TEXTO,
+    ESTATISTICAS_JSON
+} FormatoEstatisticas;
+
+// --- Estruturas de Dados ---
+
+typedef struct {
+    uint64_t executadas;
+    uint64_t recusadas;
+    uint64_t somaNs;
+    uint64_t maxNs;
+    uint64_t baldes[ESTATISTICAS_BALDES];
+} EstatisticasOperacao;
+
+typedef struct {
+    bool ativa; // Coleta ligada (modo interativo, ou --estatisticas)
+    EstatisticasOperacao operacoes[ESTAT_NUM_OPERACOES];
+} EstatisticasSimulador;
+
+extern EstatisticasSimulador estatisticas;
+
+// --- Protótipos das Funções ---
+
+void estatisticasZerar(void);
+void estatisticasExibir(FILE *saida, FormatoEstatisticas formato);
+
+// --- Registro (caminho crítico) ---
+
+#ifdef TETRIS_SEM_ESTATISTICAS
+
+#define ESTATISTICAS_COMPILADAS false
+static inline uint64_t estatisticasInicio(void) { return 0; }
+static inline void estatisticasRegistrar(int operacao, bool executada, uint64_t inicio) {
+    (void)operacao; (void)executada; (void)inicio;
+}
+
+#else
+
+#define ESTATISTICAS_COMPILADAS true
+
+/**
+ * @brief Instante (ns) do início da operação, ou 0 se a coleta estiver desligada.
+ */
+static inline uint64_t estatisticasInicio(void) {
+    if (!estatisticas.ativa) return 0;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Conta a operação e acrescenta a sua duração ao histograma.
+ * @param inicio Valor devolvido por estatisticasInicio.
+ */
+static inline void estatisticasRegistrar(int operacao, bool executada, uint64_t inicio) {
+    if (!estatisticas.ativa || operacao < 0 || operacao >= ESTAT_NUM_OPERACOES) return;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t duracao = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec - inicio;
+    int balde = 63 - __builtin_clzll(duracao | 1);
+    if (balde >= ESTATISTICAS_BALDES) balde = ESTATISTICAS_BALDES - 1;
+
+    EstatisticasOperacao *op = &estatisticas.operacoes[operacao];
+    if (executada) {
+        op->executadas++;
+    } else {
+        op->recusadas++;
+    }
+    op->somaNs += duracao;
+    if (duracao > op->maxNs) op->maxNs = duracao;
+    op->baldes[balde]++;
+}
+
+#endif // TETRIS_SEM_ESTATISTICAS
+
+#endif // ESTATISTICAS_ACOES_H
@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "historico_acoes.h"
+#include "../Comum/anel_circular.h"
+
+// --- Funções Auxiliares ---
+
+static void capturarEscalares(EscalaresSessao *e, const FilaPecas *fila, const PilhaPecas *pilha) {
+    e->frente = fila->frente;
+    e->tras = fila->tras;
+    e->contador = fila->contador;
+    e->proximoId = fila->proximo_id;
+    e->topo = pilha->topo;
+    e->gerador = fila->gerador;
+}
+
+static void aplicarEscalares(const EscalaresSessao *e, FilaPecas *fila, PilhaPecas *pilha) {
+    fila->frente = e->frente;
+    fila->tras = e->tras;
+    fila->contador = e->contador;
+    fila->proximo_id = e->proximoId;
+    pilha->topo = e->topo;
+    fila->gerador = e->gerador;
+}
+
+/**
+ * @brief Tabuleiros de antes e de depois da entrada 'pos' ('capacidade' = rascunho).
+ */
+static inline Tabuleiro *tabuleirosEntrada(const HistoricoAcoes *historico, int pos) {
+    return &historico->tabuleiros[2 * (size_t)pos];
+}
+
+static Peca *posicaoAlterada(const AlteracaoPeca *alteracao, FilaPecas *fila, PilhaPecas *pilha) {
+    return alteracao->naPilha ? &pilha->itens[alteracao->indice] : &fila->itens[alteracao->indice];
+}
+
+/**
+ * @brief Lista as posições que a ação pode sobrescrever, com o valor atual de cada uma.
+ * @return Número de posições (no máximo 'max'), ou -1 se a Troca Múltipla
+ * atual (tamanhoTroca) não cabe no delta para o qual o histórico foi criado.
+ */
+static int posicoesAfetadas(int opcao, FilaPecas *fila, PilhaPecas *pilha, AlteracaoPeca *alteracoes, int max) {
+    int n = 0;
+    int limite = max / 2; // Posições de cada estrutura na Troca Múltipla
+
+    if (opcao == 5 && tamanhoTroca > limite) return -1;
+
+    switch (opcao) {
+        case 1: // Reposição no final da fila
+            alteracoes[n++] = (AlteracaoPeca){.indice = ANEL_AVANCAR_DINAMICO(fila->tras, fila->capacidade)};
+            break;
+        case 2: // Reposição no final da fila + push na pilha
+            alteracoes[n++] = (AlteracaoPeca){.indice = ANEL_AVANCAR_DINAMICO(fila->tras, fila->capacidade)};
+            if (pilha->topo + 1 < pilha->capacidade) {
+                alteracoes[n++] = (AlteracaoPeca){.indice = pilha->topo + 1, .naPilha = true};
+            }
+            break;
+        case 4: // Frente da fila <-> topo da pilha
+            alteracoes[n++] = (AlteracaoPeca){.indice = fila->frente};
+            if (pilha->topo >= 0) alteracoes[n++] = (AlteracaoPeca){.indice = pilha->topo, .naPilha = true};
+            break;
+        case 5: // Bloco da frente da fila <-> bloco do topo da pilha
+            for (int i = 0; i < tamanhoTroca && i < fila->contador; i++) {
+                alteracoes[n++] = (AlteracaoPeca){.indice = ANEL_INDICE_DINAMICO(fila->frente, i, fila->capacidade)};
+            }
+            for (int i = 0; i < tamanhoTroca && i <= pilha->topo; i++) {
+                alteracoes[n++] = (AlteracaoPeca){.indice = pilha->topo - i, .naPilha = true};
+            }
+            break;
+        default: // A ação 3 só altera o topo
+            break;
+    }
+    for (int i = 0; i < n; i++) alteracoes[i].antes = *posicaoAlterada(&alteracoes[i], fila, pilha);
+    return n;
+}
+
+// --- Inicialização ---
+
+/**
+ * @brief Aloca o anel para 'capacidade' ações.
+ * @param tamanhoTrocaMax Maior bloco da Troca Múltipla que será registrado.
+ * @param comTabuleiro A fila tem um tabuleiro, que também é desfeito.
+ * @return false se a capacidade for inválida ou faltar memória.
+ */
+bool historicoInicializar(HistoricoAcoes *historico, int capacidade, int tamanhoTrocaMax, bool comTabuleiro) {
+    historico->capacidade = capacidade;
+    historico->maxAlteracoes = tamanhoTrocaMax > 1 ? 2 * tamanhoTrocaMax : 2;
+    historico->inicio = historico->numDesfazer = historico->numRefazer = 0;
+
+    // A entrada extra (índice 'capacidade') é o rascunho da ação em andamento
+    historico->entradas = capacidade > 0 ? malloc((size_t)(capacidade + 1) * sizeof(EntradaHistorico)) : NULL;
+    historico->alteracoes = capacidade > 0
+        ? malloc((size_t)(capacidade + 1) * (size_t)historico->maxAlteracoes * sizeof(AlteracaoPeca)) : NULL;
+    historico->tabuleiros = capacidade > 0 && comTabuleiro
+        ? malloc(2 * (size_t)(capacidade + 1) * sizeof(Tabuleiro)) : NULL;
+    if (historico->entradas == NULL || historico->alteracoes == NULL ||
+        (capacidade > 0 && comTabuleiro && historico->tabuleiros == NULL)) {
+        fprintf(stderr, "ERRO: Nao foi possivel alocar o historico com capacidade %d.\n", capacidade);
+        historicoLiberar(historico);
+        return false;
+    }
+    return true;
+}
+
+void historicoLiberar(HistoricoAcoes *historico) {
+    free(historico->entradas);
+    free(historico->alteracoes);
+    free(historico->tabuleiros);
+    historico->entradas = NULL;
+    historico->alteracoes = NULL;
+    historico->tabuleiros = NULL;
+    historico->capacidade = historico->numDesfazer = historico->numRefazer = 0;
+}
+
+// --- Desfazer e Refazer ---
+
+bool historicoDesfazer(HistoricoAcoes *historico, FilaPecas *fila, PilhaPecas *pilha) {
+    if (historico->numDesfazer == 0) {
+        MENSAGEM("\nAVISO: Nao ha acoes para desfazer.\n");
+        return false;
+    }
+
+    int pos = ANEL_INDICE_DINAMICO(historico->inicio, historico->numDesfazer - 1, historico->capacidade);
+    const EntradaHistorico *entrada = &historico->entradas[pos];
+    const AlteracaoPeca *alteracoes = &historico->alteracoes[(size_t)pos * (size_t)historico->maxAlteracoes];
+
+    for (int i = entrada->numAlteracoes - 1; i >= 0; i--) {
+        *posicaoAlterada(&alteracoes[i], fila, pilha) = alteracoes[i].antes;
+    }
+    aplicarEscalares(&entrada->antes, fila, pilha);
+    if (historico->tabuleiros != NULL && fila->tabuleiro != NULL) {
+        *fila->tabuleiro = tabuleirosEntrada(historico, pos)[0];
+    }
+    historico->numDesfazer--;
+    historico->numRefazer++;
+
+    MENSAGEM("\nAcao 6: Acao %d desfeita.\n", entrada->codigo);
+    return true;
+}
+
+bool historicoRefazer(HistoricoAcoes *historico, FilaPecas *fila, PilhaPecas *pilha) {
+    if (historico->numRefazer == 0) {
+        MENSAGEM("\nAVISO: Nao ha acoes para refazer.\n");
+        return false;
+    }
+
+    int pos = ANEL_INDICE_DINAMICO(historico->inicio, historico->numDesfazer, historico->capacidade);
+    const EntradaHistorico *entrada = &historico->entradas[pos];
+    const AlteracaoPeca *alteracoes = &historico->alteracoes[(size_t)pos * (size_t)historico->maxAlteracoes];
+
+    for (int i = 0; i < entrada->numAlteracoes; i++) {
+        *posicaoAlterada(&alteracoes[i], fila, pilha) = alteracoes[i].depois;
+    }
+    aplicarEscalares(&entrada->depois, fila, pilha);
+    if (historico->tabuleiros != NULL && fila->tabuleiro != NULL) {
+        *fila->tabuleiro = tabuleirosEntrada(historico, pos)[1];
+    }
+    historico->numDesfazer++;
+    historico->numRefazer--;
+
+    MENSAGEM("\nAcao 7: Acao %d refeita.\n", entrada->codigo);
+    return true;
+}
+
+// --- Execução com Registro ---
+
+/**
+ * @brief Executa a ação do menu registrando o delta (1 a 5), ou desfaz (6) ou refaz (7).
+ * * Ações recusadas não entram no histórico nem descartam o que pode ser refeito.
+ * @return true se a ação foi executada, false se foi recusada ou o código é inválido.
+ */
+bool historicoAplicar(HistoricoAcoes *historico, FilaPecas *fila, PilhaPecas *pilha, int opcao) {
+    if (opcao == ACAO_DESFAZER) return historicoDesfazer(historico, fila, pilha);
+    if (opcao == ACAO_REFAZER) return historicoRefazer(historico, fila, pilha);
+
+    // O delta é montado no rascunho e só entra no anel se a ação for executada
+    size_t max = (size_t)historico->maxAlteracoes;
+    EntradaHistorico *rascunho = &historico->entradas[historico->capacidade];
+    AlteracaoPeca *alteracoesRascunho = &historico->alteracoes[(size_t)historico->capacidade * max];
+
+    bool comTabuleiro = historico->tabuleiros != NULL && fila->tabuleiro != NULL;
+    Tabuleiro *tabuleirosRascunho = comTabuleiro ? tabuleirosEntrada(historico, historico->capacidade) : NULL;
+
+    capturarEscalares(&rascunho->antes, fila, pilha);
+    if (comTabuleiro) tabuleirosRascunho[0] = *fila->tabuleiro;
+    rascunho->codigo = opcao;
+    rascunho->numAlteracoes = posicoesAfetadas(opcao, fila, pilha, alteracoesRascunho, historico->maxAlteracoes);
+    if (rascunho->numAlteracoes < 0) {
+        // Desfazer só parte do bloco corromperia a sessão: a ação é recusada
+        fprintf(stderr, "ERRO: O historico foi criado para trocas de ate %d pecas (troca atual: %d).\n",
+                historico->maxAlteracoes / 2, tamanhoTroca);
+        return false;
+    }
+
+    if (!executarAcao(fila, pilha, opcao)) return false;
+
+    capturarEscalares(&rascunho->depois, fila, pilha);
+    if (comTabuleiro) tabuleirosRascunho[1] = *fila->tabuleiro;
+    for (int i = 0; i < rascunho->numAlteracoes; i++) {
+        alteracoesRascunho[i].depois = *posicaoAlterada(&alteracoesRascunho[i], fila, pilha);
+    }
+
+    // Anel cheio: descarta a ação mais antiga
+    if (historico->numDesfazer == historico->capacidade) {
+        historico->inicio = ANEL_AVANCAR_DINAMICO(historico->inicio, historico->capacidade);
+        historico->numDesfazer--;
+    }
+    int pos = ANEL_INDICE_DINAMICO(historico->inicio, historico->numDesfazer, historico->capacidade);
+    historico->entradas[pos] = *rascunho;
+    for (int i = 0; i < rascunho->numAlteracoes; i++) {
+        historico->alteracoes[(size_t)pos * max + (size_t)i] = alteracoesRascunho[i];
+    }
+    if (comTabuleiro) {
+        tabuleirosEntrada(historico, pos)[0] = tabuleirosRascunho[0];
+        tabuleirosEntrada(historico, pos)[1] = tabuleirosRascunho[1];
+    }
+    historico->numDesfazer++;
+    historico->numRefazer = 0;
+    return true;
+}
@@ -0,0 +1,75 @@
+#ifndef HISTORICO_ACOES_H
+#define HISTORICO_ACOES_H
+
+// Histórico de desfazer/refazer das ações do simulador Mestre.
+//
+// Cada ação executada guarda um delta mínimo: as posições da fila e da pilha
+// que foram sobrescritas (com a peça de antes e a de depois) e os campos
+// escalares de antes e de depois (frente, tras, contador, proximo_id, topo e
+// o estado do gerador, para que a mesma peça volte a ser gerada). Só um
+// histórico criado para uma fila com tabuleiro guarda também o tabuleiro de
+// antes e o de depois (menos de 100 bytes cada), em um anel à parte.
+//
+// Os deltas ficam em um anel de capacidade fixa, alocado uma única vez:
+// desfazer grava os valores de antes, refazer grava os de depois, ambos sem
+// alocação e com custo proporcional ao delta (1 ou 2 posições; 2 * troca na
+// Troca Múltipla). Com o anel cheio, a ação mais antiga é descartada; uma
+// nova ação descarta as que podiam ser refeitas.
+
+#include <stdbool.h>
+
+#include "tetris_stack_mestre.h"
+#include "tabuleiro.h"
+
+// --- Constantes ---
+#define ACAO_DESFAZER 6                  // Código do menu para desfazer
+#define ACAO_REFAZER 7                   // Código do menu para refazer
+#define HISTORICO_CAPACIDADE_PADRAO 1024 // Ações guardadas por padrão (--historico)
+
+// --- Estruturas de Dados ---
+
+// Campos escalares da sessão antes ou depois de uma ação
+typedef struct {
+    int frente;
+    int tras;
+    int contador;
+    int proximoId;
+    int topo;
+    GeradorPecas gerador;
+} EscalaresSessao;
+
+// Posição sobrescrita por uma ação
+typedef struct {
+    Peca antes;
+    Peca depois;
+    int indice;
+    bool naPilha; // false = posição da fila
+} AlteracaoPeca;
+
+typedef struct {
+    EscalaresSessao antes;
+    EscalaresSessao depois;
+    int codigo;         // Ação (1 a 5)
+    int numAlteracoes;
+} EntradaHistorico;
+
+typedef struct HistoricoAcoes {
+    EntradaHistorico *entradas; // Anel de 'capacidade' entradas
+    AlteracaoPeca *alteracoes;  // maxAlteracoes posições por entrada
+    Tabuleiro *tabuleiros;      // Antes e depois de cada entrada, ou NULL (sem tabuleiro)
+    int capacidade;
+    int maxAlteracoes;
+    int inicio;                 // Entrada mais antiga
+    int numDesfazer;            // Entradas que podem ser desfeitas (a partir de inicio)
+    int numRefazer;             // Entradas seguintes que podem ser refeitas
+} HistoricoAcoes;
+
+// --- Protótipos das Funções ---
+
+bool historicoInicializar(HistoricoAcoes *historico, int capacidade, int tamanhoTrocaMax, bool comTabuleiro);
+void historicoLiberar(HistoricoAcoes *historico);
+bool historicoDesfazer(HistoricoAcoes *historico, FilaPecas *fila, PilhaPecas *pilha);
+bool historicoRefazer(HistoricoAcoes *historico, FilaPecas *fila, PilhaPecas *pilha);
+bool historicoAplicar(HistoricoAcoes *historico, FilaPecas *fila, PilhaPecas *pilha, int opcao);
+
+#endif // HISTORICO_ACOES_H
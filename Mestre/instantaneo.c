@@ -0,0 +1,263 @@
+#define _POSIX_C_SOURCE 200809L // mmap, ftruncate, fsync
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "instantaneo.h"
+
+// --- Funções Auxiliares ---
+
+static uint64_t alinharSecao(uint64_t deslocamento) {
+    return (deslocamento + INSTANTANEO_ALINHAMENTO - 1) & ~(uint64_t)(INSTANTANEO_ALINHAMENTO - 1);
+}
+
+/**
+ * @brief Tamanho em bytes de cada seção.
+ */
+static void tamanhosSecoes(uint64_t tamanhos[INSTANTANEO_NUM_SECOES], int numSessoes,
+                           int capacidadeFila, int capacidadePilha) {
+    uint64_t n = (uint64_t)numSessoes;
+    tamanhos[INSTANTANEO_ITENS_FILA] = n * (uint64_t)capacidadeFila * sizeof(Peca);
+    tamanhos[INSTANTANEO_ITENS_PILHA] = n * (uint64_t)capacidadePilha * sizeof(Peca);
+    tamanhos[INSTANTANEO_FRENTE] = n * sizeof(int);
+    tamanhos[INSTANTANEO_TRAS] = n * sizeof(int);
+    tamanhos[INSTANTANEO_CONTADOR] = n * sizeof(int);
+    tamanhos[INSTANTANEO_PROXIMO_ID] = n * sizeof(int);
+    tamanhos[INSTANTANEO_TOPO] = n * sizeof(int);
+    tamanhos[INSTANTANEO_GERADORES] = n * sizeof(GeradorPecas);
+}
+
+/**
+ * @brief Preenche o cabeçalho (inclusive a posição de cada seção) a partir
+ * do número de sessões e das capacidades.
+ */
+static void montarCabecalho(CabecalhoInstantaneo *c, int numSessoes, int capacidadeFila, int capacidadePilha) {
+    uint64_t tamanhos[INSTANTANEO_NUM_SECOES];
+    tamanhosSecoes(tamanhos, numSessoes, capacidadeFila, capacidadePilha);
+
+    memset(c, 0, sizeof(*c));
+    memcpy(c->magica, INSTANTANEO_MAGICA, sizeof(c->magica));
+    c->versao = INSTANTANEO_VERSAO;
+    c->ordemBytes = INSTANTANEO_ORDEM_BYTES;
+    c->tamanhoPeca = sizeof(Peca);
+    c->tamanhoGerador = sizeof(GeradorPecas);
+    c->numSessoes = numSessoes;
+    c->capacidadeFila = capacidadeFila;
+    c->capacidadePilha = capacidadePilha;
+    c->tamanhoTroca = tamanhoTroca;
+
+    uint64_t deslocamento = alinharSecao(sizeof(*c));
+    for (int s = 0; s < INSTANTANEO_NUM_SECOES; s++) {
+        c->secoes[s] = deslocamento;
+        deslocamento = alinharSecao(deslocamento + tamanhos[s]);
+    }
+    c->tamanhoArquivo = deslocamento;
+}
+
+/**
+ * @brief Confere se os campos escalares de cada sessão são coerentes com as capacidades.
+ */
+static bool sessoesCoerentes(const GerenciadorSessoes *g) {
+    for (SessaoId id = 0; id < g->numSessoes; id++) {
+        if (g->frente[id] < 0 || g->frente[id] >= g->capacidadeFila ||
+            g->tras[id] < 0 || g->tras[id] >= g->capacidadeFila ||
+            g->contador[id] < 0 || g->contador[id] > g->capacidadeFila ||
+            g->topo[id] < -1 || g->topo[id] >= g->capacidadePilha || g->proximoId[id] < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Várias Sessões ---
+
+/**
+ * @brief Grava o estado de todas as sessões do gerenciador.
+ * * Não deve haver ações pendentes nas threads trabalhadoras (ver sessoesAguardar).
+ * @return false em caso de erro de gravação (o arquivo anterior, se houver, é mantido).
+ */
+bool instantaneoSalvarSessoes(const GerenciadorSessoes *g, const char *caminho) {
+    CabecalhoInstantaneo cabecalho;
+    montarCabecalho(&cabecalho, g->numSessoes, g->capacidadeFila, g->capacidadePilha);
+
+    const void *origens[INSTANTANEO_NUM_SECOES] = {
+        g->itensFila, g->itensPilha, g->frente, g->tras, g->contador, g->proximoId, g->topo, g->geradores
+    };
+    uint64_t tamanhos[INSTANTANEO_NUM_SECOES];
+    tamanhosSecoes(tamanhos, g->numSessoes, g->capacidadeFila, g->capacidadePilha);
+
+    size_t tamanhoCaminho = strlen(caminho);
+    char *temporario = malloc(tamanhoCaminho + sizeof(".tmp"));
+    if (temporario == NULL) return false;
+    memcpy(temporario, caminho, tamanhoCaminho);
+    memcpy(temporario + tamanhoCaminho, ".tmp", sizeof(".tmp"));
+
+    bool ok = false;
+    int fd = open(temporario, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0 && ftruncate(fd, (off_t)cabecalho.tamanhoArquivo) == 0) {
+        char *mapa = mmap(NULL, cabecalho.tamanhoArquivo, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapa != MAP_FAILED) {
+            memcpy(mapa, &cabecalho, sizeof(cabecalho));
+            for (int s = 0; s < INSTANTANEO_NUM_SECOES; s++) {
+                memcpy(mapa + cabecalho.secoes[s], origens[s], tamanhos[s]);
+            }
+            ok = munmap(mapa, cabecalho.tamanhoArquivo) == 0 && fsync(fd) == 0;
+        }
+    }
+    if (fd >= 0 && close(fd) != 0) ok = false;
+    if (ok) ok = rename(temporario, caminho) == 0;
+
+    if (!ok) {
+        fprintf(stderr, "ERRO: Nao foi possivel gravar o instantaneo '%s'.\n", caminho);
+        unlink(temporario);
+    }
+    free(temporario);
+    return ok;
+}
+
+/**
+ * @brief Restaura as sessões de um instantâneo sem copiá-las (ver o topo do arquivo).
+ * * O gerenciador restaurado não tem threads trabalhadoras; tamanhoTroca
+ * passa a ser o do instantâneo (com um AVISO se era outro, ex.: de --troca).
+ * Libere com sessoesDestruir.
+ * @return false se o arquivo não existir, não for um instantâneo válido
+ * desta versão/arquitetura ou tiver sessões incoerentes.
+ */
+bool instantaneoRestaurarSessoes(GerenciadorSessoes *g, const char *caminho) {
+    memset(g, 0, sizeof(*g));
+
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "ERRO: Nao foi possivel abrir o instantaneo '%s'.\n", caminho);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(CabecalhoInstantaneo)) {
+        fprintf(stderr, "ERRO: '%s' nao e um instantaneo valido.\n", caminho);
+        close(fd);
+        return false;
+    }
+
+    size_t tamanho = (size_t)info.st_size;
+    char *mapa = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        fprintf(stderr, "ERRO: Nao foi possivel mapear o instantaneo '%s'.\n", caminho);
+        return false;
+    }
+
+    // O layout é totalmente determinado pelas contagens: basta recalculá-lo e comparar
+    const CabecalhoInstantaneo *cabecalho = (const CabecalhoInstantaneo *)mapa;
+    CabecalhoInstantaneo esperado;
+    bool valido = memcmp(cabecalho->magica, INSTANTANEO_MAGICA, sizeof(cabecalho->magica)) == 0 &&
+                  cabecalho->versao == INSTANTANEO_VERSAO && cabecalho->ordemBytes == INSTANTANEO_ORDEM_BYTES &&
+                  cabecalho->numSessoes > 0 && cabecalho->capacidadeFila > 0 &&
+                  cabecalho->capacidadePilha > 0 && cabecalho->tamanhoTroca > 0;
+    if (valido) {
+        montarCabecalho(&esperado, cabecalho->numSessoes, cabecalho->capacidadeFila, cabecalho->capacidadePilha);
+        valido = cabecalho->tamanhoPeca == esperado.tamanhoPeca &&
+                 cabecalho->tamanhoGerador == esperado.tamanhoGerador &&
+                 memcmp(cabecalho->secoes, esperado.secoes, sizeof(esperado.secoes)) == 0 &&
+                 cabecalho->tamanhoArquivo == esperado.tamanhoArquivo && tamanho == esperado.tamanhoArquivo;
+    }
+    if (!valido) {
+        fprintf(stderr, "ERRO: '%s' nao e um instantaneo valido (versao %d, desta arquitetura).\n",
+                caminho, INSTANTANEO_VERSAO);
+        munmap(mapa, tamanho);
+        return false;
+    }
+
+    g->numSessoes = cabecalho->numSessoes;
+    g->capacidadeFila = cabecalho->capacidadeFila;
+    g->capacidadePilha = cabecalho->capacidadePilha;
+    g->itensFila = (Peca *)(mapa + cabecalho->secoes[INSTANTANEO_ITENS_FILA]);
+    g->itensPilha = (Peca *)(mapa + cabecalho->secoes[INSTANTANEO_ITENS_PILHA]);
+    g->frente = (int *)(mapa + cabecalho->secoes[INSTANTANEO_FRENTE]);
+    g->tras = (int *)(mapa + cabecalho->secoes[INSTANTANEO_TRAS]);
+    g->contador = (int *)(mapa + cabecalho->secoes[INSTANTANEO_CONTADOR]);
+    g->proximoId = (int *)(mapa + cabecalho->secoes[INSTANTANEO_PROXIMO_ID]);
+    g->topo = (int *)(mapa + cabecalho->secoes[INSTANTANEO_TOPO]);
+    g->geradores = (GeradorPecas *)(mapa + cabecalho->secoes[INSTANTANEO_GERADORES]);
+    g->mapa = mapa;
+    g->tamanhoMapa = tamanho;
+
+    if (!sessoesCoerentes(g)) {
+        fprintf(stderr, "ERRO: O instantaneo '%s' tem sessoes com estado incoerente.\n", caminho);
+        sessoesDestruir(g);
+        return false;
+    }
+    // A troca faz parte da sessão: o valor do instantâneo vale sobre o de --troca
+    if (tamanhoTroca != cabecalho->tamanhoTroca) {
+        fprintf(stderr, "AVISO: Usando o tamanho da troca do instantaneo '%s' (%d) no lugar de %d.\n",
+                caminho, cabecalho->tamanhoTroca, tamanhoTroca);
+    }
+    tamanhoTroca = cabecalho->tamanhoTroca;
+    return true;
+}
+
+// --- Sessão Avulsa ---
+
+/**
+ * @brief Grava uma sessão avulsa como um instantâneo de 1 sessão.
+ * * Com um canal de peças ligado o gerador da fila não acompanha as peças
+ * já entregues, então a gravação é recusada.
+ */
+bool instantaneoSalvar(const FilaPecas *fila, const PilhaPecas *pilha, const char *caminho) {
+    if (fila->canal != NULL) {
+        fprintf(stderr, "ERRO: O instantaneo nao pode ser gravado com o canal de pecas ligado.\n");
+        return false;
+    }
+
+    // Vista de 1 sessão que aponta para os campos da fila e da pilha (só leitura)
+    GerenciadorSessoes vista;
+    memset(&vista, 0, sizeof(vista));
+    vista.numSessoes = 1;
+    vista.capacidadeFila = fila->capacidade;
+    vista.capacidadePilha = pilha->capacidade;
+    vista.itensFila = fila->itens;
+    vista.itensPilha = pilha->itens;
+    vista.frente = (int *)&fila->frente;
+    vista.tras = (int *)&fila->tras;
+    vista.contador = (int *)&fila->contador;
+    vista.proximoId = (int *)&fila->proximo_id;
+    vista.topo = (int *)&pilha->topo;
+    vista.geradores = (GeradorPecas *)&fila->gerador;
+    return instantaneoSalvarSessoes(&vista, caminho);
+}
+
+/**
+ * @brief Restaura a sessão 0 de um instantâneo em uma fila e uma pilha novas.
+ * * As peças são copiadas para vetores próprios (liberados com liberarFila e liberarPilha).
+ */
+bool instantaneoRestaurar(FilaPecas *fila, PilhaPecas *pilha, const char *caminho) {
+    GerenciadorSessoes g;
+    FilaPecas filaMapeada;
+    PilhaPecas pilhaMapeada;
+
+    if (!instantaneoRestaurarSessoes(&g, caminho)) return false;
+    sessoesCarregar(&g, 0, &filaMapeada, &pilhaMapeada);
+
+    *fila = filaMapeada;
+    *pilha = pilhaMapeada;
+    fila->itens = malloc((size_t)fila->capacidade * sizeof(Peca));
+    pilha->itens = malloc((size_t)pilha->capacidade * sizeof(Peca));
+    if (fila->itens == NULL || pilha->itens == NULL) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para restaurar o instantaneo '%s'.\n", caminho);
+        liberarFila(fila);
+        liberarPilha(pilha);
+        sessoesDestruir(&g);
+        return false;
+    }
+    memcpy(fila->itens, filaMapeada.itens, (size_t)fila->capacidade * sizeof(Peca));
+    memcpy(pilha->itens, pilhaMapeada.itens, (size_t)pilha->capacidade * sizeof(Peca));
+    sessoesDestruir(&g);
+
+    MENSAGEM("Sessao restaurada de '%s' (semente: %llu).\n",
+             caminho, (unsigned long long)fila->gerador.semente);
+    return true;
+}
@@ -0,0 +1,74 @@
+#ifndef INSTANTANEO_H
+#define INSTANTANEO_H
+
+// Instantâneo binário do estado completo de uma ou de várias sessões.
+//
+// O formato tem layout fixo e versionado, no mesmo arranjo SoA do
+// GerenciadorSessoes: um cabeçalho com a posição de cada seção no arquivo e,
+// alinhada a 64 bytes, uma seção por vetor (peças das filas, peças das
+// pilhas, frente, tras, contador, proximoId, topo e geradores). Uma sessão
+// avulsa (FilaPecas + PilhaPecas) é gravada como um instantâneo de 1 sessão.
+//
+// A restauração mapeia o arquivo com mmap (MAP_PRIVATE) e aponta os vetores
+// do gerenciador direto para as seções mapeadas, sem copiar nem reexecutar
+// ações: as páginas só são lidas quando as sessões são usadas e as
+// alterações posteriores não voltam para o arquivo.
+//
+// O instantâneo é gravado em '<arquivo>.tmp' e renomeado ao final, então um
+// arquivo existente nunca fica pela metade.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tetris_stack_mestre.h"
+#include "sessoes.h"
+
+// --- Constantes ---
+#define INSTANTANEO_MAGICA "TTRSINST"
+#define INSTANTANEO_VERSAO 1
+#define INSTANTANEO_ORDEM_BYTES 0x01020304u // Detecta arquivos de outra arquitetura
+#define INSTANTANEO_ALINHAMENTO 64          // Alinhamento das seções, em bytes
+
+// Seções do arquivo, na ordem em que aparecem
+enum {
+    INSTANTANEO_ITENS_FILA,
+    INSTANTANEO_ITENS_PILHA,
+    INSTANTANEO_FRENTE,
+    INSTANTANEO_TRAS,
+    INSTANTANEO_CONTADOR,
+    INSTANTANEO_PROXIMO_ID,
+    INSTANTANEO_TOPO,
+    INSTANTANEO_GERADORES,
+    INSTANTANEO_NUM_SECOES
+};
+
+// --- Estrutura de Dados ---
+
+typedef struct {
+    char magica[8];            // INSTANTANEO_MAGICA (sem o '\0')
+    uint32_t versao;           // INSTANTANEO_VERSAO
+    uint32_t ordemBytes;       // INSTANTANEO_ORDEM_BYTES
+    uint32_t tamanhoPeca;      // sizeof(Peca)
+    uint32_t tamanhoGerador;   // sizeof(GeradorPecas)
+    int32_t numSessoes;
+    int32_t capacidadeFila;
+    int32_t capacidadePilha;
+    int32_t tamanhoTroca;
+    uint64_t secoes[INSTANTANEO_NUM_SECOES]; // Deslocamento de cada seção no arquivo
+    uint64_t tamanhoArquivo;
+    uint8_t reservado[16];
+} CabecalhoInstantaneo;
+
+_Static_assert(sizeof(CabecalhoInstantaneo) == 128, "cabecalho do instantaneo deve ter 128 bytes");
+
+// --- Protótipos das Funções ---
+
+// Várias sessões (GerenciadorSessoes)
+bool instantaneoSalvarSessoes(const GerenciadorSessoes *g, const char *caminho);
+bool instantaneoRestaurarSessoes(GerenciadorSessoes *g, const char *caminho);
+
+// Sessão avulsa (FilaPecas + PilhaPecas)
+bool instantaneoSalvar(const FilaPecas *fila, const PilhaPecas *pilha, const char *caminho);
+bool instantaneoRestaurar(FilaPecas *fila, PilhaPecas *pilha, const char *caminho);
+
+#endif // INSTANTANEO_H
@@ -0,0 +1,420 @@
+#define _POSIX_C_SOURCE 200809L // pthread_barrier_t
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "jogador_automatico.h"
+#include "peca_compacta.h"
+#include "../Comum/anel_circular.h"
+
+// --- Constantes ---
+
+// Pesos da avaliação do tabuleiro (soma das alturas, buracos, irregularidade
+// entre colunas vizinhas e linhas eliminadas no caminho)
+#define PESO_ALTURA (-0.51f)
+#define PESO_BURACOS (-0.36f)
+#define PESO_IRREGULARIDADE (-0.18f)
+#define PESO_LINHAS 0.76f
+#define NOTA_FIM_PARTIDA (-1e9f)
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Nota do tabuleiro (quanto maior, melhor).
+ * * Os buracos saem da diferença entre a soma das alturas e o número de
+ * células ocupadas, que o tabuleiro já mantém.
+ */
+static float avaliarTabuleiro(const Tabuleiro *tabuleiro) {
+    int somaAlturas = 0, irregularidade = 0;
+
+    for (int c = 0; c < TABULEIRO_LARGURA; c++) {
+        somaAlturas += tabuleiro->alturas[c];
+        if (c > 0) irregularidade += abs(tabuleiro->alturas[c] - tabuleiro->alturas[c - 1]);
+    }
+
+    return PESO_ALTURA * (float)somaAlturas + PESO_BURACOS * (float)(somaAlturas - tabuleiro->celulas)
+         + PESO_IRREGULARIDADE * (float)irregularidade;
+}
+
+/**
+ * @brief Ordem dos nós: maior nota primeiro e, no empate, menor chave.
+ */
+static int compararNos(const NoBusca *x, const NoBusca *y) {
+    if (x->nota != y->nota) return x->nota > y->nota ? -1 : 1;
+    return (x->chave > y->chave) - (x->chave < y->chave);
+}
+
+static int compararOrdem(const void *a, const void *b) {
+    const OrdemFilho *x = a, *y = b;
+    if (x->nota != y->nota) return x->nota > y->nota ? -1 : 1;
+    return (x->chave > y->chave) - (x->chave < y->chave);
+}
+
+/**
+ * @brief Deixa nas k primeiras posições os k melhores filhos (em qualquer
+ * ordem), particionando em torno de um pivô só do lado que contém a posição k.
+ */
+static void separarMelhores(OrdemFilho *ordem, int n, int k) {
+    int esquerda = 0, direita = n - 1;
+
+    while (esquerda < direita) {
+        OrdemFilho pivo = ordem[esquerda + (direita - esquerda) / 2];
+        int i = esquerda, j = direita;
+        while (i <= j) {
+            while (compararOrdem(&ordem[i], &pivo) < 0) i++;
+            while (compararOrdem(&ordem[j], &pivo) > 0) j--;
+            if (i <= j) {
+                OrdemFilho temp = ordem[i];
+                ordem[i++] = ordem[j];
+                ordem[j--] = temp;
+            }
+        }
+        if (k - 1 <= j) {
+            direita = j;
+        } else if (k - 1 >= i) {
+            esquerda = i;
+        } else {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Gera o filho do nó 'pai' que joga a peça 'tipo' na rotação e coluna dadas.
+ * * O fim de partida passa para os descendentes: o tabuleiro recomeça vazio
+ * depois dele, e sem isso os filhos voltariam a ter uma nota boa.
+ */
+static void gerarFilhoJogada(const NoBusca *pai, NoBusca *filho, int tipo, int rotacao, int coluna,
+                             int topoPilha, int acao, bool primeiroNivel) {
+    *filho = *pai;
+    JogadaTabuleiro jogada = tabuleiroColocar(&filho->tabuleiro, tipo, rotacao, coluna);
+    filho->linhas += jogada.eliminadas;
+    filho->topoPilha = (int8_t)topoPilha;
+    filho->fimPartida = pai->fimPartida || jogada.fimPartida;
+    filho->nota = filho->fimPartida ? NOTA_FIM_PARTIDA
+                                    : avaliarTabuleiro(&filho->tabuleiro) + PESO_LINHAS * (float)filho->linhas;
+    if (primeiroNivel) {
+        filho->acao = (uint8_t)acao;
+        filho->rotacao = (uint8_t)rotacao;
+        filho->coluna = (uint8_t)coluna;
+    }
+}
+
+/**
+ * @brief Expande a parte do feixe que cabe à thread 'indice' e deixa na sua
+ * área os 'largura' melhores filhos, já ordenados.
+ */
+static void expandirParte(JogadorAutomatico *jogador, int indice) {
+    AreaBusca *area = &jogador->areas[indice];
+    int inicio = (int)((long long)jogador->numFeixe * indice / jogador->numThreads);
+    int fim = (int)((long long)jogador->numFeixe * (indice + 1) / jogador->numThreads);
+    int tipo = jogador->tipoDaVez;
+    bool primeiro = jogador->primeiroNivel;
+    int n = 0;
+
+    for (int i = inicio; i < fim; i++) {
+        const NoBusca *pai = &jogador->feixe[i];
+        int chave = i * JOGADOR_MAX_FILHOS;
+
+        // Ação 1: a peça da vez, em todas as posições
+        for (int rotacao = 0; rotacao < tabuleiroNumRotacoes(tipo); rotacao++) {
+            int ultimaColuna = TABULEIRO_LARGURA - tabuleiroForma(tipo, rotacao)->largura;
+            for (int coluna = 0; coluna <= ultimaColuna; coluna++) {
+                gerarFilhoJogada(pai, &area->filhos[n], tipo, rotacao, coluna, pai->topoPilha, 1, primeiro);
+                area->filhos[n++].chave = chave++;
+            }
+        }
+
+        // Ações 4 e 1: troca com o topo da pilha e joga a peça que estava lá
+        int topo = pai->topoPilha;
+        if (topo >= 0 && topo != tipo) {
+            for (int rotacao = 0; rotacao < tabuleiroNumRotacoes(topo); rotacao++) {
+                int ultimaColuna = TABULEIRO_LARGURA - tabuleiroForma(topo, rotacao)->largura;
+                for (int coluna = 0; coluna <= ultimaColuna; coluna++) {
+                    gerarFilhoJogada(pai, &area->filhos[n], topo, rotacao, coluna, tipo, 4, primeiro);
+                    area->filhos[n++].chave = chave++;
+                }
+            }
+        }
+
+        // Ação 2: guarda a peça da vez na pilha vazia
+        if (topo < 0) {
+            NoBusca *filho = &area->filhos[n++];
+            *filho = *pai;
+            filho->topoPilha = (int8_t)tipo;
+            filho->chave = chave++;
+            if (primeiro) {
+                filho->acao = 2;
+                filho->rotacao = filho->coluna = 0;
+            }
+        }
+    }
+
+    // Seleciona e ordena só (nota, chave, índice), e copia os melhores nós
+    for (int i = 0; i < n; i++) {
+        area->ordem[i] = (OrdemFilho){area->filhos[i].nota, area->filhos[i].chave, i};
+    }
+    area->numMelhores = n < jogador->largura ? n : jogador->largura;
+    separarMelhores(area->ordem, n, area->numMelhores);
+    qsort(area->ordem, (size_t)area->numMelhores, sizeof(OrdemFilho), compararOrdem);
+    for (int i = 0; i < area->numMelhores; i++) area->melhores[i] = area->filhos[area->ordem[i].indice];
+    area->avaliados += n;
+}
+
+/**
+ * @brief Junta os melhores filhos de todas as áreas no próximo nível do feixe.
+ */
+static void juntarAreas(JogadorAutomatico *jogador) {
+    int posicao[JOGADOR_MAX_THREADS] = {0};
+    int n = 0;
+
+    while (n < jogador->largura) {
+        int escolhida = -1;
+        for (int t = 0; t < jogador->numThreads; t++) {
+            const AreaBusca *area = &jogador->areas[t];
+            if (posicao[t] == area->numMelhores) continue;
+            if (escolhida < 0 ||
+                compararNos(&area->melhores[posicao[t]], &jogador->areas[escolhida].melhores[posicao[escolhida]]) < 0) {
+                escolhida = t;
+            }
+        }
+        if (escolhida < 0) break;
+        jogador->proximo[n] = jogador->areas[escolhida].melhores[posicao[escolhida]++];
+        jogador->proximo[n].chave = n;
+        n++;
+    }
+
+    NoBusca *temp = jogador->feixe;
+    jogador->feixe = jogador->proximo;
+    jogador->proximo = temp;
+    jogador->numFeixe = n;
+}
+
+/**
+ * @brief Laço das threads auxiliares: espera um nível, expande a sua parte e
+ * avisa que terminou.
+ */
+static void *trabalhadorBusca(void *arg) {
+    AreaBusca *area = arg;
+    JogadorAutomatico *jogador = area->dono;
+
+    // Espera a criação das outras auxiliares; se alguma falhou, sai sem usar as barreiras
+    pthread_mutex_lock(&jogador->partida);
+    bool desistir = jogador->encerrar;
+    pthread_mutex_unlock(&jogador->partida);
+    if (desistir) return NULL;
+
+    for (;;) {
+        pthread_barrier_wait(&jogador->inicio);
+        if (jogador->encerrar) break;
+        expandirParte(jogador, area->indice);
+        pthread_barrier_wait(&jogador->fim);
+    }
+    return NULL;
+}
+
+// --- Criação e Destruição ---
+
+/**
+ * @brief Cria as barreiras e as numThreads - 1 threads auxiliares.
+ * * As auxiliares só chegam às barreiras depois que todas foram criadas: se
+ * uma criação falhar, as já criadas saem pela trava de partida, sem ficar
+ * presas em uma barreira que nunca completa.
+ * @return false em caso de erro (jogador->threads volta a NULL).
+ */
+static bool iniciarThreads(JogadorAutomatico *jogador) {
+    int numThreads = jogador->numThreads;
+    jogador->threads = malloc((size_t)numThreads * sizeof(pthread_t));
+    if (jogador->threads == NULL) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para o jogador automatico.\n");
+        return false;
+    }
+
+    bool ok = false;
+    if (pthread_mutex_init(&jogador->partida, NULL) == 0) {
+        if (pthread_barrier_init(&jogador->inicio, NULL, (unsigned)numThreads) == 0) {
+            if (pthread_barrier_init(&jogador->fim, NULL, (unsigned)numThreads) == 0) {
+                pthread_mutex_lock(&jogador->partida);
+                int criadas = 1;
+                while (criadas < numThreads &&
+                       pthread_create(&jogador->threads[criadas], NULL, trabalhadorBusca, &jogador->areas[criadas]) == 0) {
+                    criadas++;
+                }
+                ok = criadas == numThreads;
+                jogador->encerrar = !ok;
+                pthread_mutex_unlock(&jogador->partida);
+
+                if (ok) return true;
+                for (int t = 1; t < criadas; t++) pthread_join(jogador->threads[t], NULL);
+                jogador->encerrar = false;
+                pthread_barrier_destroy(&jogador->fim);
+            }
+            pthread_barrier_destroy(&jogador->inicio);
+        }
+        pthread_mutex_destroy(&jogador->partida);
+    }
+
+    fprintf(stderr, "ERRO: Nao foi possivel iniciar %d threads de busca.\n", numThreads);
+    free(jogador->threads);
+    jogador->threads = NULL;
+    return false;
+}
+
+/**
+ * @brief Aloca o feixe e as áreas de rascunho e inicia numThreads - 1 threads auxiliares.
+ * @param tempoJogada Tempo máximo por jogada, em segundos (0 = percorre toda a fila).
+ * @return false se os parâmetros forem inválidos ou faltar memória.
+ */
+bool jogadorCriar(JogadorAutomatico *jogador, int largura, int numThreads, double tempoJogada) {
+    memset(jogador, 0, sizeof(*jogador));
+    if (largura <= 0 || numThreads <= 0 || numThreads > JOGADOR_MAX_THREADS) {
+        fprintf(stderr, "ERRO: Jogador automatico precisa de feixe > 0 e de 1 a %d threads.\n", JOGADOR_MAX_THREADS);
+        return false;
+    }
+    jogador->largura = largura;
+    jogador->numThreads = numThreads;
+    jogador->tempoJogada = tempoJogada;
+    jogador->capacidadeArea = ((largura + numThreads - 1) / numThreads) * JOGADOR_MAX_FILHOS;
+
+    jogador->feixe = malloc((size_t)largura * sizeof(NoBusca));
+    jogador->proximo = malloc((size_t)largura * sizeof(NoBusca));
+    jogador->areas = aligned_alloc(64, (size_t)numThreads * sizeof(AreaBusca));
+    if (jogador->feixe == NULL || jogador->proximo == NULL || jogador->areas == NULL) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para o jogador automatico.\n");
+        jogadorDestruir(jogador);
+        return false;
+    }
+    memset(jogador->areas, 0, (size_t)numThreads * sizeof(AreaBusca));
+    for (int t = 0; t < numThreads; t++) {
+        AreaBusca *area = &jogador->areas[t];
+        area->indice = t;
+        area->dono = jogador;
+        area->filhos = malloc((size_t)jogador->capacidadeArea * sizeof(NoBusca));
+        area->ordem = malloc((size_t)jogador->capacidadeArea * sizeof(OrdemFilho));
+        area->melhores = malloc((size_t)largura * sizeof(NoBusca));
+        if (area->filhos == NULL || area->ordem == NULL || area->melhores == NULL) {
+            fprintf(stderr, "ERRO: Memoria insuficiente para o jogador automatico.\n");
+            jogadorDestruir(jogador);
+            return false;
+        }
+    }
+
+    if (numThreads > 1 && !iniciarThreads(jogador)) {
+        jogadorDestruir(jogador);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Encerra as threads auxiliares (se houver) e libera toda a memória.
+ */
+void jogadorDestruir(JogadorAutomatico *jogador) {
+    if (jogador->threads != NULL) {
+        jogador->encerrar = true;
+        pthread_barrier_wait(&jogador->inicio);
+        for (int t = 1; t < jogador->numThreads; t++) pthread_join(jogador->threads[t], NULL);
+        pthread_barrier_destroy(&jogador->inicio);
+        pthread_barrier_destroy(&jogador->fim);
+        pthread_mutex_destroy(&jogador->partida);
+        free(jogador->threads);
+    }
+    if (jogador->areas != NULL) {
+        for (int t = 0; t < jogador->numThreads; t++) {
+            free(jogador->areas[t].filhos);
+            free(jogador->areas[t].ordem);
+            free(jogador->areas[t].melhores);
+        }
+    }
+    free(jogador->areas);
+    free(jogador->feixe);
+    free(jogador->proximo);
+    memset(jogador, 0, sizeof(*jogador));
+}
+
+// --- Jogadas ---
+
+/**
+ * @brief Busca e executa a próxima jogada na sessão (a fila precisa de um tabuleiro).
+ * @return Número de ações executadas (0 se não houver peça ou tabuleiro).
+ */
+int jogadorJogar(JogadorAutomatico *jogador, FilaPecas *fila, PilhaPecas *pilha) {
+    if (fila->tabuleiro == NULL || estaVaziaFila(fila)) return 0;
+
+    NoBusca *raiz = &jogador->feixe[0];
+    memset(raiz, 0, sizeof(*raiz));
+    raiz->tabuleiro = *fila->tabuleiro;
+    raiz->topoPilha = (int8_t)(estaVaziaPilha(pilha) ? -1 : indiceTipoPeca(pilha->itens[pilha->topo].nome));
+    raiz->acao = 1;
+    jogador->numFeixe = 1;
+
+    double inicio = tempoAtual();
+    for (int nivel = 0; nivel < fila->contador; nivel++) {
+        Peca peca = fila->itens[ANEL_INDICE_DINAMICO(fila->frente, nivel, fila->capacidade)];
+        jogador->tipoDaVez = indiceTipoPeca(peca.nome);
+        jogador->primeiroNivel = nivel == 0;
+
+        if (jogador->numThreads > 1) {
+            pthread_barrier_wait(&jogador->inicio);
+            expandirParte(jogador, 0);
+            pthread_barrier_wait(&jogador->fim);
+        } else {
+            expandirParte(jogador, 0);
+        }
+        juntarAreas(jogador);
+        jogador->niveis++;
+
+        // O primeiro nível sempre é completado, para que haja uma jogada
+        if (jogador->tempoJogada > 0 && tempoAtual() - inicio >= jogador->tempoJogada) break;
+    }
+    jogador->jogadas++;
+
+    // Executa a primeira jogada do melhor caminho
+    const NoBusca *melhor = &jogador->feixe[0];
+    int acoes = 0;
+    if (melhor->acao == 2) return executarAcao(fila, pilha, 2) ? 1 : 0;
+    if (melhor->acao == 4 && executarAcao(fila, pilha, 4)) acoes++;
+    tabuleiroPedirPosicao(fila->tabuleiro, melhor->rotacao, melhor->coluna);
+    if (executarAcao(fila, pilha, 1)) acoes++;
+    return acoes;
+}
+
+long long jogadorAvaliados(const JogadorAutomatico *jogador) {
+    long long total = 0;
+    for (int t = 0; t < jogador->numThreads; t++) total += jogador->areas[t].avaliados;
+    return total;
+}
+
+// --- Modo Jogador Automático (--jogador) ---
+
+/**
+ * @brief Joga numJogadas jogadas sem impressão e exibe o estado e a vazão.
+ * @return 0 em caso de sucesso, 1 se o jogador não pôde ser criado.
+ */
+int executarJogador(FilaPecas *fila, PilhaPecas *pilha, long long numJogadas,
+                    int largura, int numThreads, double tempoJogada) {
+    JogadorAutomatico jogador;
+    if (!jogadorCriar(&jogador, largura, numThreads, tempoJogada)) return 1;
+
+    modoSilencioso = true;
+    long long acoes = 0;
+    double inicio = tempoAtual();
+    for (long long i = 0; i < numJogadas; i++) acoes += jogadorJogar(&jogador, fila, pilha);
+    double decorrido = tempoAtual() - inicio;
+    modoSilencioso = false;
+
+    long long avaliados = jogadorAvaliados(&jogador);
+    exibirEstadoAtual(fila, pilha);
+    printf("Jogador automatico: %lld jogadas (%lld acoes) | Feixe: %d | Threads: %d\n",
+           jogador.jogadas, acoes, largura, numThreads);
+    printf("Profundidade media: %.2f pecas | Nos avaliados: %lld (%.0f nos/s)\n",
+           jogador.jogadas > 0 ? (double)jogador.niveis / (double)jogador.jogadas : 0.0,
+           avaliados, decorrido > 0 ? (double)avaliados / decorrido : 0.0);
+    printf("Semente: %llu\n", (unsigned long long)fila->gerador.semente);
+    printf("Tempo: %.6f s | Taxa: %.0f jogadas/s\n",
+           decorrido, decorrido > 0 ? (double)jogador.jogadas / decorrido : 0.0);
+
+    jogadorDestruir(&jogador);
+    return 0;
+}
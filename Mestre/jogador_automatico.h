@@ -0,0 +1,99 @@
+#ifndef JOGADOR_AUTOMATICO_H
+#define JOGADOR_AUTOMATICO_H
+
+// Jogador automático do simulador Mestre (usa o tabuleiro de tabuleiro.h).
+//
+// A cada jogada, uma busca em feixe (beam search) percorre as peças visíveis
+// da fila, uma por nível. Em cada nível a peça da vez pode ser:
+//   - jogada (ação 1) em qualquer rotação e coluna;
+//   - trocada com a do topo da pilha e esta jogada (ações 4 e 1);
+//   - reservada na pilha vazia, sem jogar nada (ação 2).
+// Só o topo da pilha entra no estado da busca. Cada nó guarda a primeira
+// jogada do caminho que levou até ele; ao fim da busca (ou do tempo da
+// jogada) o jogador executa a primeira jogada do melhor nó.
+//
+// Os nós de cada nível são divididos entre as threads, e cada uma expande
+// a sua parte em uma área de rascunho própria, alocada uma única vez, e
+// devolve só os seus 'largura' melhores filhos; a thread que chamou junta
+// esses resultados. A ordem dos nós não depende do número de threads.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#include "tetris_stack_mestre.h"
+#include "tabuleiro.h"
+
+// --- Constantes ---
+#define JOGADOR_LARGURA_PADRAO 64     // Nós mantidos por nível (--feixe)
+#define JOGADOR_MAX_THREADS 256
+#define JOGADOR_MAX_FILHOS (2 * 34 + 1) // Jogar a peça da vez ou a do topo (34 posições cada) + reservar
+
+// --- Estruturas de Dados ---
+
+// Nó da busca: tabuleiro depois das peças já colocadas no caminho
+typedef struct {
+    Tabuleiro tabuleiro;
+    float nota;          // Avaliação do tabuleiro + linhas eliminadas no caminho
+    int linhas;          // Linhas eliminadas no caminho
+    int chave;           // Ordem do nó no nível (desempate determinístico)
+    int8_t topoPilha;    // Tipo do topo da pilha, ou -1 se vazia
+    uint8_t acao;        // Primeira jogada do caminho: 1, 2 ou 4
+    uint8_t rotacao;
+    uint8_t coluna;
+    bool fimPartida;     // O caminho já perdeu a partida (a nota fica em NOTA_FIM_PARTIDA)
+} NoBusca;
+
+// Entrada da ordenação dos filhos (ordena-se isto, não os nós inteiros)
+typedef struct {
+    float nota;
+    int chave;
+    int indice; // Posição do filho na área
+} OrdemFilho;
+
+struct JogadorAutomatico;
+
+// Área de rascunho de uma thread (filhos gerados no nível atual), alinhada à linha de cache
+typedef struct {
+    _Alignas(64) NoBusca *filhos; // Todos os filhos gerados no nível
+    OrdemFilho *ordem;
+    NoBusca *melhores;            // Os 'largura' melhores, em ordem
+    int numMelhores;
+    int indice;          // Thread dona da área (0 = a que chama jogadorJogar)
+    long long avaliados; // Filhos avaliados desde o início
+    struct JogadorAutomatico *dono;
+} AreaBusca;
+
+typedef struct JogadorAutomatico {
+    int largura;          // Nós por nível
+    int numThreads;       // Threads da busca (incluindo a que chama jogadorJogar)
+    double tempoJogada;   // Tempo máximo por jogada, em segundos (0 = sem limite)
+    NoBusca *feixe;       // Nós do nível atual
+    NoBusca *proximo;     // Nós do nível seguinte
+    int numFeixe;
+    AreaBusca *areas;     // Uma por thread
+    int capacidadeArea;   // Filhos por área
+
+    // Nível sendo expandido (lido pelas threads entre as duas barreiras)
+    int tipoDaVez;
+    bool primeiroNivel;
+    bool encerrar;
+    pthread_mutex_t partida; // Segura as auxiliares até todas terem sido criadas
+    pthread_barrier_t inicio;
+    pthread_barrier_t fim;
+    pthread_t *threads;
+
+    long long jogadas;    // Jogadas decididas
+    long long niveis;     // Níveis completos buscados (soma de todas as jogadas)
+} JogadorAutomatico;
+
+// --- Protótipos das Funções ---
+
+bool jogadorCriar(JogadorAutomatico *jogador, int largura, int numThreads, double tempoJogada);
+void jogadorDestruir(JogadorAutomatico *jogador);
+int jogadorJogar(JogadorAutomatico *jogador, FilaPecas *fila, PilhaPecas *pilha);
+long long jogadorAvaliados(const JogadorAutomatico *jogador);
+int executarJogador(FilaPecas *fila, PilhaPecas *pilha, long long numJogadas,
+                    int largura, int numThreads, double tempoJogada);
+
+#endif // JOGADOR_AUTOMATICO_H
@@ -0,0 +1,225 @@
+#ifndef PECA_COMPACTA_H
+#define PECA_COMPACTA_H
+
+// Representações compactas de peças.
+//
+// PecaCompacta: uma peça em 32 bits (a Peca ocupa 8 bytes com o padding):
+//   bits 0-1  -> índice do tipo em TIPOS_PECA ('I', 'O', 'T', 'L')
+//   bits 2-31 -> id (0 a PECA_COMPACTA_ID_MAX)
+// A "peça vazia" {'\0', -1} devolvida por dequeue/pop é PECA_COMPACTA_VAZIA.
+//
+// FilaTipos: fila circular que guarda só a sequência de tipos, 2 bits por
+// peça (32 peças por palavra de 64 bits). Os ids são implícitos e
+// sequenciais a partir de idFrente, como na saída do gerador; serve para
+// filas de antevisão muito longas.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "tetris_stack_mestre.h"
+
+// --- Constantes ---
+#define PECA_COMPACTA_BITS_TIPO GERADOR_BITS_TIPO
+#define PECA_COMPACTA_MASCARA_TIPO ((1u << PECA_COMPACTA_BITS_TIPO) - 1u)
+#define PECA_COMPACTA_ID_MAX ((int)(UINT32_MAX >> PECA_COMPACTA_BITS_TIPO) - 1)
+#define PECA_COMPACTA_VAZIA UINT32_MAX
+
+#define FILA_TIPOS_POR_PALAVRA GERADOR_TIPOS_POR_SAIDA // 32 tipos por uint64_t
+
+// --- Estruturas de Dados ---
+
+typedef uint32_t PecaCompacta;
+
+typedef struct {
+    uint64_t *palavras; // Tipos empacotados, 2 bits cada
+    int64_t capacidade; // Capacidade em peças (múltiplo de 32)
+    int64_t frente;     // Posição (em peças) da frente
+    int64_t contador;   // Número atual de peças
+    int idFrente;       // Id da peça da frente; as seguintes têm ids consecutivos
+} FilaTipos;
+
+// --- Conversão Peca <-> índice de tipo ---
+
+/**
+ * @brief Índice do tipo em TIPOS_PECA, ou -1 se o nome não for um tipo válido.
+ */
+static inline int indiceTipoPeca(char nome) {
+    switch (nome) {
+        case 'I': return 0;
+        case 'O': return 1;
+        case 'T': return 2;
+        case 'L': return 3;
+        default:  return -1;
+    }
+}
+
+// --- PecaCompacta ---
+
+/**
+ * @brief Converte uma Peca em PecaCompacta (peças inválidas viram PECA_COMPACTA_VAZIA).
+ */
+static inline PecaCompacta compactarPeca(Peca peca) {
+    int tipo = indiceTipoPeca(peca.nome);
+    if (tipo < 0 || peca.id < 0 || peca.id > PECA_COMPACTA_ID_MAX) return PECA_COMPACTA_VAZIA;
+    return ((uint32_t)peca.id << PECA_COMPACTA_BITS_TIPO) | (uint32_t)tipo;
+}
+
+static inline Peca expandirPeca(PecaCompacta compacta) {
+    Peca peca = {'\0', -1};
+    if (compacta == PECA_COMPACTA_VAZIA) return peca;
+    peca.nome = TIPOS_PECA[compacta & PECA_COMPACTA_MASCARA_TIPO];
+    peca.id = (int)(compacta >> PECA_COMPACTA_BITS_TIPO);
+    return peca;
+}
+
+static inline int tipoPecaCompacta(PecaCompacta compacta) {
+    return (int)(compacta & PECA_COMPACTA_MASCARA_TIPO);
+}
+
+static inline int idPecaCompacta(PecaCompacta compacta) {
+    return compacta == PECA_COMPACTA_VAZIA ? -1 : (int)(compacta >> PECA_COMPACTA_BITS_TIPO);
+}
+
+// --- FilaTipos (2 bits por peça) ---
+
+/**
+ * @brief Aloca uma fila de tipos vazia (capacidade arredondada para múltiplo de 32).
+ * @return false se a capacidade for inválida ou faltar memória.
+ */
+static inline bool filaTiposInicializar(FilaTipos *fila, int64_t capacidade, int idFrente) {
+    int64_t palavras = (capacidade + FILA_TIPOS_POR_PALAVRA - 1) / FILA_TIPOS_POR_PALAVRA;
+    fila->palavras = capacidade > 0 ? calloc((size_t)palavras, sizeof(uint64_t)) : NULL;
+    fila->capacidade = palavras * FILA_TIPOS_POR_PALAVRA;
+    fila->frente = 0;
+    fila->contador = 0;
+    fila->idFrente = idFrente;
+    return fila->palavras != NULL;
+}
+
+static inline void filaTiposLiberar(FilaTipos *fila) {
+    free(fila->palavras);
+    fila->palavras = NULL;
+    fila->capacidade = fila->contador = 0;
+}
+
+static inline bool filaTiposCheia(const FilaTipos *fila) { return fila->contador == fila->capacidade; }
+static inline bool filaTiposVazia(const FilaTipos *fila) { return fila->contador == 0; }
+
+static inline int filaTiposLer(const FilaTipos *fila, int64_t posicao) {
+    return (int)((fila->palavras[posicao / FILA_TIPOS_POR_PALAVRA]
+                  >> (PECA_COMPACTA_BITS_TIPO * (posicao % FILA_TIPOS_POR_PALAVRA))) & PECA_COMPACTA_MASCARA_TIPO);
+}
+
+static inline void filaTiposEscrever(FilaTipos *fila, int64_t posicao, int tipo) {
+    uint64_t *palavra = &fila->palavras[posicao / FILA_TIPOS_POR_PALAVRA];
+    int deslocamento = PECA_COMPACTA_BITS_TIPO * (int)(posicao % FILA_TIPOS_POR_PALAVRA);
+    *palavra = (*palavra & ~((uint64_t)PECA_COMPACTA_MASCARA_TIPO << deslocamento))
+             | ((uint64_t)tipo << deslocamento);
+}
+
+/**
+ * @brief Posição física da i-ésima peça a partir da frente (0 <= i < capacidade).
+ */
+static inline int64_t filaTiposPosicao(const FilaTipos *fila, int64_t i) {
+    int64_t posicao = fila->frente + i;
+    return posicao >= fila->capacidade ? posicao - fila->capacidade : posicao;
+}
+
+static inline bool filaTiposInserir(FilaTipos *fila, int tipo) {
+    if (filaTiposCheia(fila)) return false;
+    filaTiposEscrever(fila, filaTiposPosicao(fila, fila->contador), tipo);
+    fila->contador++;
+    return true;
+}
+
+/**
+ * @brief Remove o tipo da frente (-1 se a fila estiver vazia).
+ */
+static inline int filaTiposRemover(FilaTipos *fila) {
+    if (filaTiposVazia(fila)) return -1;
+    int tipo = filaTiposLer(fila, fila->frente);
+    fila->frente = filaTiposPosicao(fila, 1);
+    fila->contador--;
+    fila->idFrente++;
+    return tipo;
+}
+
+/**
+ * @brief Tipo da i-ésima peça a partir da frente, sem remover (-1 se não existir).
+ */
+static inline int filaTiposEspiar(const FilaTipos *fila, int64_t i) {
+    if (i < 0 || i >= fila->contador) return -1;
+    return filaTiposLer(fila, filaTiposPosicao(fila, i));
+}
+
+/**
+ * @brief Completa a fila com tipos do gerador, na mesma ordem de gerarPeca.
+ * * Com a reserva do gerador vazia, cada saída de 64 bits é gravada inteira
+ * (32 peças por vez), dividida entre duas palavras se o final da fila não
+ * estiver alinhado.
+ */
+static inline void filaTiposPreencher(FilaTipos *fila, GeradorPecas *gerador) {
+    int64_t numPalavras = fila->capacidade / FILA_TIPOS_POR_PALAVRA;
+
+    while (!filaTiposCheia(fila)) {
+        if (gerador->tiposRestantes > 0 || fila->capacidade - fila->contador < FILA_TIPOS_POR_PALAVRA) {
+            filaTiposInserir(fila, geradorSortearTipo(gerador));
+            continue;
+        }
+
+        int64_t fim = filaTiposPosicao(fila, fila->contador);
+        int64_t indice = fim / FILA_TIPOS_POR_PALAVRA;
+        int deslocamento = PECA_COMPACTA_BITS_TIPO * (int)(fim % FILA_TIPOS_POR_PALAVRA);
+        uint64_t saida = geradorProximo64(gerador);
+
+        if (deslocamento == 0) {
+            fila->palavras[indice] = saida;
+        } else {
+            uint64_t baixos = (UINT64_C(1) << deslocamento) - 1;
+            int64_t seguinte = indice + 1 == numPalavras ? 0 : indice + 1;
+            fila->palavras[indice] = (fila->palavras[indice] & baixos) | (saida << deslocamento);
+            fila->palavras[seguinte] = (fila->palavras[seguinte] & ~baixos) | (saida >> (64 - deslocamento));
+        }
+        fila->contador += FILA_TIPOS_POR_PALAVRA;
+    }
+}
+
+// --- Conversão com Peca ---
+
+/**
+ * @brief Insere uma Peca pelo tipo; o id é implícito (idFrente + posição).
+ * @return false se a fila estiver cheia ou a peça for inválida.
+ */
+static inline bool filaTiposInserirPeca(FilaTipos *fila, Peca peca) {
+    int tipo = indiceTipoPeca(peca.nome);
+    return tipo >= 0 && filaTiposInserir(fila, tipo);
+}
+
+/**
+ * @brief Remove a peça da frente como Peca (peça vazia {'\0', -1} se não houver).
+ */
+static inline Peca filaTiposRemoverPeca(FilaTipos *fila) {
+    Peca peca = {'\0', -1};
+    int id = fila->idFrente;
+    int tipo = filaTiposRemover(fila);
+    if (tipo < 0) return peca;
+    peca.nome = TIPOS_PECA[tipo];
+    peca.id = id;
+    return peca;
+}
+
+/**
+ * @brief Copia as n primeiras peças (a partir da frente) para um vetor de Peca.
+ * @return Número de peças copiadas.
+ */
+static inline int64_t filaTiposCopiarPecas(const FilaTipos *fila, Peca *destino, int64_t n) {
+    if (n > fila->contador) n = fila->contador;
+    for (int64_t i = 0; i < n; i++) {
+        destino[i].nome = TIPOS_PECA[filaTiposLer(fila, filaTiposPosicao(fila, i))];
+        destino[i].id = fila->idFrente + (int)i;
+    }
+    return n;
+}
+
+#endif // PECA_COMPACTA_H
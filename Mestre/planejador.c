@@ -0,0 +1,493 @@
+#include <ctype.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "planejador.h"
+#include "peca_compacta.h"
+#include "../Comum/anel_circular.h"
+
+// --- Constantes ---
+#define SEMENTE_ZOBRIST 0x5A0B2157ULL // Chaves fixas: a mesma tabela serve a qualquer sessão
+#define BITS_RESTANTE 8               // Profundidade restante nos dados de uma posição da tabela
+#define MASCARA_GERACAO 0xFFFFFFu     // Gerações de 24 bits (0 nunca é usada)
+
+// --- Estruturas Internas ---
+
+// Estado da busca: tipos nas posições físicas da fila e da pilha, e as
+// mesmas posições como máscaras por tipo (para o limite inferior)
+typedef struct {
+    uint8_t fila[PLANEJADOR_MAX_FILA];
+    uint8_t pilha[PLANEJADOR_MAX_PILHA];
+    uint64_t naFila[GERADOR_NUM_TIPOS + 1];  // Bit j: a peça j posições atrás da frente é do tipo
+    uint16_t naPilha[GERADOR_NUM_TIPOS + 1]; // Bit i: a posição i da pilha é do tipo
+    int frente;
+    int topo;       // -1 para pilha vazia
+    int progresso;  // Peças da ordem já jogadas
+    uint64_t chave; // Chave Zobrist do estado
+} EstadoPlano;
+
+// Dados fixos de uma consulta
+typedef struct {
+    Planejador *planejador;
+    uint8_t ordem[PLANEJADOR_MAX_ORDEM];
+    int tamanhoOrdem;
+    int capacidadeFila;
+    int contadorFila; // Constante: as ações 1 e 2 repõem a peça retirada
+    int capacidadePilha;
+    int troca;        // Bloco da ação 5
+    int ultimaVez[GERADOR_NUM_TIPOS]; // Última posição de cada tipo na ordem (-1 se não aparece)
+    uint64_t geracao;
+    int limite;       // Profundidade da iteração atual
+    PlanoAcoes *plano;
+} ConsultaPlano;
+
+// --- Tabela de Transposição ---
+
+/**
+ * @brief Verdadeiro se o estado já foi provado sem solução com 'restante' ações ou mais.
+ * * Lê os dois atômicos sem ordem; se outra thread escreveu a posição entre
+ * as leituras, o XOR não confere e a entrada é tratada como ausente.
+ */
+static bool tabelaSemSolucao(const ConsultaPlano *consulta, uint64_t chave, int restante) {
+    PosicaoTransposicao *posicao = &consulta->planejador->tabela[chave & consulta->planejador->mascara];
+    uint64_t chaveXorDados = atomic_load_explicit(&posicao->chaveXorDados, memory_order_relaxed);
+    uint64_t dados = atomic_load_explicit(&posicao->dados, memory_order_relaxed);
+
+    if ((chaveXorDados ^ dados) != chave || (dados >> BITS_RESTANTE) != consulta->geracao) return false;
+    return (int)(dados & ((1u << BITS_RESTANTE) - 1)) >= restante;
+}
+
+static void tabelaGuardar(const ConsultaPlano *consulta, uint64_t chave, int restante) {
+    PosicaoTransposicao *posicao = &consulta->planejador->tabela[chave & consulta->planejador->mascara];
+    uint64_t dados = (consulta->geracao << BITS_RESTANTE) | (uint64_t)restante;
+    atomic_store_explicit(&posicao->chaveXorDados, chave ^ dados, memory_order_relaxed);
+    atomic_store_explicit(&posicao->dados, dados, memory_order_relaxed);
+}
+
+// --- Ações sobre o Estado ---
+
+/**
+ * @brief Retira a peça da frente e repõe uma (ainda não sorteada) no fim (ações 1 e 2).
+ * @return O tipo retirado.
+ */
+static int retirarFrente(const ConsultaPlano *consulta, EstadoPlano *estado) {
+    const Planejador *p = consulta->planejador;
+    int frente = estado->frente;
+    int tipo = estado->fila[frente];
+    int reposicao = ANEL_INDICE_DINAMICO(frente, consulta->contadorFila, consulta->capacidadeFila);
+    int novaFrente = ANEL_INDICE_DINAMICO(frente, 1, consulta->capacidadeFila);
+
+    estado->fila[reposicao] = PLANEJADOR_TIPO_FORA;
+    estado->frente = novaFrente;
+    for (int t = 0; t <= GERADOR_NUM_TIPOS; t++) estado->naFila[t] >>= 1;
+    estado->chave ^= p->chaveFila[frente][tipo] ^ p->chaveFila[reposicao][PLANEJADOR_TIPO_FORA]
+                   ^ p->chaveFrente[frente] ^ p->chaveFrente[novaFrente];
+    return tipo;
+}
+
+/**
+ * @brief Conta a peça jogada; se o tipo dela não aparece mais na ordem, as
+ * peças restantes desse tipo passam a PLANEJADOR_TIPO_FORA.
+ */
+static void avancarProgresso(const ConsultaPlano *consulta, EstadoPlano *estado, int tipo) {
+    const Planejador *p = consulta->planejador;
+    bool descartarTipo = consulta->ultimaVez[tipo] == estado->progresso;
+
+    estado->chave ^= p->chaveProgresso[estado->progresso] ^ p->chaveProgresso[estado->progresso + 1];
+    estado->progresso++;
+    if (!descartarTipo) return;
+
+    for (uint64_t m = estado->naFila[tipo]; m != 0; m &= m - 1) {
+        int posicao = ANEL_INDICE_DINAMICO(estado->frente, __builtin_ctzll(m), consulta->capacidadeFila);
+        estado->fila[posicao] = PLANEJADOR_TIPO_FORA;
+        estado->chave ^= p->chaveFila[posicao][tipo] ^ p->chaveFila[posicao][PLANEJADOR_TIPO_FORA];
+    }
+    for (unsigned m = estado->naPilha[tipo]; m != 0; m &= m - 1) {
+        int i = __builtin_ctz(m);
+        estado->pilha[i] = PLANEJADOR_TIPO_FORA;
+        estado->chave ^= p->chavePilha[i][tipo] ^ p->chavePilha[i][PLANEJADOR_TIPO_FORA];
+    }
+    estado->naFila[PLANEJADOR_TIPO_FORA] |= estado->naFila[tipo];
+    estado->naPilha[PLANEJADOR_TIPO_FORA] |= estado->naPilha[tipo];
+    estado->naFila[tipo] = 0;
+    estado->naPilha[tipo] = 0;
+}
+
+static void moverTopo(const ConsultaPlano *consulta, EstadoPlano *estado, int novoTopo) {
+    const Planejador *p = consulta->planejador;
+    estado->chave ^= p->chaveTopo[estado->topo + 1] ^ p->chaveTopo[novoTopo + 1];
+    estado->topo = novoTopo;
+}
+
+/**
+ * @brief Troca a peça a 'desloc' posições da frente com a da posição 'posicaoPilha' da pilha.
+ */
+static void trocarPosicoes(const ConsultaPlano *consulta, EstadoPlano *estado, int desloc, int posicaoPilha) {
+    const Planejador *p = consulta->planejador;
+    int posicaoFila = ANEL_INDICE_DINAMICO(estado->frente, desloc, consulta->capacidadeFila);
+    int tipoFila = estado->fila[posicaoFila];
+    int tipoPilha = estado->pilha[posicaoPilha];
+
+    estado->fila[posicaoFila] = (uint8_t)tipoPilha;
+    estado->pilha[posicaoPilha] = (uint8_t)tipoFila;
+    estado->naFila[tipoFila] ^= 1ULL << desloc;
+    estado->naFila[tipoPilha] ^= 1ULL << desloc;
+    estado->naPilha[tipoPilha] ^= (uint16_t)(1u << posicaoPilha);
+    estado->naPilha[tipoFila] ^= (uint16_t)(1u << posicaoPilha);
+    estado->chave ^= p->chaveFila[posicaoFila][tipoFila] ^ p->chaveFila[posicaoFila][tipoPilha]
+                   ^ p->chavePilha[posicaoPilha][tipoPilha] ^ p->chavePilha[posicaoPilha][tipoFila];
+}
+
+/**
+ * @brief Aplica a ação (1 a 5) em 'estado'.
+ * @return false se a ação é recusada pelo simulador ou joga uma peça fora da ordem.
+ */
+static bool aplicarAcaoPlano(const ConsultaPlano *consulta, EstadoPlano *estado, int acao) {
+    const Planejador *p = consulta->planejador;
+    int proxima = consulta->ordem[estado->progresso];
+
+    switch (acao) {
+        case 1:
+            if (estado->fila[estado->frente] != proxima) return false;
+            retirarFrente(consulta, estado);
+            avancarProgresso(consulta, estado, proxima);
+            return true;
+        case 2: {
+            if (estado->topo + 1 >= consulta->capacidadePilha) return false;
+            int tipo = retirarFrente(consulta, estado);
+            moverTopo(consulta, estado, estado->topo + 1);
+            estado->pilha[estado->topo] = (uint8_t)tipo;
+            estado->naPilha[tipo] |= (uint16_t)(1u << estado->topo);
+            estado->chave ^= p->chavePilha[estado->topo][tipo];
+            return true;
+        }
+        case 3:
+            if (estado->topo < 0 || estado->pilha[estado->topo] != proxima) return false;
+            estado->chave ^= p->chavePilha[estado->topo][proxima];
+            estado->naPilha[proxima] &= (uint16_t)~(1u << estado->topo);
+            moverTopo(consulta, estado, estado->topo - 1);
+            avancarProgresso(consulta, estado, proxima);
+            return true;
+        case 4:
+            if (estado->topo < 0) return false;
+            trocarPosicoes(consulta, estado, 0, estado->topo);
+            return true;
+        case 5:
+            if (consulta->troca <= 0 || consulta->contadorFila < consulta->troca || estado->topo + 1 < consulta->troca) {
+                return false;
+            }
+            for (int i = 0; i < consulta->troca; i++) trocarPosicoes(consulta, estado, i, estado->topo - i);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// --- Busca ---
+
+/**
+ * @brief Ações para levar a próxima peça da ordem à frente da fila ou ao
+ * topo da pilha (INT_MAX se não há como).
+ * * Antes de a próxima ser jogada nenhuma peça sai da pilha, e as trocas só
+ * levam a posição j da fila à posição j abaixo do topo e vice-versa. Assim,
+ * uma peça na posição j da fila só chega à frente com j reservas (ação 2),
+ * e uma peça j posições abaixo do topo precisa de uma troca múltipla
+ * (j < alcance) e das mesmas j reservas; cada reserva ocupa espaço na pilha.
+ */
+static int acoesAteProxima(const ConsultaPlano *consulta, const EstadoPlano *estado, int alcance) {
+    int proxima = consulta->ordem[estado->progresso];
+    if (estado->fila[estado->frente] == proxima || (estado->topo >= 0 && estado->pilha[estado->topo] == proxima)) {
+        return 0;
+    }
+
+    int livres = consulta->capacidadePilha - (estado->topo + 1);
+    int acoes = INT_MAX;
+
+    uint64_t faixaFila = livres >= 63 ? ~1ULL : ((2ULL << livres) - 1) & ~1ULL;
+    uint64_t naFila = estado->naFila[proxima] & faixaFila;
+    if (naFila != 0) acoes = __builtin_ctzll(naFila);
+
+    // Posições 1 a min(alcance - 1, livres) abaixo do topo
+    int profundidade = alcance - 1 < livres ? alcance - 1 : livres;
+    if (estado->topo > 0 && profundidade > 0) {
+        int maisFunda = estado->topo - profundidade;
+        unsigned faixaPilha = (1u << estado->topo) - (1u << (maisFunda > 0 ? maisFunda : 0));
+        unsigned naPilha = estado->naPilha[proxima] & faixaPilha;
+        if (naPilha != 0) {
+            int j = estado->topo - (31 - __builtin_clz(naPilha));
+            if (j + 1 < acoes) acoes = j + 1;
+        }
+    }
+    return acoes;
+}
+
+static int contarBits(uint64_t m) {
+    int n = 0;
+    for (; m != 0; m &= m - 1) n++;
+    return n;
+}
+
+/**
+ * @brief Reservas (ações 2) que ainda serão necessárias (INT_MAX se não há como).
+ * * Relaxação do problema: as peças das 'alcance' primeiras posições da fila
+ * e do topo da pilha podem ser jogadas em qualquer ordem; as da fila além
+ * delas ficam disponíveis à medida que a frente avança, e as mais fundas da
+ * pilha, uma a cada jogada (só a ação 3 as aproxima do topo). Antes da
+ * k-ésima jogada a frente precisa ter avançado o bastante para cobrir as k
+ * primeiras peças da ordem; no máximo k - 1 desses avanços vêm de ações 1,
+ * o resto são reservas, que precisam caber no espaço livre da pilha mais o
+ * que as ações 3 liberaram.
+ */
+static int reservasNecessarias(const ConsultaPlano *consulta, const EstadoPlano *estado, int alcance) {
+    int disponiveis[GERADOR_NUM_TIPOS + 1] = {0};
+    int demanda[GERADOR_NUM_TIPOS] = {0};
+    int faltam = consulta->tamanhoOrdem - estado->progresso;
+    int livres = consulta->capacidadePilha - (estado->topo + 1);
+    uint64_t janela = alcance >= 64 ? ~0ULL : (1ULL << alcance) - 1;
+
+    int maisFunda = estado->topo - alcance + 1; // Posição mais funda da pilha já disponível
+    unsigned topoPilha = maisFunda > 0 ? ~((1u << maisFunda) - 1) : ~0u;
+    for (int t = 0; t < GERADOR_NUM_TIPOS; t++) {
+        disponiveis[t] = contarBits(estado->naPilha[t] & topoPilha) + contarBits(estado->naFila[t] & janela);
+    }
+
+    int avancos = 0, reservas = 0;
+    int desloc = alcance;
+    int posicao = desloc < consulta->contadorFila
+                ? ANEL_INDICE_DINAMICO(estado->frente, desloc, consulta->capacidadeFila) : 0;
+    for (int k = 1; k <= faltam; k++) {
+        int tipo = consulta->ordem[estado->progresso + k - 1];
+        demanda[tipo]++;
+        if (k > 1 && --maisFunda >= 0) disponiveis[estado->pilha[maisFunda]]++;
+        while (demanda[tipo] > disponiveis[tipo]) {
+            if (desloc >= consulta->contadorFila) return INT_MAX;
+            disponiveis[estado->fila[posicao]]++;
+            posicao = ANEL_AVANCAR_DINAMICO(posicao, consulta->capacidadeFila);
+            desloc++;
+            avancos++;
+        }
+        if (avancos > livres + k - 1) return INT_MAX;
+        if (avancos - (k - 1) > reservas) reservas = avancos - (k - 1);
+    }
+    return reservas;
+}
+
+/**
+ * @brief Limite inferior de ações até o fim da ordem (INT_MAX se não há como chegar lá).
+ * * Cada peça que falta custa uma ação (1 ou 3); além delas, ou as ações para
+ * alcançar a próxima ou as reservas necessárias, o que for maior.
+ */
+static int limiteInferior(const ConsultaPlano *consulta, const EstadoPlano *estado) {
+    int faltam = consulta->tamanhoOrdem - estado->progresso;
+    if (faltam == 0) return 0;
+
+    int alcance = consulta->troca > 1 ? consulta->troca : 1;
+    int ateProxima = acoesAteProxima(consulta, estado, alcance);
+    if (ateProxima == INT_MAX) return INT_MAX;
+    int reservas = reservasNecessarias(consulta, estado, alcance);
+    if (reservas == INT_MAX) return INT_MAX;
+
+    return faltam + (reservas > ateProxima ? reservas : ateProxima);
+}
+
+/**
+ * @brief Busca em profundidade limitada a consulta->limite ações (uma iteração do IDA*).
+ * * As ações que jogam a próxima peça são tentadas primeiro. Uma troca (4 ou 5)
+ * logo depois da mesma troca desfaz a anterior e não é tentada; usar a peça
+ * que acabou de ser reservada chega ao mesmo estado que jogá-la direto.
+ */
+static bool buscarPlano(ConsultaPlano *consulta, const EstadoPlano *estado, int profundidade, int acaoAnterior) {
+    static const uint8_t ORDEM_ACOES[] = {1, 3, 4, 5, 2};
+
+    consulta->plano->nos++;
+    if (estado->progresso == consulta->tamanhoOrdem) {
+        consulta->plano->numAcoes = profundidade;
+        return true;
+    }
+
+    int restante = consulta->limite - profundidade;
+    if (limiteInferior(consulta, estado) > restante) return false;
+    if (tabelaSemSolucao(consulta, estado->chave, restante)) {
+        consulta->plano->cortesTabela++;
+        return false;
+    }
+
+    // Gera os filhos antes de descer, já trazendo para o cache as posições deles na tabela
+    EstadoPlano filhos[sizeof(ORDEM_ACOES)];
+    uint8_t acoes[sizeof(ORDEM_ACOES)];
+    int numFilhos = 0;
+    for (size_t i = 0; i < sizeof(ORDEM_ACOES); i++) {
+        int acao = ORDEM_ACOES[i];
+        if ((acao == 4 || acao == 5) && acao == acaoAnterior) continue;
+        if (acao == 3 && acaoAnterior == 2) continue; // Reservar e usar em seguida = jogar (ação 1)
+
+        filhos[numFilhos] = *estado;
+        if (!aplicarAcaoPlano(consulta, &filhos[numFilhos], acao)) continue;
+        __builtin_prefetch(&consulta->planejador->tabela[filhos[numFilhos].chave & consulta->planejador->mascara]);
+        acoes[numFilhos++] = (uint8_t)acao;
+    }
+
+    for (int i = 0; i < numFilhos; i++) {
+        consulta->plano->acoes[profundidade] = acoes[i];
+        if (buscarPlano(consulta, &filhos[i], profundidade + 1, acoes[i])) return true;
+    }
+
+    tabelaGuardar(consulta, estado->chave, restante);
+    return false;
+}
+
+// --- Implementação das Funções ---
+
+/**
+ * @brief Aloca a tabela de transposição (2^bitsTabela posições) e sorteia as chaves Zobrist.
+ */
+bool planejadorCriar(Planejador *planejador, int bitsTabela) {
+    memset(planejador, 0, sizeof(*planejador));
+    if (bitsTabela < 1 || bitsTabela > 30) {
+        fprintf(stderr, "ERRO: Tamanho invalido para a tabela de transposicao (%d bits).\n", bitsTabela);
+        return false;
+    }
+
+    size_t posicoes = (size_t)1 << bitsTabela;
+    planejador->tabela = aligned_alloc(64, posicoes * sizeof(PosicaoTransposicao));
+    if (planejador->tabela == NULL) {
+        fprintf(stderr, "ERRO: Falha ao alocar a tabela de transposicao (%zu posicoes).\n", posicoes);
+        return false;
+    }
+    // Zerada aqui (e não com calloc) para que as páginas não faltem durante as consultas
+    memset(planejador->tabela, 0, posicoes * sizeof(PosicaoTransposicao));
+    planejador->mascara = posicoes - 1;
+    atomic_init(&planejador->geracao, 0);
+
+    GeradorPecas gerador;
+    geradorSemear(&gerador, SEMENTE_ZOBRIST);
+    for (int i = 0; i < PLANEJADOR_MAX_FILA; i++) {
+        for (int t = 0; t <= GERADOR_NUM_TIPOS; t++) planejador->chaveFila[i][t] = geradorProximo64(&gerador);
+        planejador->chaveFrente[i] = geradorProximo64(&gerador);
+    }
+    for (int i = 0; i < PLANEJADOR_MAX_PILHA; i++) {
+        for (int t = 0; t <= GERADOR_NUM_TIPOS; t++) planejador->chavePilha[i][t] = geradorProximo64(&gerador);
+    }
+    for (int i = 0; i <= PLANEJADOR_MAX_PILHA; i++) planejador->chaveTopo[i] = geradorProximo64(&gerador);
+    for (int i = 0; i <= PLANEJADOR_MAX_ORDEM; i++) planejador->chaveProgresso[i] = geradorProximo64(&gerador);
+    return true;
+}
+
+void planejadorDestruir(Planejador *planejador) {
+    free(planejador->tabela);
+    planejador->tabela = NULL;
+}
+
+/**
+ * @brief Procura o menor plano (até maxAcoes ações) que joga as peças na ordem pedida.
+ * * 'ordem' é uma sequência de tipos ("TLI"). O estado da sessão não é alterado.
+ * @return false se a consulta é inválida (ERRO); o resultado da busca fica em 'plano'.
+ */
+bool planejar(Planejador *planejador, const FilaPecas *fila, const PilhaPecas *pilha,
+              const char *ordem, int maxAcoes, PlanoAcoes *plano) {
+    memset(plano, 0, sizeof(*plano));
+
+    ConsultaPlano consulta = {0};
+    consulta.planejador = planejador;
+    consulta.plano = plano;
+    consulta.tamanhoOrdem = (int)strlen(ordem);
+    consulta.capacidadeFila = fila->capacidade;
+    consulta.contadorFila = fila->contador;
+    consulta.capacidadePilha = pilha->capacidade;
+    consulta.troca = tamanhoTroca;
+
+    if (consulta.tamanhoOrdem == 0 || consulta.tamanhoOrdem > PLANEJADOR_MAX_ORDEM) {
+        fprintf(stderr, "ERRO: A ordem de pecas deve ter de 1 a %d tipos.\n", PLANEJADOR_MAX_ORDEM);
+        return false;
+    }
+    if (fila->capacidade > PLANEJADOR_MAX_FILA || pilha->capacidade > PLANEJADOR_MAX_PILHA) {
+        fprintf(stderr, "ERRO: O planejador aceita filas de ate %d pecas e pilhas de ate %d.\n",
+                PLANEJADOR_MAX_FILA, PLANEJADOR_MAX_PILHA);
+        return false;
+    }
+    if (maxAcoes < 1 || maxAcoes > PLANEJADOR_MAX_ACOES) {
+        fprintf(stderr, "ERRO: O plano deve ter de 1 a %d acoes.\n", PLANEJADOR_MAX_ACOES);
+        return false;
+    }
+
+    for (int t = 0; t < GERADOR_NUM_TIPOS; t++) consulta.ultimaVez[t] = -1;
+    for (int i = 0; i < consulta.tamanhoOrdem; i++) {
+        int tipo = indiceTipoPeca((char)toupper((unsigned char)ordem[i]));
+        if (tipo < 0) {
+            fprintf(stderr, "ERRO: Tipo de peca invalido na ordem: '%c' (use I, O, T ou L).\n", ordem[i]);
+            return false;
+        }
+        consulta.ordem[i] = (uint8_t)tipo;
+        consulta.ultimaVez[tipo] = i;
+    }
+
+    // Estado inicial, com a chave calculada do zero (tipos fora da ordem já descartados)
+    EstadoPlano estado;
+    memset(&estado, 0, sizeof(estado));
+    estado.frente = fila->frente;
+    estado.topo = pilha->topo;
+    estado.chave = planejador->chaveFrente[estado.frente] ^ planejador->chaveTopo[estado.topo + 1]
+                 ^ planejador->chaveProgresso[0];
+    for (int i = 0; i < fila->contador; i++) {
+        int posicao = ANEL_INDICE_DINAMICO(fila->frente, i, fila->capacidade);
+        int tipo = indiceTipoPeca(fila->itens[posicao].nome);
+        if (tipo < 0 || consulta.ultimaVez[tipo] < 0) tipo = PLANEJADOR_TIPO_FORA;
+        estado.fila[posicao] = (uint8_t)tipo;
+        estado.naFila[tipo] |= 1ULL << i;
+        estado.chave ^= planejador->chaveFila[posicao][tipo];
+    }
+    for (int i = 0; i <= pilha->topo; i++) {
+        int tipo = indiceTipoPeca(pilha->itens[i].nome);
+        if (tipo < 0 || consulta.ultimaVez[tipo] < 0) tipo = PLANEJADOR_TIPO_FORA;
+        estado.pilha[i] = (uint8_t)tipo;
+        estado.naPilha[tipo] |= (uint16_t)(1u << i);
+        estado.chave ^= planejador->chavePilha[i][tipo];
+    }
+    if (fila->contador == 0) return true;
+
+    uint32_t geracao;
+    do {
+        geracao = (atomic_fetch_add_explicit(&planejador->geracao, 1, memory_order_relaxed) + 1) & MASCARA_GERACAO;
+    } while (geracao == 0);
+    consulta.geracao = geracao;
+
+    // Sem peças visíveis suficientes (as repostas nunca entram na ordem), não há plano
+    int limiteInicial = limiteInferior(&consulta, &estado);
+    if (limiteInicial > maxAcoes) return true;
+    for (consulta.limite = limiteInicial; consulta.limite <= maxAcoes; consulta.limite++) {
+        if (buscarPlano(&consulta, &estado, 0, 0)) {
+            plano->encontrado = true;
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Planeja a ordem pedida para a sessão e imprime o plano (modo --planejar).
+ */
+int executarPlanejador(FilaPecas *fila, PilhaPecas *pilha, const char *ordem, int maxAcoes) {
+    Planejador planejador;
+    if (!planejadorCriar(&planejador, PLANEJADOR_BITS_TABELA)) return 1;
+
+    PlanoAcoes plano;
+    double inicio = tempoAtual();
+    bool valido = planejar(&planejador, fila, pilha, ordem, maxAcoes, &plano);
+    double decorrido = tempoAtual() - inicio;
+    planejadorDestruir(&planejador);
+    if (!valido) return 1;
+
+    exibirEstadoAtual(fila, pilha);
+    if (plano.encontrado) {
+        printf("Plano para a ordem %s (%d acoes):", ordem, plano.numAcoes);
+        for (int i = 0; i < plano.numAcoes; i++) printf(" %d", plano.acoes[i]);
+        printf("\n");
+    } else {
+        printf("Nenhum plano de ate %d acoes joga a ordem %s com as pecas visiveis.\n", maxAcoes, ordem);
+    }
+    printf("Estados visitados: %lld | Cortes na tabela de transposicao: %lld\n", plano.nos, plano.cortesTabela);
+    printf("Tempo: %.6f s\n", decorrido);
+    return 0;
+}
@@ -0,0 +1,79 @@
+#ifndef PLANEJADOR_H
+#define PLANEJADOR_H
+
+// Planejador de ações do simulador Mestre.
+//
+// Responde à pergunta "que sequência de ações 1 a 5 faz as próximas peças
+// jogadas saírem na ordem X?". Peças jogadas são as da ação 1 (frente da
+// fila) e as da ação 3 (topo da pilha). As peças de reposição ainda não
+// foram sorteadas, então entram na busca como desconhecidas: podem ser
+// reservadas e trocadas, mas nunca jogadas como parte da ordem pedida.
+// Assim o plano vale qualquer que seja a peça sorteada.
+//
+// A busca é um aprofundamento iterativo (IDA*) sobre o grafo de estados da
+// fila e da pilha. Peças de reposição e peças de tipos que não faltam mais
+// na ordem são todas equivalentes (PLANEJADOR_TIPO_FORA), o que junta muitos
+// estados. O limite inferior conta as peças que faltam jogar, as ações para
+// alcançar a próxima e quantas vezes a frente da fila ainda precisa avançar;
+// ele também descarta estados em que a pilha não tem espaço para as
+// reservas necessárias. Cada estado tem uma chave
+// Zobrist (tipo de cada posição física da fila e da pilha, frente, topo e
+// quantas peças da ordem já saíram), atualizada a cada ação com poucos XOR.
+//
+// Os estados já provados sem solução dentro de uma profundidade ficam em
+// uma tabela de transposição de tamanho fixo e sem travas: cada posição
+// guarda (chave ^ dados, dados) em dois atômicos, e uma leitura só é aceita
+// se o XOR confere, então várias threads podem usar a mesma tabela.
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tetris_stack_mestre.h"
+
+// --- Constantes ---
+#define PLANEJADOR_MAX_FILA 64        // Maior fila aceita pelo planejador
+#define PLANEJADOR_MAX_PILHA 16       // Maior pilha aceita pelo planejador
+#define PLANEJADOR_MAX_ORDEM 32       // Maior ordem de peças pedida
+#define PLANEJADOR_MAX_ACOES 64       // Maior plano procurado
+#define PLANEJADOR_ACOES_PADRAO 24    // Plano procurado por padrão (--max-acoes N)
+#define PLANEJADOR_BITS_TABELA 16     // 2^16 posições (1 MiB) na tabela de transposição
+#define PLANEJADOR_TIPO_FORA GERADOR_NUM_TIPOS // Peça que não entra mais na ordem
+
+// --- Estruturas de Dados ---
+
+typedef struct {
+    _Atomic uint64_t chaveXorDados;
+    _Atomic uint64_t dados; // (geração << 8) | profundidade restante sem solução
+} PosicaoTransposicao;
+
+typedef struct {
+    PosicaoTransposicao *tabela;
+    uint64_t mascara;
+    _Atomic uint32_t geracao; // Uma por consulta: entradas de outras consultas são ignoradas
+
+    // Chaves Zobrist
+    uint64_t chaveFila[PLANEJADOR_MAX_FILA][GERADOR_NUM_TIPOS + 1];
+    uint64_t chavePilha[PLANEJADOR_MAX_PILHA][GERADOR_NUM_TIPOS + 1];
+    uint64_t chaveFrente[PLANEJADOR_MAX_FILA];
+    uint64_t chaveTopo[PLANEJADOR_MAX_PILHA + 1];
+    uint64_t chaveProgresso[PLANEJADOR_MAX_ORDEM + 1];
+} Planejador;
+
+typedef struct {
+    bool encontrado;
+    int numAcoes;
+    uint8_t acoes[PLANEJADOR_MAX_ACOES]; // Códigos do menu (1 a 5)
+    long long nos;                       // Estados visitados
+    long long cortesTabela;              // Estados descartados pela tabela de transposição
+} PlanoAcoes;
+
+// --- Protótipos das Funções ---
+
+bool planejadorCriar(Planejador *planejador, int bitsTabela);
+void planejadorDestruir(Planejador *planejador);
+bool planejar(Planejador *planejador, const FilaPecas *fila, const PilhaPecas *pilha,
+              const char *ordem, int maxAcoes, PlanoAcoes *plano);
+int executarPlanejador(FilaPecas *fila, PilhaPecas *pilha, const char *ordem, int maxAcoes);
+
+#endif // PLANEJADOR_H
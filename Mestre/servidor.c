@@ -0,0 +1,798 @@
+#define _GNU_SOURCE // accept4, signalfd
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "servidor.h"
+#include "peca_compacta.h"
+#include "tempo_real.h"
+#include "transmissao.h"
+#include "../Comum/anel_circular.h"
+
+// --- Constantes ---
+#define SERVIDOR_EVENTOS 256                // Eventos tratados por chamada de epoll_wait
+#define SERVIDOR_ID_ESCUTA UINT32_MAX       // epoll_event.data do socket de escuta
+#define SERVIDOR_ID_SINAIS (UINT32_MAX - 1) // epoll_event.data do signalfd
+#define SERVIDOR_DESCRITORES_EXTRAS 16      // Descritores além das conexões (escuta, epoll, stdio...)
+#define CLIENTE_TAM_ENTRADA SERVIDOR_TAM_MAX_RESPOSTA(SERVIDOR_MAX_CAPACIDADE, SERVIDOR_MAX_CAPACIDADE)
+
+// --- Estruturas de Dados ---
+
+// Conexão atendida pelo servidor. Fica no início de um bloco de tamanhoBloco
+// bytes, seguida das peças da fila, das peças da pilha e do buffer de saída.
+typedef struct {
+    int fd;
+    bool ativa;
+    bool encerrando;      // O cliente fechou a escrita: fecha ao esvaziar a saída
+    uint32_t eventos;     // Eventos registrados no epoll
+    uint32_t inicioSaida; // Bytes do buffer de saída já enviados
+    uint32_t fimSaida;    // Bytes escritos no buffer de saída
+    uint8_t *saida;
+    FilaPecas fila;
+    PilhaPecas pilha;
+} ConexaoServidor;
+
+typedef struct {
+    int fdEscuta;
+    int fdEpoll;
+    int fdSinais;
+    int capacidadeFila;
+    int capacidadePilha;
+    uint64_t semente;
+    int maxClientes;
+    size_t tamanhoBloco;
+    uint32_t tamanhoSaida;
+    uint32_t tamanhoMaxResposta;
+    unsigned char *blocos; // maxClientes blocos de tamanhoBloco bytes
+    int *livres;           // Pilha de índices de blocos livres
+    int numLivres;
+    bool escutaPausada;    // Sem descritores: a escuta volta quando uma conexão fechar
+    Transmissao transmissao;
+    bool transmitindo;     // --transmitir: a sessão de cada bloco é publicada
+
+    long long aceitas;
+    long long rejeitadas;  // Acima de --max-clientes
+    long long ativas;
+    long long maxAtivas;
+    long long comandos;
+    long long executadas;
+    long long recusadas;
+    long long invalidos;
+    unsigned long long bytesEnviados;
+} Servidor;
+
+// Conexão aberta pelo cliente de carga, com o espelho da sessão montado a
+// partir das respostas.
+typedef struct {
+    int fd;
+    long long restantes;  // Ações ainda não enviadas
+    bool saudado;         // A saudação já chegou
+    bool aguardando;      // Há um comando sem resposta
+    bool conferindo;      // O estado final (código 0) foi pedido
+    uint64_t envio;       // Instante do envio do comando pendente
+    uint32_t recebidos;   // Bytes no buffer de entrada
+    uint8_t entrada[CLIENTE_TAM_ENTRADA];
+    int frente;
+    int contadorFila;
+    int contadorPilha;
+    PecaCompacta fila[SERVIDOR_MAX_CAPACIDADE];
+    PecaCompacta pilha[SERVIDOR_MAX_CAPACIDADE];
+} ConexaoCliente;
+
+typedef struct {
+    int capacidadeFila;   // Da primeira saudação (0 = nenhuma ainda)
+    int capacidadePilha;
+    GeradorPecas sorteio;
+    long long executadas;
+    long long recusadas;
+    long long divergencias; // Respostas que não batem com o espelho
+    long long concluidas;   // Conexões que conferiram o estado final
+    long long perdidas;     // Conexões fechadas pelo servidor antes do fim
+    HistogramaLatencia idaEVolta;
+} Cliente;
+
+// --- Funções Auxiliares ---
+
+static inline uint64_t agoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Semente da sessão da n-ésima conexão aceita (como sementeDaSessao em sessoes.c).
+ */
+static uint64_t sementeDaConexao(uint64_t sementeBase, long long n) {
+    return sementeBase ^ ((uint64_t)(n + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * @brief Sobe o limite de descritores abertos até 'necessarios', se o limite rígido deixar.
+ * @return false se o limite continuar abaixo do necessário.
+ */
+static bool garantirDescritores(int necessarios) {
+    struct rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) != 0) return false;
+    if (limite.rlim_cur >= (rlim_t)necessarios) return true;
+    limite.rlim_cur = limite.rlim_max < (rlim_t)necessarios ? limite.rlim_max : (rlim_t)necessarios;
+    setrlimit(RLIMIT_NOFILE, &limite);
+    return getrlimit(RLIMIT_NOFILE, &limite) == 0 && limite.rlim_cur >= (rlim_t)necessarios;
+}
+
+/**
+ * @brief Preenche o endereço do socket.
+ * @return false se o caminho não couber em sun_path.
+ */
+static bool enderecoSocket(struct sockaddr_un *endereco, const char *caminho) {
+    memset(endereco, 0, sizeof(*endereco));
+    endereco->sun_family = AF_UNIX;
+    if (strlen(caminho) >= sizeof(endereco->sun_path)) {
+        fprintf(stderr, "ERRO: Caminho do socket muito longo: '%s'.\n", caminho);
+        return false;
+    }
+    strcpy(endereco->sun_path, caminho);
+    return true;
+}
+
+static inline void escreverU32(uint8_t *p, uint32_t valor) {
+    p[0] = (uint8_t)valor;
+    p[1] = (uint8_t)(valor >> 8);
+    p[2] = (uint8_t)(valor >> 16);
+    p[3] = (uint8_t)(valor >> 24);
+}
+
+static inline uint32_t lerU32(const uint8_t *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+// --- Protocolo ---
+
+static inline uint8_t *escreverAlteracao(uint8_t *p, int posicao, Peca peca) {
+    p[0] = (uint8_t)posicao;
+    escreverU32(p + 1, compactarPeca(peca));
+    return p + SERVIDOR_TAM_ALTERACAO;
+}
+
+/**
+ * @brief Escreve a resposta a um comando já executado: o cabeçalho e as
+ * posições que a ação escreveu (ou todas, para o código 0).
+ * @return Tamanho da resposta, no máximo SERVIDOR_TAM_MAX_RESPOSTA.
+ */
+static uint32_t escreverResposta(uint8_t *destino, const FilaPecas *fila, const PilhaPecas *pilha,
+                                 int codigo, int resultado) {
+    uint8_t *p = destino + SERVIDOR_TAM_CABECALHO;
+    int cap = fila->capacidade;
+
+    if (codigo == 0) {
+        for (int i = 0; i < fila->contador; i++) {
+            int indice = ANEL_INDICE_DINAMICO(fila->frente, i, cap);
+            p = escreverAlteracao(p, indice, fila->itens[indice]);
+        }
+        for (int nivel = 0; nivel <= pilha->topo; nivel++) {
+            p = escreverAlteracao(p, SERVIDOR_POSICAO_PILHA | nivel, pilha->itens[nivel]);
+        }
+    } else if (resultado == SERVIDOR_EXECUTADA) {
+        switch (codigo) {
+            case 1: // Reposição no final da fila
+                p = escreverAlteracao(p, fila->tras, fila->itens[fila->tras]);
+                break;
+            case 2: // Reposição no final da fila + push na pilha
+                p = escreverAlteracao(p, fila->tras, fila->itens[fila->tras]);
+                p = escreverAlteracao(p, SERVIDOR_POSICAO_PILHA | pilha->topo, pilha->itens[pilha->topo]);
+                break;
+            case 4: // Frente da fila <-> topo da pilha
+                p = escreverAlteracao(p, fila->frente, fila->itens[fila->frente]);
+                p = escreverAlteracao(p, SERVIDOR_POSICAO_PILHA | pilha->topo, pilha->itens[pilha->topo]);
+                break;
+            case 5: // Bloco da frente da fila <-> bloco do topo da pilha
+                for (int i = 0; i < tamanhoTroca; i++) {
+                    int indice = ANEL_INDICE_DINAMICO(fila->frente, i, cap);
+                    p = escreverAlteracao(p, indice, fila->itens[indice]);
+                }
+                for (int i = 0; i < tamanhoTroca; i++) {
+                    p = escreverAlteracao(p, SERVIDOR_POSICAO_PILHA | (pilha->topo - i), pilha->itens[pilha->topo - i]);
+                }
+                break;
+            default: // A ação 3 só altera o topo
+                break;
+        }
+    }
+
+    uint32_t tamanho = (uint32_t)(p - destino);
+    destino[0] = (uint8_t)codigo;
+    destino[1] = (uint8_t)resultado;
+    destino[2] = (uint8_t)fila->frente;
+    destino[3] = (uint8_t)fila->contador;
+    destino[4] = (uint8_t)(pilha->topo + 1);
+    destino[5] = (uint8_t)((tamanho - SERVIDOR_TAM_CABECALHO) / SERVIDOR_TAM_ALTERACAO);
+    return tamanho;
+}
+
+// --- Servidor: Conexões ---
+
+/**
+ * @brief Deslocamento das peças da fila no bloco da conexão (logo depois da ConexaoServidor).
+ */
+static inline size_t deslocamentoPecas(void) {
+    return (sizeof(ConexaoServidor) + _Alignof(Peca) - 1) / _Alignof(Peca) * _Alignof(Peca);
+}
+
+static inline ConexaoServidor *conexaoServidor(Servidor *s, int indice) {
+    return (ConexaoServidor *)(s->blocos + (size_t)indice * s->tamanhoBloco);
+}
+
+static void ajustarEventos(Servidor *s, ConexaoServidor *c, int indice, uint32_t eventos) {
+    if (eventos == c->eventos) return;
+    struct epoll_event ev = {.events = eventos, .data.u32 = (uint32_t)indice};
+    epoll_ctl(s->fdEpoll, EPOLL_CTL_MOD, c->fd, &ev);
+    c->eventos = eventos;
+}
+
+static void fecharConexao(Servidor *s, int indice) {
+    ConexaoServidor *c = conexaoServidor(s, indice);
+    close(c->fd); // Também o retira do epoll
+    c->ativa = false;
+    if (s->transmitindo) transmissaoRetirar(&s->transmissao, indice);
+    s->livres[s->numLivres++] = indice;
+    s->ativas--;
+
+    if (s->escutaPausada) {
+        struct epoll_event ev = {.events = EPOLLIN, .data.u32 = SERVIDOR_ID_ESCUTA};
+        epoll_ctl(s->fdEpoll, EPOLL_CTL_MOD, s->fdEscuta, &ev);
+        s->escutaPausada = false;
+    }
+}
+
+/**
+ * @brief Envia o que couber do buffer de saída e ajusta os eventos da conexão:
+ * EPOLLOUT enquanto sobrar saída, EPOLLIN enquanto couber mais uma resposta.
+ * @return false se a conexão deve ser fechada.
+ */
+static bool enviarSaida(Servidor *s, ConexaoServidor *c, int indice) {
+    while (c->inicioSaida < c->fimSaida) {
+        ssize_t n = send(c->fd, c->saida + c->inicioSaida, c->fimSaida - c->inicioSaida, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        c->inicioSaida += (uint32_t)n;
+        s->bytesEnviados += (unsigned long long)n;
+    }
+
+    // O que sobrou volta para o início do buffer (no máximo algumas respostas)
+    uint32_t pendente = c->fimSaida - c->inicioSaida;
+    if (pendente > 0 && c->inicioSaida > 0) memmove(c->saida, c->saida + c->inicioSaida, pendente);
+    c->inicioSaida = 0;
+    c->fimSaida = pendente;
+
+    if (c->encerrando && pendente == 0) return false;
+    uint32_t eventos = pendente > 0 ? EPOLLOUT : 0;
+    if (!c->encerrando && s->tamanhoSaida - c->fimSaida >= s->tamanhoMaxResposta) eventos |= EPOLLIN;
+    ajustarEventos(s, c, indice, eventos);
+    return true;
+}
+
+/**
+ * @brief Lê os comandos cujas respostas cabem no buffer de saída, executa-os
+ * na ordem e envia as respostas.
+ * @return false se a conexão deve ser fechada.
+ */
+static bool atenderConexao(Servidor *s, ConexaoServidor *c, int indice) {
+    uint8_t comandos[SERVIDOR_RESPOSTAS_POR_LEITURA];
+    size_t cabem = (s->tamanhoSaida - c->fimSaida) / s->tamanhoMaxResposta;
+    if (cabem > sizeof(comandos)) cabem = sizeof(comandos);
+    if (cabem == 0) return enviarSaida(s, c, indice);
+
+    ssize_t n = recv(c->fd, comandos, cabem, 0);
+    if (n == 0) {
+        // Fim da escrita do cliente: as respostas pendentes ainda são enviadas
+        c->encerrando = true;
+        return enviarSaida(s, c, indice);
+    }
+    if (n < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+    long long executadasAntes = s->executadas;
+    for (ssize_t i = 0; i < n; i++) {
+        int codigo = comandos[i];
+        int resultado;
+        if (codigo == 0) {
+            resultado = SERVIDOR_EXECUTADA;
+        } else if (codigo <= 5) {
+            resultado = executarAcao(&c->fila, &c->pilha, codigo) ? SERVIDOR_EXECUTADA : SERVIDOR_RECUSADA;
+            if (resultado == SERVIDOR_EXECUTADA) s->executadas++; else s->recusadas++;
+        } else {
+            resultado = SERVIDOR_INVALIDO;
+            s->invalidos++;
+        }
+        c->fimSaida += escreverResposta(c->saida + c->fimSaida, &c->fila, &c->pilha, codigo, resultado);
+    }
+    s->comandos += n;
+    if (s->transmitindo && s->executadas != executadasAntes) {
+        transmissaoPublicar(&s->transmissao, indice, &c->fila, &c->pilha);
+    }
+    return enviarSaida(s, c, indice);
+}
+
+/**
+ * @brief Cria a sessão da conexão no bloco e enfileira a saudação e o estado completo.
+ */
+static void iniciarConexao(Servidor *s, ConexaoServidor *c, int fd) {
+    c->fd = fd;
+    c->ativa = true;
+    c->encerrando = false;
+    c->eventos = EPOLLIN;
+    c->inicioSaida = c->fimSaida = 0;
+
+    // Sessão como em sessoesCriar: fila cheia e pilha vazia
+    c->fila.itens = (Peca *)((unsigned char *)c + deslocamentoPecas());
+    c->fila.capacidade = s->capacidadeFila;
+    nucleoIniciarFila(&c->fila);
+    c->fila.canal = NULL;
+    c->fila.tabuleiro = NULL;
+    geradorSemear(&c->fila.gerador, sementeDaConexao(s->semente, s->aceitas));
+    gerarPecas(&c->fila, c->fila.itens, s->capacidadeFila);
+    c->fila.contador = s->capacidadeFila;
+    c->pilha.itens = c->fila.itens + s->capacidadeFila;
+    c->pilha.capacidade = s->capacidadePilha;
+    nucleoIniciarPilha(&c->pilha);
+    c->saida = (uint8_t *)(c->pilha.itens + s->capacidadePilha);
+
+    uint8_t saudacao[SERVIDOR_TAM_SAUDACAO] = {'T', 'S', SERVIDOR_VERSAO, (uint8_t)s->capacidadeFila,
+                                               (uint8_t)s->capacidadePilha, (uint8_t)tamanhoTroca};
+    memcpy(c->saida, saudacao, sizeof(saudacao));
+    c->fimSaida = sizeof(saudacao);
+    c->fimSaida += escreverResposta(c->saida + c->fimSaida, &c->fila, &c->pilha, 0, SERVIDOR_EXECUTADA);
+}
+
+static void aceitarConexoes(Servidor *s) {
+    for (;;) {
+        int fd = accept4(s->fdEscuta, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EMFILE || errno == ENFILE) {
+                // Sem descritores: para de escutar até uma conexão fechar
+                struct epoll_event ev = {.events = 0, .data.u32 = SERVIDOR_ID_ESCUTA};
+                epoll_ctl(s->fdEpoll, EPOLL_CTL_MOD, s->fdEscuta, &ev);
+                s->escutaPausada = true;
+            }
+            return;
+        }
+        if (s->numLivres == 0) {
+            close(fd);
+            s->rejeitadas++;
+            continue;
+        }
+
+        int indice = s->livres[--s->numLivres];
+        ConexaoServidor *c = conexaoServidor(s, indice);
+        iniciarConexao(s, c, fd);
+        if (s->transmitindo) transmissaoPublicar(&s->transmissao, indice, &c->fila, &c->pilha);
+        s->aceitas++;
+        s->ativas++;
+        if (s->ativas > s->maxAtivas) s->maxAtivas = s->ativas;
+
+        struct epoll_event ev = {.events = c->eventos, .data.u32 = (uint32_t)indice};
+        if (epoll_ctl(s->fdEpoll, EPOLL_CTL_ADD, fd, &ev) != 0 || !enviarSaida(s, c, indice)) {
+            fecharConexao(s, indice);
+        }
+    }
+}
+
+// --- Servidor: Criação e Laço ---
+
+/**
+ * @brief Cria o socket de escuta em 'caminho'. Um socket velho (de um
+ * servidor que não está mais escutando) é removido; outro arquivo, não.
+ * @return Descritor, ou -1 em caso de erro.
+ */
+static int criarEscuta(const char *caminho) {
+    struct sockaddr_un endereco;
+    if (!enderecoSocket(&endereco, caminho)) return -1;
+
+    struct stat info;
+    if (lstat(caminho, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            fprintf(stderr, "ERRO: '%s' ja existe e nao e um socket.\n", caminho);
+            return -1;
+        }
+        int teste = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool emUso = teste >= 0 && connect(teste, (struct sockaddr *)&endereco, sizeof(endereco)) == 0;
+        if (teste >= 0) close(teste);
+        if (emUso) {
+            fprintf(stderr, "ERRO: Ja existe um servidor escutando em '%s'.\n", caminho);
+            return -1;
+        }
+        unlink(caminho);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr *)&endereco, sizeof(endereco)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        fprintf(stderr, "ERRO: Nao foi possivel escutar em '%s'.\n", caminho);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void liberarServidor(Servidor *s, const char *caminho) {
+    if (s->blocos != NULL) {
+        for (int i = 0; i < s->maxClientes; i++) {
+            ConexaoServidor *c = conexaoServidor(s, i);
+            if (c->ativa) close(c->fd);
+        }
+    }
+    if (s->fdSinais >= 0) close(s->fdSinais);
+    if (s->fdEpoll >= 0) close(s->fdEpoll);
+    if (s->fdEscuta >= 0) {
+        close(s->fdEscuta);
+        unlink(caminho);
+    }
+    if (s->transmitindo) transmissaoFechar(&s->transmissao);
+    free(s->blocos);
+    free(s->livres);
+}
+
+static bool iniciarServidor(Servidor *s, const char *caminho, int maxClientes, int capacidadeFila,
+                            int capacidadePilha, uint64_t semente, const char *transmitir,
+                            sigset_t *mascaraAnterior) {
+    memset(s, 0, sizeof(*s));
+
+    // SIGINT e SIGTERM chegam pelo epoll, para o servidor encerrar limpo (e
+    // remover o socket). O bloqueio vem antes de criar qualquer arquivo: um
+    // sinal no meio da partida não pode matar o processo e deixar o socket para trás
+    sigset_t sinais;
+    sigemptyset(&sinais);
+    sigaddset(&sinais, SIGINT);
+    sigaddset(&sinais, SIGTERM);
+    sigprocmask(SIG_BLOCK, &sinais, mascaraAnterior);
+
+    s->fdEscuta = s->fdEpoll = s->fdSinais = -1;
+    s->capacidadeFila = capacidadeFila;
+    s->capacidadePilha = capacidadePilha;
+    s->semente = semente;
+    s->maxClientes = maxClientes;
+
+    // Bloco: conexão, peças da fila e da pilha, e a saída (linha de cache inteira)
+    s->tamanhoMaxResposta = SERVIDOR_TAM_MAX_RESPOSTA(capacidadeFila, capacidadePilha);
+    s->tamanhoSaida = SERVIDOR_RESPOSTAS_POR_LEITURA * s->tamanhoMaxResposta;
+    size_t pecas = deslocamentoPecas() + (size_t)(capacidadeFila + capacidadePilha) * sizeof(Peca);
+    s->tamanhoBloco = (pecas + s->tamanhoSaida + 63) / 64 * 64;
+
+    if (!garantirDescritores(maxClientes + SERVIDOR_DESCRITORES_EXTRAS)) {
+        fprintf(stderr, "AVISO: O limite de descritores abertos e menor que %d; conexoes alem dele esperam na fila do socket.\n",
+                maxClientes + SERVIDOR_DESCRITORES_EXTRAS);
+    }
+
+    // calloc de um bloco grande vem do mmap: só as páginas tocadas ocupam memória
+    s->blocos = calloc((size_t)maxClientes, s->tamanhoBloco);
+    s->livres = malloc((size_t)maxClientes * sizeof(int));
+    if (s->blocos == NULL || s->livres == NULL) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para %d clientes.\n", maxClientes);
+        return false;
+    }
+    // Os menores índices saem primeiro, mantendo as conexões no começo do vetor
+    for (int i = 0; i < maxClientes; i++) s->livres[i] = maxClientes - 1 - i;
+    s->numLivres = maxClientes;
+
+    if (transmitir != NULL) {
+        if (!transmissaoCriar(&s->transmissao, transmitir, maxClientes, capacidadeFila, capacidadePilha)) return false;
+        s->transmitindo = true;
+    }
+
+    s->fdEscuta = criarEscuta(caminho);
+    if (s->fdEscuta < 0) return false;
+
+    s->fdSinais = signalfd(-1, &sinais, SFD_NONBLOCK | SFD_CLOEXEC);
+    s->fdEpoll = epoll_create1(EPOLL_CLOEXEC);
+    if (s->fdSinais < 0 || s->fdEpoll < 0) {
+        fprintf(stderr, "ERRO: Nao foi possivel criar o epoll do servidor.\n");
+        return false;
+    }
+    struct epoll_event escuta = {.events = EPOLLIN, .data.u32 = SERVIDOR_ID_ESCUTA};
+    struct epoll_event sinal = {.events = EPOLLIN, .data.u32 = SERVIDOR_ID_SINAIS};
+    epoll_ctl(s->fdEpoll, EPOLL_CTL_ADD, s->fdEscuta, &escuta);
+    epoll_ctl(s->fdEpoll, EPOLL_CTL_ADD, s->fdSinais, &sinal);
+    return true;
+}
+
+/**
+ * @brief Modo --servidor: atende os clientes até SIGINT/SIGTERM ou o fim da duração.
+ * @param duracao Segundos de execução (0 = sem limite).
+ * @param transmitir Arquivo onde as sessões são publicadas para espectadores, ou NULL.
+ * @return Código de saída do programa.
+ */
+int executarServidor(const char *caminho, int maxClientes, int capacidadeFila, int capacidadePilha,
+                     uint64_t semente, double duracao, const char *transmitir) {
+    if (capacidadeFila > SERVIDOR_MAX_CAPACIDADE || capacidadePilha > SERVIDOR_MAX_CAPACIDADE ||
+        tamanhoTroca > SERVIDOR_MAX_CAPACIDADE) {
+        fprintf(stderr, "ERRO: No modo servidor, a fila, a pilha e a troca vao ate %d pecas.\n", SERVIDOR_MAX_CAPACIDADE);
+        return 1;
+    }
+
+    Servidor s;
+    sigset_t mascaraAnterior;
+    if (!iniciarServidor(&s, caminho, maxClientes, capacidadeFila, capacidadePilha, semente, transmitir,
+                         &mascaraAnterior)) {
+        liberarServidor(&s, caminho);
+        sigprocmask(SIG_SETMASK, &mascaraAnterior, NULL);
+        return 1;
+    }
+
+    printf("Servidor escutando em '%s' (ate %d clientes, %zu bytes por conexao). Ctrl+C encerra.\n",
+           caminho, maxClientes, s.tamanhoBloco);
+    fflush(stdout);
+
+    struct epoll_event eventos[SERVIDOR_EVENTOS];
+    uint64_t inicio = agoraNs();
+    uint64_t fim = duracao > 0 ? inicio + (uint64_t)(duracao * 1e9) : 0;
+    bool continuar = true;
+
+    while (continuar) {
+        int espera = -1;
+        if (fim != 0) {
+            uint64_t agora = agoraNs();
+            if (agora >= fim) break;
+            espera = (int)((fim - agora + 999999) / 1000000);
+        }
+        int n = epoll_wait(s.fdEpoll, eventos, SERVIDOR_EVENTOS, espera);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "ERRO: Falha ao aguardar eventos (epoll_wait).\n");
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            uint32_t id = eventos[i].data.u32;
+            if (id == SERVIDOR_ID_ESCUTA) {
+                aceitarConexoes(&s);
+                continue;
+            }
+            if (id == SERVIDOR_ID_SINAIS) {
+                // Consome o sinal: senão ele seria entregue ao restaurar a máscara
+                struct signalfd_siginfo info;
+                if (read(s.fdSinais, &info, sizeof(info)) == (ssize_t)sizeof(info)) continuar = false;
+                continue;
+            }
+
+            ConexaoServidor *c = conexaoServidor(&s, (int)id);
+            if (!c->ativa) continue; // Fechada por um evento anterior deste lote
+            bool manter = true;
+            if (eventos[i].events & EPOLLOUT) manter = enviarSaida(&s, c, (int)id);
+            if (manter && (eventos[i].events & EPOLLIN)) manter = atenderConexao(&s, c, (int)id);
+            if (manter && (eventos[i].events & (EPOLLERR | EPOLLHUP)) && !(eventos[i].events & EPOLLIN)) manter = false;
+            if (!manter) fecharConexao(&s, (int)id);
+        }
+    }
+    double decorrido = (double)(agoraNs() - inicio) / 1e9;
+
+    printf("\nServidor: %lld conexoes atendidas (%lld rejeitadas, %lld ainda abertas) | Maximo simultaneo: %lld\n",
+           s.aceitas, s.rejeitadas, s.ativas, s.maxAtivas);
+    printf("Comandos: %lld (%lld executadas, %lld recusadas, %lld invalidos) | Enviados: %.1f MiB\n",
+           s.comandos, s.executadas, s.recusadas, s.invalidos, (double)s.bytesEnviados / (1024.0 * 1024.0));
+    printf("Memoria por conexao: %zu bytes (%.1f MiB para %lld conexoes simultaneas)\n",
+           s.tamanhoBloco, (double)s.tamanhoBloco * (double)s.maxAtivas / (1024.0 * 1024.0), s.maxAtivas);
+    printf("Tempo: %.3f s | Taxa: %.0f comandos/s\n", decorrido, decorrido > 0 ? (double)s.comandos / decorrido : 0.0);
+    // Um sinal ainda pendente só é entregue depois que o socket foi removido
+    liberarServidor(&s, caminho);
+    sigprocmask(SIG_SETMASK, &mascaraAnterior, NULL);
+    return 0;
+}
+
+// --- Cliente de Carga ---
+
+/**
+ * @brief Envia o próximo comando da conexão: uma ação sorteada, o pedido do
+ * estado final ou, depois da conferência, nada (a conexão terminou).
+ * @return false se a conexão terminou ou o envio falhou.
+ */
+static bool enviarComando(Cliente *cliente, ConexaoCliente *c) {
+    uint8_t codigo;
+    if (c->restantes > 0) {
+        codigo = (uint8_t)(1 + (int)(((geradorProximo64(&cliente->sorteio) >> 32) * 5ULL) >> 32));
+        c->restantes--;
+    } else if (!c->conferindo) {
+        codigo = 0;
+        c->conferindo = true;
+    } else {
+        cliente->concluidas++;
+        return false;
+    }
+    c->envio = agoraNs();
+    c->aguardando = true;
+    return send(c->fd, &codigo, 1, MSG_NOSIGNAL) == 1;
+}
+
+/**
+ * @brief Aplica uma resposta ao espelho da sessão; o estado final pedido no
+ * fim é só conferido com o espelho.
+ * @return false se a resposta não bate com o espelho.
+ */
+static bool aplicarResposta(const Cliente *cliente, ConexaoCliente *c, const uint8_t *resposta) {
+    int codigo = resposta[0];
+    int numAlteracoes = resposta[5];
+    bool conferir = codigo == 0 && c->conferindo;
+    bool ok = true;
+
+    if (conferir) {
+        ok = resposta[2] == c->frente && resposta[3] == c->contadorFila && resposta[4] == c->contadorPilha &&
+             numAlteracoes == c->contadorFila + c->contadorPilha;
+    } else {
+        c->frente = resposta[2];
+        c->contadorFila = resposta[3];
+        c->contadorPilha = resposta[4];
+    }
+
+    const uint8_t *p = resposta + SERVIDOR_TAM_CABECALHO;
+    for (int i = 0; i < numAlteracoes; i++, p += SERVIDOR_TAM_ALTERACAO) {
+        int indice = p[0] & ~SERVIDOR_POSICAO_PILHA;
+        bool naPilha = (p[0] & SERVIDOR_POSICAO_PILHA) != 0;
+        if (indice >= (naPilha ? cliente->capacidadePilha : cliente->capacidadeFila)) return false;
+
+        PecaCompacta *posicao = naPilha ? &c->pilha[indice] : &c->fila[indice];
+        if (conferir) {
+            ok = ok && *posicao == lerU32(p + 1);
+        } else {
+            *posicao = lerU32(p + 1);
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Consome as mensagens completas do buffer de entrada.
+ * @return false se a conexão terminou ou houve erro.
+ */
+static bool processarEntrada(Cliente *cliente, ConexaoCliente *c) {
+    uint32_t consumidos = 0;
+    bool manter = true;
+
+    while (manter) {
+        const uint8_t *m = c->entrada + consumidos;
+        uint32_t disponiveis = c->recebidos - consumidos;
+
+        if (!c->saudado) {
+            if (disponiveis < SERVIDOR_TAM_SAUDACAO) break;
+            if (m[0] != 'T' || m[1] != 'S' || m[2] != SERVIDOR_VERSAO ||
+                (cliente->capacidadeFila != 0 && (m[3] != cliente->capacidadeFila || m[4] != cliente->capacidadePilha))) {
+                fprintf(stderr, "ERRO: Saudacao inesperada do servidor.\n");
+                return false;
+            }
+            cliente->capacidadeFila = m[3];
+            cliente->capacidadePilha = m[4];
+            c->saudado = true;
+            consumidos += SERVIDOR_TAM_SAUDACAO;
+            continue;
+        }
+
+        if (disponiveis < SERVIDOR_TAM_CABECALHO) break;
+        uint32_t tamanho = SERVIDOR_TAM_CABECALHO + SERVIDOR_TAM_ALTERACAO * (uint32_t)m[5];
+        if (disponiveis < tamanho) break;
+
+        int codigo = m[0];
+        if (codigo >= 1 && codigo <= 5) {
+            histogramaRegistrar(&cliente->idaEVolta, agoraNs() - c->envio);
+            if (m[1] == SERVIDOR_EXECUTADA) cliente->executadas++; else cliente->recusadas++;
+        }
+        if (!aplicarResposta(cliente, c, m)) cliente->divergencias++;
+        consumidos += tamanho;
+        c->aguardando = false;
+        manter = enviarComando(cliente, c);
+    }
+
+    if (consumidos > 0) {
+        memmove(c->entrada, c->entrada + consumidos, c->recebidos - consumidos);
+        c->recebidos -= consumidos;
+    }
+    return manter;
+}
+
+/**
+ * @brief Modo --cliente: abre numClientes conexões com o servidor em
+ * 'caminho', cada uma enviando um comando por vez (como um jogador) até
+ * completar sua parte das numAcoes ações; no fim, confere o estado de cada
+ * sessão com o espelho montado a partir das respostas.
+ * @return Código de saída do programa.
+ */
+int executarClienteServidor(const char *caminho, int numClientes, long long numAcoes, uint64_t semente) {
+    struct sockaddr_un endereco;
+    if (!enderecoSocket(&endereco, caminho)) return 1;
+    if (!garantirDescritores(numClientes + SERVIDOR_DESCRITORES_EXTRAS)) {
+        fprintf(stderr, "ERRO: O limite de descritores abertos nao permite %d conexoes.\n", numClientes);
+        return 1;
+    }
+
+    Cliente cliente;
+    memset(&cliente, 0, sizeof(cliente));
+    geradorSemear(&cliente.sorteio, semente ^ 0xC0FFEEULL);
+    ConexaoCliente *conexoes = calloc((size_t)numClientes, sizeof(ConexaoCliente));
+    int fdEpoll = epoll_create1(EPOLL_CLOEXEC);
+    if (conexoes == NULL || fdEpoll < 0) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para %d conexoes.\n", numClientes);
+        free(conexoes);
+        if (fdEpoll >= 0) close(fdEpoll);
+        return 1;
+    }
+
+    // Conexões bloqueantes (esperam a vez na fila do socket) e depois sem bloqueio
+    uint64_t inicioConexoes = agoraNs();
+    int abertas = 0;
+    for (; abertas < numClientes; abertas++) {
+        ConexaoCliente *c = &conexoes[abertas];
+        c->restantes = numAcoes / numClientes + (abertas < numAcoes % numClientes ? 1 : 0);
+        c->aguardando = true; // Saudação e estado inicial
+        c->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (c->fd < 0 || connect(c->fd, (struct sockaddr *)&endereco, sizeof(endereco)) != 0) {
+            fprintf(stderr, "ERRO: Nao foi possivel conectar a '%s' (conexao %d).\n", caminho, abertas + 1);
+            if (c->fd >= 0) close(c->fd);
+            break;
+        }
+        fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL) | O_NONBLOCK);
+        struct epoll_event ev = {.events = EPOLLIN, .data.u32 = (uint32_t)abertas};
+        epoll_ctl(fdEpoll, EPOLL_CTL_ADD, c->fd, &ev);
+    }
+    double tempoConexoes = (double)(agoraNs() - inicioConexoes) / 1e9;
+
+    if (abertas < numClientes) {
+        for (int i = 0; i < abertas; i++) close(conexoes[i].fd);
+        close(fdEpoll);
+        free(conexoes);
+        return 1;
+    }
+
+    struct epoll_event eventos[SERVIDOR_EVENTOS];
+    uint64_t inicio = agoraNs();
+
+    int ativas = numClientes;
+    while (ativas > 0) {
+        int n = epoll_wait(fdEpoll, eventos, SERVIDOR_EVENTOS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "ERRO: Falha ao aguardar eventos (epoll_wait).\n");
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            ConexaoCliente *c = &conexoes[eventos[i].data.u32];
+            ssize_t lidos = recv(c->fd, c->entrada + c->recebidos, sizeof(c->entrada) - c->recebidos, 0);
+            if (lidos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue;
+
+            bool manter = lidos > 0;
+            if (manter) {
+                c->recebidos += (uint32_t)lidos;
+                manter = processarEntrada(&cliente, c);
+            }
+            if (!manter) {
+                if (c->aguardando) cliente.perdidas++; // Fechada pelo servidor ou com erro no meio do caminho
+                close(c->fd);
+                ativas--;
+            }
+        }
+    }
+    double decorrido = (double)(agoraNs() - inicio) / 1e9;
+    close(fdEpoll);
+
+    long long acoes = cliente.executadas + cliente.recusadas;
+    printf("Clientes: %d (conectados em %.3f s) | Concluidos: %lld | Perdidos: %lld\n",
+           numClientes, tempoConexoes, cliente.concluidas, cliente.perdidas);
+    printf("Acoes: %lld (%lld executadas, %lld recusadas) | Divergencias do espelho: %lld\n",
+           acoes, cliente.executadas, cliente.recusadas, cliente.divergencias);
+    histogramaExibir(stdout, "Latencia ida e volta", &cliente.idaEVolta);
+    printf("Tempo: %.3f s | Vazao: %.0f acoes/s\n", decorrido, decorrido > 0 ? (double)acoes / decorrido : 0.0);
+
+    free(conexoes);
+    bool ok = cliente.concluidas == numClientes && cliente.divergencias == 0;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+// Servidor local do simulador Mestre (--servidor <caminho>) e cliente de
+// carga que o acompanha (--cliente <caminho>).
+//
+// O servidor escuta em um socket de domínio Unix (SOCK_STREAM) e atende
+// todas as conexões em uma única thread com epoll. Cada conexão é uma sessão
+// independente (FilaPecas + PilhaPecas, semente derivada da semente base e
+// da ordem de chegada), criada ao aceitar a conexão e descartada ao fechá-la.
+//
+// Protocolo (binário, inteiros de 32 bits em little-endian):
+//   Cliente -> servidor: um byte por comando.
+//     1 a 5  ações do menu;
+//     0      pede o estado completo;
+//     outros respondidos como inválidos, sem alterar a sessão.
+//   Servidor -> cliente, ao conectar: saudação de SERVIDOR_TAM_SAUDACAO bytes
+//     { 'T', 'S', SERVIDOR_VERSAO, capacidadeFila, capacidadePilha, tamanhoTroca }
+//   seguida do estado completo (resposta ao código 0).
+//   Uma resposta por comando, na ordem:
+//     cabeçalho de SERVIDOR_TAM_CABECALHO bytes
+//       { codigo, resultado, frente, contadorFila, contadorPilha, numAlteracoes }
+//     e numAlteracoes alterações de SERVIDOR_TAM_ALTERACAO bytes
+//       { posicao, PecaCompacta (peca_compacta.h) }
+//   As posições são físicas: bit 7 ligado = pilha (bits 0-6 = nível, 0 = base),
+//   desligado = fila (bits 0-6 = índice no anel). Só as posições que a ação
+//   escreveu são enviadas (as mesmas de posicoesAfetadas no histórico); o
+//   estado completo traz as 'contadorFila' posições a partir da frente e os
+//   'contadorPilha' níveis da pilha. Por isso as capacidades vão até
+//   SERVIDOR_MAX_CAPACIDADE.
+//
+// Memória por conexão: um bloco fixo com o estado da sessão e o buffer de
+// saída (SERVIDOR_RESPOSTAS_POR_LEITURA respostas do maior tamanho
+// possível), todos em um único vetor alocado na partida. Não há buffer de
+// entrada: o servidor só lê os comandos cujas respostas cabem no buffer de
+// saída, e o resto espera no socket. Um cliente que não lê as respostas
+// deixa de ser lido (EPOLLIN desligado) até esvaziar o buffer.
+//
+// Com --transmitir, cada bloco é também uma sessão da transmissão
+// (transmissao.h): publicada ao conectar e após cada leitura que executou
+// alguma ação, e retirada quando a conexão fecha.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tetris_stack_mestre.h"
+
+// --- Constantes ---
+#define SERVIDOR_VERSAO 1
+#define SERVIDOR_MAX_CAPACIDADE 127        // Posição física em 7 bits
+#define SERVIDOR_MAX_CLIENTES_PADRAO 16384 // Conexões simultâneas (--max-clientes)
+#define SERVIDOR_CLIENTES_PADRAO 100       // Conexões abertas pelo cliente de carga (--clientes)
+#define SERVIDOR_RESPOSTAS_POR_LEITURA 16  // Comandos lidos por vez em uma conexão
+
+#define SERVIDOR_TAM_SAUDACAO 6
+#define SERVIDOR_TAM_CABECALHO 6
+#define SERVIDOR_TAM_ALTERACAO 5
+#define SERVIDOR_POSICAO_PILHA 0x80
+
+// Resultado de um comando (segundo byte do cabeçalho)
+#define SERVIDOR_RECUSADA 0 // Ação recusada (o AVISO do modo interativo)
+#define SERVIDOR_EXECUTADA 1
+#define SERVIDOR_INVALIDO 2 // Código fora de 0 a 5
+
+// Maior resposta possível: estado completo com a fila e a pilha cheias
+#define SERVIDOR_TAM_MAX_RESPOSTA(capFila, capPilha) \
+    (SERVIDOR_TAM_CABECALHO + SERVIDOR_TAM_ALTERACAO * ((capFila) + (capPilha)))
+
+// --- Protótipos das Funções ---
+
+int executarServidor(const char *caminho, int maxClientes, int capacidadeFila, int capacidadePilha,
+                     uint64_t semente, double duracao, const char *transmitir);
+int executarClienteServidor(const char *caminho, int numClientes, long long numAcoes, uint64_t semente);
+
+#endif // SERVIDOR_H
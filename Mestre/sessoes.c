@@ -0,0 +1,488 @@
+#define _POSIX_C_SOURCE 200809L // pthreads, clock_gettime, munmap
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "sessoes.h"
+#include "instantaneo.h"
+#include "tabuleiro.h"
+#include "transmissao.h"
+
+// --- Constantes ---
+#define SESSOES_BLOCO_CARGA 65536 // Ações geradas e enviadas por vez no teste de carga
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Semente de cada sessão, derivada da semente base e do índice.
+ */
+static uint64_t sementeDaSessao(uint64_t sementeBase, SessaoId id) {
+    return sementeBase ^ ((uint64_t)(id + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * @brief Garante espaço para 'necessario' ações em um vetor de AcaoSessao.
+ */
+static bool garantirCapacidade(AcaoSessao **vetor, size_t *capacidade, size_t necessario) {
+    if (necessario <= *capacidade) return true;
+
+    size_t nova = *capacidade ? *capacidade : 1024;
+    while (nova < necessario) nova *= 2;
+
+    AcaoSessao *novoVetor = realloc(*vetor, nova * sizeof(AcaoSessao));
+    if (novoVetor == NULL) return false;
+    *vetor = novoVetor;
+    *capacidade = nova;
+    return true;
+}
+
+// --- Criação e Destruição ---
+
+/**
+ * @brief Aloca o estado de numSessoes sessões e inicializa cada uma com a fila
+ * cheia e a pilha vazia, como em inicializarFila/inicializarPilha.
+ * @return false se os parâmetros forem inválidos ou faltar memória.
+ */
+bool sessoesCriar(GerenciadorSessoes *g, int numSessoes, int capacidadeFila,
+                  int capacidadePilha, uint64_t sementeBase) {
+    memset(g, 0, sizeof(*g));
+    if (numSessoes <= 0 || capacidadeFila <= 0 || capacidadePilha <= 0) return false;
+
+    size_t n = (size_t)numSessoes;
+    g->numSessoes = numSessoes;
+    g->capacidadeFila = capacidadeFila;
+    g->capacidadePilha = capacidadePilha;
+
+    g->itensFila = malloc(n * (size_t)capacidadeFila * sizeof(Peca));
+    g->itensPilha = malloc(n * (size_t)capacidadePilha * sizeof(Peca));
+    g->frente = malloc(n * sizeof(int));
+    g->tras = malloc(n * sizeof(int));
+    g->contador = malloc(n * sizeof(int));
+    g->proximoId = malloc(n * sizeof(int));
+    g->topo = malloc(n * sizeof(int));
+    g->geradores = malloc(n * sizeof(GeradorPecas));
+
+    if (!g->itensFila || !g->itensPilha || !g->frente || !g->tras || !g->contador ||
+        !g->proximoId || !g->topo || !g->geradores) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para %d sessoes.\n", numSessoes);
+        sessoesDestruir(g);
+        return false;
+    }
+
+    for (SessaoId id = 0; id < numSessoes; id++) {
+        FilaPecas fila;
+        PilhaPecas pilha;
+
+        sessoesCarregar(g, id, &fila, &pilha);
+        fila.frente = 0;
+        fila.tras = capacidadeFila - 1;
+        fila.proximo_id = 0;
+        geradorSemear(&fila.gerador, sementeDaSessao(sementeBase, id));
+        gerarPecas(&fila, fila.itens, capacidadeFila);
+        fila.contador = capacidadeFila;
+        pilha.topo = -1;
+        sessoesSalvar(g, id, &fila, &pilha);
+    }
+    return true;
+}
+
+/**
+ * @brief Dá a cada sessão um tabuleiro vazio, onde a ação 1 passa a soltar as peças.
+ * * Os tabuleiros não fazem parte do instantâneo: sessões restauradas
+ * recomeçam com o tabuleiro vazio.
+ */
+bool sessoesLigarTabuleiros(GerenciadorSessoes *g) {
+    g->tabuleiros = calloc((size_t)g->numSessoes, sizeof(Tabuleiro));
+    if (g->tabuleiros == NULL) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para os tabuleiros de %d sessoes.\n", g->numSessoes);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Cria a transmissão em 'caminho', publica todas as sessões e a liga ao
+ * gerenciador: daí em diante, cada ação executada publica a sua sessão.
+ * * Cada sessão tem um único escritor (a thread dona da partição), como o
+ * seqlock da transmissão exige. A transmissão é fechada em sessoesDestruir.
+ */
+bool sessoesLigarTransmissao(GerenciadorSessoes *g, Transmissao *transmissao, const char *caminho) {
+    if (!transmissaoCriar(transmissao, caminho, g->numSessoes, g->capacidadeFila, g->capacidadePilha)) return false;
+    for (SessaoId id = 0; id < g->numSessoes; id++) {
+        FilaPecas fila;
+        PilhaPecas pilha;
+        sessoesCarregar(g, id, &fila, &pilha);
+        transmissaoPublicar(transmissao, id, &fila, &pilha);
+    }
+    g->transmissao = transmissao;
+    return true;
+}
+
+/**
+ * @brief Encerra as threads trabalhadoras (se houver) e libera toda a memória.
+ */
+void sessoesDestruir(GerenciadorSessoes *g) {
+    for (int p = 0; p < g->numParticoes; p++) {
+        ParticaoSessoes *part = &g->particoes[p];
+        pthread_mutex_lock(&part->trava);
+        part->encerrar = true;
+        pthread_cond_signal(&part->temTrabalho);
+        pthread_mutex_unlock(&part->trava);
+        pthread_join(part->thread, NULL);
+
+        pthread_mutex_destroy(&part->trava);
+        pthread_cond_destroy(&part->temTrabalho);
+        pthread_cond_destroy(&part->ociosa);
+        free(part->pendentes);
+        free(part->processando);
+    }
+    free(g->particoes);
+    free(g->envio);
+    free(g->tabuleiros);
+    if (g->transmissao != NULL) transmissaoFechar(g->transmissao);
+
+    if (g->mapa != NULL) {
+        // Estado restaurado de um instantâneo: os vetores apontam para o mapeamento
+        munmap(g->mapa, g->tamanhoMapa);
+    } else {
+        free(g->itensFila);
+        free(g->itensPilha);
+        free(g->frente);
+        free(g->tras);
+        free(g->contador);
+        free(g->proximoId);
+        free(g->topo);
+        free(g->geradores);
+    }
+    memset(g, 0, sizeof(*g));
+}
+
+// --- Acesso Direto por Handle ---
+
+/**
+ * @brief Monta uma FilaPecas/PilhaPecas que aponta para o estado da sessão.
+ * * Os itens não são copiados (a vista aponta para o bloco SoA); os campos
+ * escalares e o gerador são copiados e devem voltar com sessoesSalvar.
+ */
+void sessoesCarregar(GerenciadorSessoes *g, SessaoId id, FilaPecas *fila, PilhaPecas *pilha) {
+    fila->itens = g->itensFila + (size_t)id * (size_t)g->capacidadeFila;
+    fila->capacidade = g->capacidadeFila;
+    fila->frente = g->frente[id];
+    fila->tras = g->tras[id];
+    fila->contador = g->contador[id];
+    fila->proximo_id = g->proximoId[id];
+    fila->gerador = g->geradores[id];
+    fila->canal = NULL;
+    fila->tabuleiro = g->tabuleiros != NULL ? &g->tabuleiros[id] : NULL;
+
+    pilha->itens = g->itensPilha + (size_t)id * (size_t)g->capacidadePilha;
+    pilha->capacidade = g->capacidadePilha;
+    pilha->topo = g->topo[id];
+}
+
+void sessoesSalvar(GerenciadorSessoes *g, SessaoId id, const FilaPecas *fila, const PilhaPecas *pilha) {
+    g->frente[id] = fila->frente;
+    g->tras[id] = fila->tras;
+    g->contador[id] = fila->contador;
+    g->proximoId[id] = fila->proximo_id;
+    g->geradores[id] = fila->gerador;
+    g->topo[id] = pilha->topo;
+}
+
+/**
+ * @brief Aplica a ação 'opcao' (1 a 5) à sessão 'id'.
+ * * Só pode ser chamada quando não há threads trabalhadoras, ou pela
+ * própria thread dona da sessão.
+ * @return true se a ação foi executada, false se foi recusada ou é inválida.
+ */
+bool sessoesAplicar(GerenciadorSessoes *g, SessaoId id, int opcao) {
+    FilaPecas fila;
+    PilhaPecas pilha;
+
+    if (id < 0 || id >= g->numSessoes) return false;
+
+    sessoesCarregar(g, id, &fila, &pilha);
+    bool executada = executarAcao(&fila, &pilha, opcao);
+    sessoesSalvar(g, id, &fila, &pilha);
+    if (executada && g->transmissao != NULL) transmissaoPublicar(g->transmissao, id, &fila, &pilha);
+    return executada;
+}
+
+void sessoesExibir(GerenciadorSessoes *g, SessaoId id) {
+    FilaPecas fila;
+    PilhaPecas pilha;
+
+    if (id < 0 || id >= g->numSessoes) return;
+
+    sessoesCarregar(g, id, &fila, &pilha);
+    printf("\nSessao %d (semente: %llu)", id, (unsigned long long)fila.gerador.semente);
+    exibirEstadoAtual(&fila, &pilha);
+}
+
+// --- Threads Trabalhadoras ---
+
+/**
+ * @brief Laço de uma thread trabalhadora: troca o vetor de pendentes por um
+ * vazio e processa o lote inteiro fora da trava.
+ */
+static void *trabalhadorSessoes(void *arg) {
+    ParticaoSessoes *part = arg;
+    GerenciadorSessoes *g = part->dono;
+
+    pthread_mutex_lock(&part->trava);
+    for (;;) {
+        while (part->numPendentes == 0 && !part->encerrar) {
+            pthread_cond_wait(&part->temTrabalho, &part->trava);
+        }
+        if (part->numPendentes == 0) break; // encerrar sem trabalho pendente
+
+        AcaoSessao *lote = part->pendentes;
+        size_t capLote = part->capPendentes;
+        size_t n = part->numPendentes;
+        part->pendentes = part->processando;
+        part->capPendentes = part->capProcessando;
+        part->processando = lote;
+        part->capProcessando = capLote;
+        part->numPendentes = 0;
+        part->ocupada = true;
+        pthread_mutex_unlock(&part->trava);
+
+        long long executadas = 0;
+        for (size_t i = 0; i < n; i++) {
+            executadas += sessoesAplicar(g, lote[i].sessao, lote[i].opcao);
+        }
+
+        pthread_mutex_lock(&part->trava);
+        part->executadas += executadas;
+        part->recusadas += (long long)n - executadas;
+        part->ocupada = false;
+        if (part->numPendentes == 0) pthread_cond_broadcast(&part->ociosa);
+    }
+    pthread_mutex_unlock(&part->trava);
+    return NULL;
+}
+
+/**
+ * @brief Divide as sessões em partições contíguas e cria uma thread para cada.
+ */
+bool sessoesIniciarTrabalhadores(GerenciadorSessoes *g, int numTrabalhadores) {
+    if (numTrabalhadores < 1) numTrabalhadores = 1;
+    if (numTrabalhadores > SESSOES_MAX_TRABALHADORES) numTrabalhadores = SESSOES_MAX_TRABALHADORES;
+    if (numTrabalhadores > g->numSessoes) numTrabalhadores = g->numSessoes;
+
+    g->particoes = aligned_alloc(_Alignof(ParticaoSessoes),
+                                 (size_t)numTrabalhadores * sizeof(ParticaoSessoes));
+    if (g->particoes == NULL) return false;
+    memset(g->particoes, 0, (size_t)numTrabalhadores * sizeof(ParticaoSessoes));
+
+    g->tamanhoParticao = (g->numSessoes + numTrabalhadores - 1) / numTrabalhadores;
+    for (int p = 0; p < numTrabalhadores; p++) {
+        ParticaoSessoes *part = &g->particoes[p];
+        pthread_mutex_init(&part->trava, NULL);
+        pthread_cond_init(&part->temTrabalho, NULL);
+        pthread_cond_init(&part->ociosa, NULL);
+        part->dono = g;
+
+        if (pthread_create(&part->thread, NULL, trabalhadorSessoes, part) != 0) {
+            pthread_mutex_destroy(&part->trava);
+            pthread_cond_destroy(&part->temTrabalho);
+            pthread_cond_destroy(&part->ociosa);
+            break;
+        }
+        g->numParticoes = p + 1;
+    }
+    return g->numParticoes == numTrabalhadores;
+}
+
+int sessoesParticaoDe(const GerenciadorSessoes *g, SessaoId id) {
+    return id / g->tamanhoParticao;
+}
+
+/**
+ * @brief Distribui um lote de ações entre as partições (uma trava por partição).
+ * * As ações são agrupadas por partição (ordenação por contagem, estável) e
+ * cada grupo é acrescentado de uma vez à fila de pendentes da partição.
+ * Sem threads trabalhadoras, as ações são aplicadas na hora.
+ * Deve ser chamada por uma única thread produtora de cada vez.
+ * A ordem das ações de uma mesma sessão é preservada.
+ * @return false se algum handle for inválido (nada é enviado) ou faltar memória.
+ */
+bool sessoesEnviar(GerenciadorSessoes *g, const AcaoSessao *acoes, size_t n) {
+    size_t inicio[SESSOES_MAX_TRABALHADORES + 1] = {0};
+
+    for (size_t i = 0; i < n; i++) {
+        if (acoes[i].sessao < 0 || acoes[i].sessao >= g->numSessoes) return false;
+    }
+    if (g->numParticoes == 0) {
+        for (size_t i = 0; i < n; i++) sessoesAplicar(g, acoes[i].sessao, acoes[i].opcao);
+        return true;
+    }
+    if (!garantirCapacidade(&g->envio, &g->capEnvio, n)) return false;
+
+    // inicio[p + 1] = quantidade de ações da partição p; depois, somas prefixadas
+    for (size_t i = 0; i < n; i++) inicio[sessoesParticaoDe(g, acoes[i].sessao) + 1]++;
+    for (int p = 0; p < g->numParticoes; p++) inicio[p + 1] += inicio[p];
+
+    size_t posicao[SESSOES_MAX_TRABALHADORES];
+    for (int p = 0; p < g->numParticoes; p++) posicao[p] = inicio[p];
+    for (size_t i = 0; i < n; i++) {
+        g->envio[posicao[sessoesParticaoDe(g, acoes[i].sessao)]++] = acoes[i];
+    }
+
+    for (int p = 0; p < g->numParticoes; p++) {
+        size_t quantidade = inicio[p + 1] - inicio[p];
+        if (quantidade == 0) continue;
+        ParticaoSessoes *part = &g->particoes[p];
+
+        pthread_mutex_lock(&part->trava);
+        if (!garantirCapacidade(&part->pendentes, &part->capPendentes, part->numPendentes + quantidade)) {
+            pthread_mutex_unlock(&part->trava);
+            return false;
+        }
+        memcpy(part->pendentes + part->numPendentes, g->envio + inicio[p], quantidade * sizeof(AcaoSessao));
+        part->numPendentes += quantidade;
+        pthread_cond_signal(&part->temTrabalho);
+        pthread_mutex_unlock(&part->trava);
+    }
+    return true;
+}
+
+/**
+ * @brief Bloqueia até que todas as ações enviadas tenham sido processadas.
+ */
+void sessoesAguardar(GerenciadorSessoes *g) {
+    for (int p = 0; p < g->numParticoes; p++) {
+        ParticaoSessoes *part = &g->particoes[p];
+        pthread_mutex_lock(&part->trava);
+        while (part->numPendentes > 0 || part->ocupada) {
+            pthread_cond_wait(&part->ociosa, &part->trava);
+        }
+        pthread_mutex_unlock(&part->trava);
+    }
+}
+
+void sessoesTotais(GerenciadorSessoes *g, long long *executadas, long long *recusadas) {
+    *executadas = *recusadas = 0;
+    for (int p = 0; p < g->numParticoes; p++) {
+        ParticaoSessoes *part = &g->particoes[p];
+        pthread_mutex_lock(&part->trava);
+        *executadas += part->executadas;
+        *recusadas += part->recusadas;
+        pthread_mutex_unlock(&part->trava);
+    }
+}
+
+// --- Teste de Carga ---
+
+/**
+ * @brief Cria numSessoes sessões, envia numAcoes ações aleatórias (sessão e
+ * código 1 a 5 sorteados) e mede a vazão agregada das threads trabalhadoras.
+ * @param restaurar Instantâneo de onde as sessões são restauradas (número de
+ * sessões e capacidades vêm dele), ou NULL para criá-las.
+ * @param salvar Arquivo onde o instantâneo final é gravado, ou NULL.
+ * @param comTabuleiro Cada sessão ganha um tabuleiro onde as peças jogadas caem.
+ * @param transmitir Arquivo onde as sessões são publicadas para espectadores, ou NULL.
+ * @return 0 em caso de sucesso, 1 em caso de erro.
+ */
+int executarCargaSessoes(int numSessoes, int numTrabalhadores, long long numAcoes,
+                         int capacidadeFila, int capacidadePilha, uint64_t semente,
+                         const char *restaurar, const char *salvar, bool comTabuleiro, const char *transmitir) {
+    GerenciadorSessoes g;
+    Transmissao transmissao;
+    GeradorPecas sorteio;
+    AcaoSessao *bloco = malloc(SESSOES_BLOCO_CARGA * sizeof(AcaoSessao));
+    int status = 0;
+
+    double inicioRestauracao = tempoAtual();
+    if (bloco == NULL ||
+        !(restaurar != NULL ? instantaneoRestaurarSessoes(&g, restaurar)
+                            : sessoesCriar(&g, numSessoes, capacidadeFila, capacidadePilha, semente))) {
+        free(bloco);
+        return 1;
+    }
+    if (restaurar != NULL) {
+        numSessoes = g.numSessoes;
+        capacidadeFila = g.capacidadeFila;
+        capacidadePilha = g.capacidadePilha;
+        printf("Instantaneo restaurado: %d sessoes em %.3f ms\n",
+               numSessoes, (tempoAtual() - inicioRestauracao) * 1e3);
+    }
+    if ((comTabuleiro && !sessoesLigarTabuleiros(&g)) ||
+        (transmitir != NULL && !sessoesLigarTransmissao(&g, &transmissao, transmitir))) {
+        sessoesDestruir(&g);
+        free(bloco);
+        return 1;
+    }
+    if (!sessoesIniciarTrabalhadores(&g, numTrabalhadores)) {
+        fprintf(stderr, "ERRO: Nao foi possivel iniciar %d threads trabalhadoras.\n", numTrabalhadores);
+        sessoesDestruir(&g);
+        free(bloco);
+        return 1;
+    }
+
+    geradorSemear(&sorteio, semente ^ 0xC0FFEEULL);
+    double inicio = tempoAtual();
+
+    for (long long enviadas = 0; enviadas < numAcoes; ) {
+        size_t n = numAcoes - enviadas < SESSOES_BLOCO_CARGA ? (size_t)(numAcoes - enviadas) : SESSOES_BLOCO_CARGA;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t r = geradorProximo64(&sorteio);
+            // Sorteio por multiplicação (sem '%'): parte alta de r * limite
+            bloco[i].sessao = (SessaoId)(((r & 0xFFFFFFFFULL) * (uint64_t)numSessoes) >> 32);
+            bloco[i].opcao = 1 + (int)(((r >> 32) * 5ULL) >> 32);
+        }
+        if (!sessoesEnviar(&g, bloco, n)) {
+            fprintf(stderr, "ERRO: Memoria insuficiente para enviar as acoes as sessoes.\n");
+            status = 1;
+            break;
+        }
+        enviadas += (long long)n;
+    }
+    sessoesAguardar(&g);
+    if (status != 0) {
+        sessoesDestruir(&g);
+        free(bloco);
+        return status;
+    }
+
+    double decorrido = tempoAtual() - inicio;
+    long long executadas, recusadas;
+    sessoesTotais(&g, &executadas, &recusadas);
+
+    size_t bytesPorSessao = (size_t)(capacidadeFila + capacidadePilha) * sizeof(Peca)
+                          + 5 * sizeof(int) + sizeof(GeradorPecas)
+                          + (comTabuleiro ? sizeof(Tabuleiro) : 0);
+    sessoesExibir(&g, 0);
+    printf("Sessoes: %d | Threads: %d | Memoria de estado: %.1f MiB (%zu bytes/sessao)\n",
+           numSessoes, g.numParticoes, (double)bytesPorSessao * numSessoes / (1024.0 * 1024.0), bytesPorSessao);
+    printf("Acoes: %lld (%lld executadas, %lld recusadas)\n", executadas + recusadas, executadas, recusadas);
+    if (g.tabuleiros != NULL) {
+        long long pecas = 0, linhas = 0, partidas = 0;
+        for (SessaoId id = 0; id < numSessoes; id++) {
+            pecas += g.tabuleiros[id].pecas;
+            linhas += g.tabuleiros[id].linhasEliminadas;
+            partidas += g.tabuleiros[id].partidas;
+        }
+        printf("Tabuleiros: %lld pecas colocadas, %lld linhas eliminadas, %lld partidas encerradas\n",
+               pecas, linhas, partidas);
+    }
+    printf("Semente base: %llu\n", (unsigned long long)semente);
+    printf("Tempo: %.6f s | Taxa agregada: %.0f acoes/s\n",
+           decorrido, decorrido > 0 ? (double)(executadas + recusadas) / decorrido : 0.0);
+
+    if (salvar != NULL) {
+        double inicioGravacao = tempoAtual();
+        if (instantaneoSalvarSessoes(&g, salvar)) {
+            printf("Instantaneo salvo em '%s': %d sessoes em %.3f ms\n",
+                   salvar, numSessoes, (tempoAtual() - inicioGravacao) * 1e3);
+        } else {
+            status = 1;
+        }
+    }
+
+    sessoesDestruir(&g);
+    free(bloco);
+    return status;
+}
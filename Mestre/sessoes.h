@@ -0,0 +1,109 @@
+#ifndef SESSOES_H
+#define SESSOES_H
+
+// Gerenciador de várias sessões (partidas) independentes do simulador Mestre.
+//
+// As sessões ficam em layout de estrutura de arrays (SoA): um vetor por campo
+// (frente, tras, contador, topo, ...) e um único bloco contíguo para as peças
+// de todas as filas e outro para as de todas as pilhas. Cada sessão é
+// identificada por um índice (SessaoId).
+//
+// As sessões são divididas em partições contíguas, uma por thread
+// trabalhadora; cada thread é a única a tocar o estado das suas sessões,
+// então não há trava por sessão. As ações chegam às partições em lotes.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "tetris_stack_mestre.h"
+
+// --- Constantes ---
+#define SESSOES_MAX_TRABALHADORES 256 // Limite de threads trabalhadoras
+
+// --- Estruturas de Dados ---
+
+typedef int SessaoId; // Índice da sessão (0 a numSessoes - 1)
+
+// Ação endereçada a uma sessão
+typedef struct {
+    SessaoId sessao;
+    int opcao; // Código do menu (1 a 5)
+} AcaoSessao;
+
+struct GerenciadorSessoes;
+
+// Partição de sessões atendida por uma thread (alinhada à linha de cache)
+typedef struct {
+    _Alignas(64) pthread_mutex_t trava;
+    pthread_cond_t temTrabalho;   // Sinaliza ações pendentes ou encerramento
+    pthread_cond_t ociosa;        // Sinaliza que as ações pendentes acabaram
+    AcaoSessao *pendentes;        // Ações recebidas e ainda não processadas
+    size_t numPendentes;
+    size_t capPendentes;
+    AcaoSessao *processando;      // Lote sendo processado (trocado com 'pendentes')
+    size_t capProcessando;
+    bool ocupada;                 // A thread está processando um lote
+    bool encerrar;                // Pedido de encerramento da thread
+    long long executadas;         // Ações aceitas
+    long long recusadas;          // Ações recusadas (AVISO) ou códigos inválidos
+    pthread_t thread;
+    struct GerenciadorSessoes *dono;
+} ParticaoSessoes;
+
+typedef struct GerenciadorSessoes {
+    int numSessoes;
+    int capacidadeFila;
+    int capacidadePilha;
+
+    // Estado das sessões (SoA)
+    Peca *itensFila;        // numSessoes * capacidadeFila peças
+    Peca *itensPilha;       // numSessoes * capacidadePilha peças
+    int *frente;
+    int *tras;
+    int *contador;
+    int *proximoId;
+    int *topo;
+    GeradorPecas *geradores;
+    struct Tabuleiro *tabuleiros; // Um tabuleiro por sessão (--tabuleiro), ou NULL
+    struct Transmissao *transmissao; // Recebe cada sessão após cada ação executada (--transmitir), ou NULL
+    void *mapa;             // Instantâneo mapeado onde está o estado (instantaneo.h), ou NULL
+    size_t tamanhoMapa;
+
+    // Threads trabalhadoras
+    int numParticoes;
+    int tamanhoParticao;    // Sessões por partição (a última pode ter menos)
+    ParticaoSessoes *particoes;
+    AcaoSessao *envio;      // Rascunho de sessoesEnviar (agrupamento por partição)
+    size_t capEnvio;
+} GerenciadorSessoes;
+
+// --- Protótipos das Funções ---
+
+// Criação e destruição
+bool sessoesCriar(GerenciadorSessoes *g, int numSessoes, int capacidadeFila,
+                  int capacidadePilha, uint64_t sementeBase);
+bool sessoesIniciarTrabalhadores(GerenciadorSessoes *g, int numTrabalhadores);
+bool sessoesLigarTabuleiros(GerenciadorSessoes *g);
+bool sessoesLigarTransmissao(GerenciadorSessoes *g, struct Transmissao *transmissao, const char *caminho);
+void sessoesDestruir(GerenciadorSessoes *g);
+
+// Acesso direto por handle (sem threads trabalhadoras, ou pela própria dona da sessão)
+void sessoesCarregar(GerenciadorSessoes *g, SessaoId id, FilaPecas *fila, PilhaPecas *pilha);
+void sessoesSalvar(GerenciadorSessoes *g, SessaoId id, const FilaPecas *fila, const PilhaPecas *pilha);
+bool sessoesAplicar(GerenciadorSessoes *g, SessaoId id, int opcao);
+void sessoesExibir(GerenciadorSessoes *g, SessaoId id);
+
+// Envio assíncrono para as threads trabalhadoras
+int sessoesParticaoDe(const GerenciadorSessoes *g, SessaoId id);
+bool sessoesEnviar(GerenciadorSessoes *g, const AcaoSessao *acoes, size_t n);
+void sessoesAguardar(GerenciadorSessoes *g);
+void sessoesTotais(GerenciadorSessoes *g, long long *executadas, long long *recusadas);
+
+// Teste de carga (--sessoes)
+int executarCargaSessoes(int numSessoes, int numTrabalhadores, long long numAcoes,
+                         int capacidadeFila, int capacidadePilha, uint64_t semente,
+                         const char *restaurar, const char *salvar, bool comTabuleiro, const char *transmitir);
+
+#endif // SESSOES_H
@@ -0,0 +1,241 @@
+#include <string.h>
+
+#include "tabuleiro.h"
+
+// --- Formas das Peças ---
+
+// Rotações distintas de cada tipo (índices de TIPOS_PECA: 'I', 'O', 'T', 'L')
+static const int NUM_ROTACOES[4] = {2, 1, 4, 4};
+
+#define F TABULEIRO_ALTURA // Fundo das colunas além da largura (nunca definem o pouso)
+
+// Máscaras por linha (de baixo para cima, bit 0 = coluna mais à esquerda),
+// com o fundo e o topo de cada coluna da peça já calculados
+static const FormaPeca FORMAS[4][TABULEIRO_MAX_ROTACOES] = {
+    { // I
+        {{0xF, 0x0, 0x0, 0x0}, 4, 1, {0, 0, 0, 0}, {1, 1, 1, 1}},
+        {{0x1, 0x1, 0x1, 0x1}, 1, 4, {0, F, F, F}, {4, 0, 0, 0}},
+    },
+    { // O
+        {{0x3, 0x3, 0x0, 0x0}, 2, 2, {0, 0, F, F}, {2, 2, 0, 0}},
+    },
+    { // T
+        {{0x7, 0x2, 0x0, 0x0}, 3, 2, {0, 0, 0, F}, {1, 2, 1, 0}},
+        {{0x1, 0x3, 0x1, 0x0}, 2, 3, {0, 1, F, F}, {3, 2, 0, 0}},
+        {{0x2, 0x7, 0x0, 0x0}, 3, 2, {1, 0, 1, F}, {2, 2, 2, 0}},
+        {{0x2, 0x3, 0x2, 0x0}, 2, 3, {1, 0, F, F}, {2, 3, 0, 0}},
+    },
+    { // L
+        {{0x7, 0x4, 0x0, 0x0}, 3, 2, {0, 0, 0, F}, {1, 1, 2, 0}},
+        {{0x3, 0x1, 0x1, 0x0}, 2, 3, {0, 0, F, F}, {3, 1, 0, 0}},
+        {{0x1, 0x7, 0x0, 0x0}, 3, 2, {0, 1, 1, F}, {2, 2, 2, 0}},
+        {{0x2, 0x2, 0x3, 0x0}, 2, 3, {2, 0, F, F}, {3, 3, 0, 0}},
+    },
+};
+
+#undef F
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Recalcula a altura de cada coluna, de cima para baixo.
+ * * Cada linha só contribui com as colunas que ainda não apareceram acima
+ * dela; para quando todas as colunas já têm altura.
+ */
+static void recalcularAlturas(Tabuleiro *tabuleiro) {
+    uint16_t vistas = 0;
+
+    memset(tabuleiro->alturas, 0, sizeof(tabuleiro->alturas));
+    for (int i = TABULEIRO_ALTURA - 1; i >= 0 && vistas != TABULEIRO_LINHA_CHEIA; i--) {
+        unsigned novas = tabuleiro->linhas[i] & (uint16_t)~vistas;
+        vistas |= tabuleiro->linhas[i];
+        while (novas != 0) {
+            tabuleiro->alturas[__builtin_ctz(novas)] = (uint8_t)(i + 1);
+            novas &= novas - 1;
+        }
+    }
+}
+
+/**
+ * @brief Remove as linhas completas a partir de 'primeira' e desce as de cima.
+ * @return Número de linhas removidas.
+ */
+static int eliminarLinhas(Tabuleiro *tabuleiro, int primeira, int ultima) {
+    int cheias = 0;
+    for (int i = primeira; i <= ultima; i++) cheias += tabuleiro->linhas[i] == TABULEIRO_LINHA_CHEIA;
+    if (cheias == 0) return 0;
+
+    int destino = primeira;
+    for (int i = primeira; i < TABULEIRO_ALTURA; i++) {
+        if (tabuleiro->linhas[i] != TABULEIRO_LINHA_CHEIA) tabuleiro->linhas[destino++] = tabuleiro->linhas[i];
+    }
+    memset(&tabuleiro->linhas[destino], 0, (size_t)(TABULEIRO_ALTURA - destino) * sizeof(uint16_t));
+    recalcularAlturas(tabuleiro);
+    return cheias;
+}
+
+/**
+ * @brief Grava a peça na linha de pouso, elimina as linhas completas e
+ * encerra a partida se sobrar algum bloco acima da área visível.
+ */
+static JogadaTabuleiro colocarForma(Tabuleiro *tabuleiro, const FormaPeca *forma, int rotacao,
+                                    int coluna, int linha) {
+    JogadaTabuleiro jogada = {rotacao, coluna, linha, 0, false};
+
+    for (int r = 0; r < forma->altura; r++) {
+        tabuleiro->linhas[linha + r] |= (uint16_t)(forma->linhas[r] << coluna);
+    }
+    for (int c = 0; c < forma->largura; c++) {
+        tabuleiro->alturas[coluna + c] = (uint8_t)(linha + forma->topo[c]);
+    }
+    jogada.eliminadas = eliminarLinhas(tabuleiro, linha, linha + forma->altura - 1);
+    tabuleiro->celulas = (uint8_t)(tabuleiro->celulas + 4 - TABULEIRO_LARGURA * jogada.eliminadas);
+    tabuleiro->linhasEliminadas += jogada.eliminadas;
+    tabuleiro->pecas++;
+
+    // As 4 linhas de folga cabem em uma palavra de 64 bits
+    uint64_t folga;
+    memcpy(&folga, &tabuleiro->linhas[TABULEIRO_ALTURA_VISIVEL], sizeof(folga));
+    if (folga != 0) {
+        long long pecas = tabuleiro->pecas, eliminadas = tabuleiro->linhasEliminadas;
+        long long partidas = tabuleiro->partidas + 1;
+        tabuleiroLimpar(tabuleiro);
+        tabuleiro->pecas = pecas;
+        tabuleiro->linhasEliminadas = eliminadas;
+        tabuleiro->partidas = partidas;
+        jogada.fimPartida = true;
+    }
+    return jogada;
+}
+
+// --- Funções Públicas ---
+
+void tabuleiroLimpar(Tabuleiro *tabuleiro) {
+    memset(tabuleiro, 0, sizeof(*tabuleiro));
+}
+
+int tabuleiroNumRotacoes(int tipo) {
+    return tipo >= 0 && tipo < 4 ? NUM_ROTACOES[tipo] : 0;
+}
+
+/**
+ * @brief Forma da peça 'tipo' (índice em TIPOS_PECA) na rotação pedida, ou NULL.
+ */
+const FormaPeca *tabuleiroForma(int tipo, int rotacao) {
+    if (rotacao < 0 || rotacao >= tabuleiroNumRotacoes(tipo)) return NULL;
+    return &FORMAS[tipo][rotacao];
+}
+
+/**
+ * @brief Verifica se a forma, com a base na 'linha' e a esquerda na 'coluna',
+ * sai do tabuleiro ou ocupa alguma célula já preenchida (um AND por linha).
+ */
+bool tabuleiroColide(const Tabuleiro *tabuleiro, const FormaPeca *forma, int coluna, int linha) {
+    if (coluna < 0 || coluna + forma->largura > TABULEIRO_LARGURA ||
+        linha < 0 || linha + forma->altura > TABULEIRO_ALTURA) {
+        return true;
+    }
+    uint16_t colisao = 0;
+    for (int r = 0; r < forma->altura; r++) {
+        colisao |= tabuleiro->linhas[linha + r] & (uint16_t)(forma->linhas[r] << coluna);
+    }
+    return colisao != 0;
+}
+
+/**
+ * @brief Linha onde a forma pousa quando solta do alto na 'coluna'.
+ * * Usa a altura das colunas: a peça para na primeira linha em que o fundo
+ * de alguma das suas colunas encosta no bloco mais alto daquela coluna.
+ */
+int tabuleiroLinhaPouso(const Tabuleiro *tabuleiro, const FormaPeca *forma, int coluna) {
+    int linha = 0;
+    for (int c = 0; c < forma->largura; c++) {
+        int apoio = tabuleiro->alturas[coluna + c] - forma->fundo[c];
+        if (apoio > linha) linha = apoio;
+    }
+    return linha;
+}
+
+/**
+ * @brief Solta a peça 'tipo' na rotação e coluna pedidas.
+ * @return A jogada feita; linha = -1 se a rotação ou a coluna forem inválidas.
+ */
+JogadaTabuleiro tabuleiroColocar(Tabuleiro *tabuleiro, int tipo, int rotacao, int coluna) {
+    const FormaPeca *forma = tabuleiroForma(tipo, rotacao);
+    if (forma == NULL || coluna < 0 || coluna + forma->largura > TABULEIRO_LARGURA) {
+        return (JogadaTabuleiro){rotacao, coluna, -1, 0, false};
+    }
+    // Com as alturas limitadas à área visível, a peça sempre cabe na folga
+    return colocarForma(tabuleiro, forma, rotacao, coluna, tabuleiroLinhaPouso(tabuleiro, forma, coluna));
+}
+
+/**
+ * @brief Escolhe a posição da peça e a solta (política padrão de jogarPeca).
+ * * Entre todas as rotações e colunas, fica com a que deixa menos buracos
+ * sob a peça e, no empate, com a que termina mais baixa (e mais à esquerda).
+ * O custo, a rotação e a coluna de cada candidata vão em um único inteiro,
+ * então a escolha é um mínimo sem desvios; o pouso sempre olha 4 colunas
+ * (as que sobram da forma têm fundo TABULEIRO_ALTURA e não contam).
+ */
+JogadaTabuleiro tabuleiroSoltarPeca(Tabuleiro *tabuleiro, int tipo) {
+    int numRotacoes = tabuleiroNumRotacoes(tipo);
+    if (numRotacoes == 0) return (JogadaTabuleiro){0, 0, -1, 0, false};
+
+    int alturas[TABULEIRO_LARGURA + 3] = {0};
+    int somaAlturas[TABULEIRO_LARGURA + 1]; // Somas de prefixo, para os buracos de cada janela
+    somaAlturas[0] = 0;
+    for (int c = 0; c < TABULEIRO_LARGURA; c++) {
+        alturas[c] = tabuleiro->alturas[c];
+        somaAlturas[c + 1] = somaAlturas[c] + alturas[c];
+    }
+
+    int melhor = 0x7FFFFFFF; // (custo << 8) | (rotacao << 4) | coluna
+    for (int rotacao = 0; rotacao < numRotacoes; rotacao++) {
+        const FormaPeca *forma = &FORMAS[tipo][rotacao];
+        int largura = forma->largura;
+        int f0 = forma->fundo[0], f1 = forma->fundo[1], f2 = forma->fundo[2], f3 = forma->fundo[3];
+        int somaFundo = 0;
+        for (int c = 0; c < largura; c++) somaFundo += forma->fundo[c];
+
+        for (int coluna = 0; coluna + largura <= TABULEIRO_LARGURA; coluna++) {
+            int a = alturas[coluna] - f0, b = alturas[coluna + 1] - f1;
+            int c = alturas[coluna + 2] - f2, d = alturas[coluna + 3] - f3;
+            int linha = a > b ? a : b;
+            int linha2 = c > d ? c : d;
+            linha = linha > linha2 ? linha : linha2;
+            linha = linha > 0 ? linha : 0;
+
+            // Buracos: células vazias entre o bloco mais alto de cada coluna e o fundo da peça
+            int buracos = largura * linha + somaFundo - (somaAlturas[coluna + largura] - somaAlturas[coluna]);
+            int custo = buracos * TABULEIRO_ALTURA + linha + forma->altura;
+            int candidata = (custo << 8) | (rotacao << 4) | coluna;
+            melhor = candidata < melhor ? candidata : melhor;
+        }
+    }
+
+    int rotacao = (melhor >> 4) & 0xF, coluna = melhor & 0xF;
+    const FormaPeca *forma = &FORMAS[tipo][rotacao];
+    return colocarForma(tabuleiro, forma, rotacao, coluna, tabuleiroLinhaPouso(tabuleiro, forma, coluna));
+}
+
+/**
+ * @brief Pede que a próxima peça solta por tabuleiroJogar vá para esta posição.
+ */
+void tabuleiroPedirPosicao(Tabuleiro *tabuleiro, int rotacao, int coluna) {
+    tabuleiro->temPedido = true;
+    tabuleiro->rotacaoPedida = (uint8_t)rotacao;
+    tabuleiro->colunaPedida = (uint8_t)coluna;
+}
+
+/**
+ * @brief Solta a peça na posição pedida, se houver um pedido válido para
+ * ela, ou na escolhida por tabuleiroSoltarPeca. O pedido é consumido.
+ */
+JogadaTabuleiro tabuleiroJogar(Tabuleiro *tabuleiro, int tipo) {
+    if (tabuleiro->temPedido) {
+        tabuleiro->temPedido = false;
+        JogadaTabuleiro jogada = tabuleiroColocar(tabuleiro, tipo, tabuleiro->rotacaoPedida, tabuleiro->colunaPedida);
+        if (jogada.linha >= 0) return jogada;
+    }
+    return tabuleiroSoltarPeca(tabuleiro, tipo);
+}
@@ -0,0 +1,75 @@
+#ifndef TABULEIRO_H
+#define TABULEIRO_H
+
+// Tabuleiro (campo de jogo) em bitboard do simulador Mestre.
+//
+// Cada linha do tabuleiro é uma máscara de 16 bits (bit c = coluna c, da
+// esquerda para a direita); a linha 0 é a do fundo. As peças também são
+// máscaras por linha, pré-calculadas para cada rotação, então:
+//   - a colisão de uma peça na coluna x e linha y é um AND por linha
+//     (linhas[y + r] & (forma[r] << x)), no máximo 4 linhas;
+//   - uma linha completa é uma comparação com TABULEIRO_LINHA_CHEIA;
+//   - a eliminação de linhas compacta o vetor de palavras.
+// A altura de cada coluna é mantida à parte, para achar a linha de pouso
+// de uma queda sem percorrer o tabuleiro.
+//
+// Com um tabuleiro ligado à fila (fila->tabuleiro), jogarPeca solta a peça
+// retirada da frente da fila com tabuleiroJogar: na posição pedida antes com
+// tabuleiroPedirPosicao (jogador automático) ou, sem pedido, na escolhida
+// por tabuleiroSoltarPeca.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// --- Constantes ---
+#define TABULEIRO_LARGURA 10        // Colunas
+#define TABULEIRO_ALTURA_VISIVEL 20 // Linhas da área de jogo
+#define TABULEIRO_ALTURA 24         // Linhas guardadas (4 de folga acima da área visível)
+#define TABULEIRO_LINHA_CHEIA ((uint16_t)((1u << TABULEIRO_LARGURA) - 1u))
+#define TABULEIRO_MAX_ROTACOES 4
+
+// --- Estruturas de Dados ---
+
+// Uma rotação de uma peça, alinhada à coluna 0 e à linha 0
+typedef struct {
+    uint16_t linhas[4]; // Máscara de cada linha, de baixo para cima
+    uint8_t largura;
+    uint8_t altura;
+    uint8_t fundo[4];   // Linha mais baixa ocupada em cada coluna (TABULEIRO_ALTURA além da largura)
+    uint8_t topo[4];    // Linha mais alta ocupada + 1 em cada coluna da peça
+} FormaPeca;
+
+typedef struct Tabuleiro {
+    uint16_t linhas[TABULEIRO_ALTURA];
+    uint8_t alturas[TABULEIRO_LARGURA]; // Linha livre acima do bloco mais alto de cada coluna
+    uint8_t celulas;                    // Células ocupadas (4 por peça, menos 10 por linha eliminada)
+    long long pecas;                    // Peças colocadas
+    long long linhasEliminadas;
+    long long partidas;                 // Partidas encerradas (tabuleiro transbordou e foi esvaziado)
+    bool temPedido;                     // A próxima peça vai para a posição pedida
+    uint8_t rotacaoPedida;
+    uint8_t colunaPedida;
+} Tabuleiro;
+
+// Resultado da colocação de uma peça
+typedef struct {
+    int rotacao;
+    int coluna;
+    int linha;      // Linha de pouso (da base da peça)
+    int eliminadas; // Linhas completas removidas
+    bool fimPartida;
+} JogadaTabuleiro;
+
+// --- Protótipos das Funções ---
+
+void tabuleiroLimpar(Tabuleiro *tabuleiro);
+int tabuleiroNumRotacoes(int tipo);
+const FormaPeca *tabuleiroForma(int tipo, int rotacao);
+bool tabuleiroColide(const Tabuleiro *tabuleiro, const FormaPeca *forma, int coluna, int linha);
+int tabuleiroLinhaPouso(const Tabuleiro *tabuleiro, const FormaPeca *forma, int coluna);
+JogadaTabuleiro tabuleiroColocar(Tabuleiro *tabuleiro, int tipo, int rotacao, int coluna);
+JogadaTabuleiro tabuleiroSoltarPeca(Tabuleiro *tabuleiro, int tipo);
+void tabuleiroPedirPosicao(Tabuleiro *tabuleiro, int rotacao, int coluna);
+JogadaTabuleiro tabuleiroJogar(Tabuleiro *tabuleiro, int tipo);
+
+#endif // TABULEIRO_H
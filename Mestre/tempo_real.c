@@ -0,0 +1,289 @@
+#define _GNU_SOURCE // ppoll
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "tempo_real.h"
+#include "tabuleiro.h"
+#include "entrada_terminal.h"
+#include "transmissao.h"
+#include "../Comum/anel_circular.h"
+
+// Tecla lida e ainda não aplicada: código da ação (0 = sair) e instante do read()
+typedef struct {
+    int codigo;
+    uint64_t chegada;
+} TeclaPendente;
+
+ANEL_DEFINIR(FilaTeclas, TeclaPendente, TEMPO_REAL_MAX_TECLAS)
+
+// --- Funções Auxiliares ---
+
+static inline uint64_t agoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// --- Histograma ---
+
+/**
+ * @brief Balde do valor: os menores que 2^TEMPO_REAL_BITS_SUB são exatos; os
+ * demais usam a potência de dois e os TEMPO_REAL_BITS_SUB bits seguintes.
+ */
+static inline int baldeLatencia(uint64_t ns) {
+    if (ns < (1u << TEMPO_REAL_BITS_SUB)) return (int)ns;
+    int expoente = 63 - __builtin_clzll(ns);
+    int sub = (int)(ns >> (expoente - TEMPO_REAL_BITS_SUB)) & ((1 << TEMPO_REAL_BITS_SUB) - 1);
+    return ((expoente - TEMPO_REAL_BITS_SUB + 1) << TEMPO_REAL_BITS_SUB) + sub;
+}
+
+/**
+ * @brief Maior valor (ns) que cai no balde.
+ */
+static uint64_t limiteBalde(int balde) {
+    if (balde < (1 << TEMPO_REAL_BITS_SUB)) return (uint64_t)balde;
+    int expoente = (balde >> TEMPO_REAL_BITS_SUB) + TEMPO_REAL_BITS_SUB - 1;
+    uint64_t sub = (uint64_t)(balde & ((1 << TEMPO_REAL_BITS_SUB) - 1));
+    uint64_t base = ((1ULL << TEMPO_REAL_BITS_SUB) + sub) << (expoente - TEMPO_REAL_BITS_SUB);
+    return base + (1ULL << (expoente - TEMPO_REAL_BITS_SUB)) - 1;
+}
+
+void histogramaRegistrar(HistogramaLatencia *h, uint64_t ns) {
+    h->contagem++;
+    h->somaNs += ns;
+    if (ns > h->maxNs) h->maxNs = ns;
+    h->baldes[baldeLatencia(ns)]++;
+}
+
+/**
+ * @brief Limite superior (ns) do balde onde cai o quantil q (0 a 1).
+ */
+uint64_t histogramaPercentil(const HistogramaLatencia *h, double q) {
+    if (h->contagem == 0) return 0;
+    uint64_t alvo = (uint64_t)(q * (double)h->contagem);
+    if (alvo >= h->contagem) alvo = h->contagem - 1;
+    uint64_t acumulado = 0;
+    for (int b = 0; b < TEMPO_REAL_BALDES; b++) {
+        acumulado += h->baldes[b];
+        if (acumulado > alvo) {
+            uint64_t limite = limiteBalde(b);
+            return limite < h->maxNs ? limite : h->maxNs;
+        }
+    }
+    return h->maxNs;
+}
+
+// --- Entrada ---
+
+/**
+ * @brief Lê o que estiver disponível na entrada e enfileira as teclas reconhecidas.
+ * @return Teclas lidas, ou -1 no fim da entrada (ou erro de leitura).
+ */
+static int lerTeclas(EntradaTerminal *entrada, FilaTeclas *teclas, RelatorioTempoReal *relatorio) {
+    int codigos[ENTRADA_MAX_BYTES];
+    int n = entradaLer(entrada, codigos, ENTRADA_MAX_BYTES);
+    uint64_t chegada = agoraNs();
+    for (int i = 0; i < n; i++) {
+        if (!FilaTeclas_inserir(teclas, (TeclaPendente){codigos[i], chegada})) relatorio->teclasDescartadas++;
+    }
+    return n;
+}
+
+/**
+ * @brief Espera até o prazo, lendo as teclas que chegarem nesse meio tempo.
+ * * Dorme em ppoll até 'margem' ns antes do prazo e gira o resto.
+ * No fim da entrada, *aberta passa a false e a entrada deixa de ser observada.
+ */
+static void esperarPrazo(uint64_t prazo, uint64_t margem, EntradaTerminal *entrada, bool *aberta,
+                         FilaTeclas *teclas, RelatorioTempoReal *relatorio) {
+    for (;;) {
+        uint64_t agora = agoraNs();
+        if (agora + margem >= prazo) break;
+        uint64_t resta = prazo - margem - agora;
+        struct timespec limite = {(time_t)(resta / 1000000000ULL), (long)(resta % 1000000000ULL)};
+        struct pollfd observada = {.fd = *aberta ? entrada->fd : -1, .events = POLLIN};
+        if (ppoll(&observada, 1, &limite, NULL) > 0) {
+            int n = (observada.revents & POLLNVAL) ? -1 : lerTeclas(entrada, teclas, relatorio);
+            // Terminal desligado: POLLHUP sem dados (em modo bruto, read devolve 0 sem fim)
+            if (n < 0 || (n == 0 && (observada.revents & (POLLHUP | POLLIN)) == POLLHUP)) *aberta = false;
+        }
+    }
+    while (agoraNs() < prazo) {
+        // Espera ativa curta: o prazo está a menos de 'margem'
+    }
+}
+
+// --- Laço ---
+
+/**
+ * @brief Executa o laço em tempo real até '0'/'q', o fim da entrada (sem
+ * duração) ou o fim da duração, e preenche o relatório.
+ * @return false se a configuração for inválida ou o terminal não puder ser configurado.
+ */
+bool tempoRealExecutar(FilaPecas *fila, PilhaPecas *pilha, const ConfigTempoReal *config,
+                       RelatorioTempoReal *relatorio) {
+    memset(relatorio, 0, sizeof(*relatorio));
+    if (config->hz <= 0 || config->quedaMs <= 0 || config->duracao < 0 || config->margemUs < 0) return false;
+
+    uint64_t periodo = 1000000000ULL / (uint64_t)config->hz;
+    uint64_t passosPorQueda = ((uint64_t)config->quedaMs * 1000000ULL + periodo / 2) / periodo;
+    if (passosPorQueda == 0) passosPorQueda = 1;
+    uint64_t margem = (uint64_t)config->margemUs * 1000ULL;
+
+    FilaTeclas teclas;
+    FilaTeclas_inicializar(&teclas);
+    uint64_t chegadas[TEMPO_REAL_MAX_TECLAS]; // Teclas aplicadas no passo, para a latência
+    char rodape[128];
+    EntradaTerminal entrada;
+    if (!entradaAbrir(&entrada, config->fdEntrada)) {
+        fprintf(stderr, "ERRO: Nao foi possivel colocar o terminal em modo de teclas.\n");
+        return false;
+    }
+    bool aberta = true;
+
+    // Peça em queda: a da frente da fila, a 'altura' linhas do fundo
+    int idQueda = -1;
+    int altura = TABULEIRO_ALTURA_VISIVEL;
+    uint64_t passosAteDescer = passosPorQueda;
+
+    uint64_t inicio = agoraNs();
+    uint64_t fim = config->duracao > 0 ? inicio + (uint64_t)(config->duracao * 1e9) : UINT64_MAX;
+    uint64_t prazo = inicio;
+    bool mudou = true; // O primeiro passo emite o quadro inicial
+    bool sair = false;
+
+    while (!sair) {
+        esperarPrazo(prazo, margem, &entrada, &aberta, &teclas, relatorio);
+        uint64_t acordou = agoraNs();
+        histogramaRegistrar(&relatorio->atrasoAcordar, acordou - prazo);
+        relatorio->passos++;
+
+        // 1. Teclas lidas desde o passo anterior, em ordem
+        int numAplicadas = 0;
+        TeclaPendente tecla;
+        while (!sair && FilaTeclas_remover(&teclas, &tecla)) {
+            if (tecla.codigo == 0) {
+                sair = true;
+                break;
+            }
+            if (!executarAcao(fila, pilha, tecla.codigo)) relatorio->teclasRecusadas++;
+            relatorio->teclas++;
+            chegadas[numAplicadas++] = tecla.chegada;
+        }
+
+        // 2. Gravidade: uma nova peça na frente recomeça do alto
+        if (!nucleoFilaVazia(fila)) {
+            if (fila->itens[fila->frente].id != idQueda) {
+                idQueda = fila->itens[fila->frente].id;
+                altura = TABULEIRO_ALTURA_VISIVEL;
+                passosAteDescer = passosPorQueda;
+                mudou = true;
+            } else if (--passosAteDescer == 0) {
+                passosAteDescer = passosPorQueda;
+                mudou = true;
+                if (--altura == 0) {
+                    jogarPeca(fila);
+                    relatorio->quedas++;
+                    idQueda = fila->itens[fila->frente].id;
+                    altura = TABULEIRO_ALTURA_VISIVEL;
+                }
+            }
+        }
+
+        // 3. Quadro: toda tecla aplicada gera um, para que a latência seja medida
+        if (mudou || numAplicadas > 0) {
+            int n = nucleoFilaVazia(fila)
+                ? snprintf(rodape, sizeof(rodape), "Passo %lld | Fila vazia\n", relatorio->passos)
+                : snprintf(rodape, sizeof(rodape), "Passo %lld | Peca em queda: [%c %d] a %d linha(s) do fundo\n",
+                           relatorio->passos, fila->itens[fila->frente].nome, fila->itens[fila->frente].id, altura);
+            exibirEstadoComRodape(fila, pilha, rodape, (size_t)n);
+            if (config->transmissao != NULL) transmissaoPublicar(config->transmissao, 0, fila, pilha);
+            uint64_t emitido = agoraNs();
+            relatorio->quadros++;
+            for (int i = 0; i < numAplicadas; i++) {
+                histogramaRegistrar(&relatorio->latenciaTecla, emitido - chegadas[i]);
+            }
+            mudou = false;
+        }
+
+        if (acordou >= fim || (!aberta && config->duracao == 0 && FilaTeclas_vazio(&teclas))) sair = true;
+
+        // 4. Próximo prazo; muito atrasado, o laço recomeça do instante atual
+        prazo += periodo;
+        uint64_t agora = agoraNs();
+        if (agora > prazo) {
+            relatorio->passosAtrasados++;
+            uint64_t perdidos = (agora - prazo) / periodo;
+            if (perdidos > TEMPO_REAL_MAX_ATRASO_PASSOS) {
+                relatorio->passosPerdidos += (long long)perdidos;
+                prazo += perdidos * periodo;
+            }
+        }
+    }
+
+    relatorio->decorrido = (double)(agoraNs() - inicio) / 1e9;
+    entradaFechar(&entrada);
+    return true;
+}
+
+// --- Relatório ---
+
+/**
+ * @brief Uma linha com a média, os percentis e o máximo do histograma, em us.
+ */
+void histogramaExibir(FILE *saida, const char *nome, const HistogramaLatencia *h) {
+    if (h->contagem == 0) {
+        fprintf(saida, "%s: sem amostras\n", nome);
+        return;
+    }
+    fprintf(saida, "%s (us): media %.1f | p50 %.1f | p90 %.1f | p99 %.1f | p99.9 %.1f | max %.1f\n", nome,
+            (double)h->somaNs / (double)h->contagem / 1e3,
+            (double)histogramaPercentil(h, 0.50) / 1e3, (double)histogramaPercentil(h, 0.90) / 1e3,
+            (double)histogramaPercentil(h, 0.99) / 1e3, (double)histogramaPercentil(h, 0.999) / 1e3,
+            (double)h->maxNs / 1e3);
+}
+
+void tempoRealExibirRelatorio(FILE *saida, const ConfigTempoReal *config, const RelatorioTempoReal *relatorio) {
+    const RelatorioTempoReal *r = relatorio;
+    fprintf(saida, "\nTempo real: %d passos/s (periodo %.3f ms) | Queda: %d ms | Espera ativa: %d us\n",
+            config->hz, 1e3 / config->hz, config->quedaMs, config->margemUs);
+    fprintf(saida, "Passos: %lld | Atrasados: %lld | Perdidos: %lld | Quadros: %lld\n",
+            r->passos, r->passosAtrasados, r->passosPerdidos, r->quadros);
+    fprintf(saida, "Teclas: %lld (%lld recusadas, %lld descartadas) | Pecas jogadas pela gravidade: %lld\n",
+            r->teclas, r->teclasRecusadas, r->teclasDescartadas, r->quedas);
+    histogramaExibir(saida, "Atraso ao acordar", &r->atrasoAcordar);
+    histogramaExibir(saida, "Latencia tecla -> quadro", &r->latenciaTecla);
+    fprintf(saida, "Tempo: %.3f s | Taxa: %.1f passos/s\n",
+            r->decorrido, r->decorrido > 0 ? (double)r->passos / r->decorrido : 0.0);
+}
+
+/**
+ * @brief Modo --tempo-real: teclas da entrada padrão, quadros na saída padrão
+ * e o relatório na saída de erro (os quadros podem ser descartados sem perdê-lo).
+ * @return Código de saída do programa.
+ */
+int executarTempoReal(FilaPecas *fila, PilhaPecas *pilha, int hz, int quedaMs, double duracao, int margemUs,
+                      struct Transmissao *transmissao) {
+    ConfigTempoReal config = {hz, quedaMs, duracao, margemUs, STDIN_FILENO, transmissao};
+    RelatorioTempoReal *relatorio = malloc(sizeof(RelatorioTempoReal));
+    if (relatorio == NULL) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para o relatorio do modo em tempo real.\n");
+        return 1;
+    }
+
+    fprintf(stderr, "Tempo real: teclas 1 a 5 (ou setas e espaco) executam as acoes; 0, q ou Ctrl+C encerra.\n");
+    bool silencioso = modoSilencioso;
+    modoSilencioso = true;
+    bool ok = tempoRealExecutar(fila, pilha, &config, relatorio);
+    modoSilencioso = silencioso;
+
+    if (ok) tempoRealExibirRelatorio(stderr, &config, relatorio);
+    free(relatorio);
+    return ok ? 0 : 1;
+}
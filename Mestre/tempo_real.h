@@ -0,0 +1,91 @@
+#ifndef TEMPO_REAL_H
+#define TEMPO_REAL_H
+
+// Laço em tempo real do simulador Mestre (--tempo-real HZ).
+//
+// A simulação avança em passos fixos de 1/HZ s. O prazo de cada passo é
+// absoluto (inicio + k * periodo, em CLOCK_MONOTONIC), então o atraso de um
+// passo não se acumula nos seguintes. Entre dois passos a thread espera em
+// ppoll pela entrada até uma margem antes do prazo e gira o resto: o ppoll
+// sozinho acorda com o atraso do escalonador, e a espera ativa curta acerta
+// o prazo desde que esse atraso caiba na margem (--espera-ativa US).
+//
+// A cada passo:
+//   - as teclas lidas desde o passo anterior são aplicadas, em ordem (teclas
+//     e códigos de entrada_terminal.h; no terminal, em modo bruto);
+//   - a gravidade: a peça da frente da fila desce uma linha a cada 'quedaMs';
+//     ao chegar ao fundo ela é jogada (ação 1) e a reposição automática traz
+//     a próxima peça da fila;
+//   - se algo mudou, o quadro é emitido (exibirEstadoComRodape) e, com
+//     --transmitir, a sessão é publicada para os espectadores.
+//
+// Medições (histogramas de memória fixa, baldes log-lineares):
+//   - atraso ao acordar: instante em que o passo começa menos o seu prazo;
+//   - latência tecla -> quadro: do read() que trouxe a tecla até o fim da
+//     escrita do quadro que mostra o resultado (inclui a espera pelo passo).
+// O instante em que a tecla foi pressionada não é visível ao processo; em
+// modo bruto, o read() acontece assim que o terminal entrega a tecla.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "tetris_stack_mestre.h"
+
+// --- Constantes ---
+#define TEMPO_REAL_HZ_PADRAO 60
+#define TEMPO_REAL_QUEDA_PADRAO_MS 500     // Intervalo entre duas descidas da peça (--queda)
+#define TEMPO_REAL_MARGEM_PADRAO_US 200   // Espera ativa nos últimos 200 us antes do prazo
+#define TEMPO_REAL_MAX_ATRASO_PASSOS 8     // Além disso o laço desiste de alcançar os prazos perdidos
+#define TEMPO_REAL_MAX_TECLAS 256          // Teclas lidas e ainda não aplicadas
+
+// Histograma: valores < 2^TEMPO_REAL_BITS_SUB ns exatos; acima, 2^TEMPO_REAL_BITS_SUB
+// baldes por potência de dois (erro relativo <= 1/32)
+#define TEMPO_REAL_BITS_SUB 5
+#define TEMPO_REAL_BALDES ((64 - TEMPO_REAL_BITS_SUB + 1) << TEMPO_REAL_BITS_SUB)
+
+// --- Estruturas de Dados ---
+
+typedef struct {
+    uint64_t contagem;
+    uint64_t somaNs;
+    uint64_t maxNs;
+    uint32_t baldes[TEMPO_REAL_BALDES];
+} HistogramaLatencia;
+
+typedef struct {
+    int hz;             // Passos por segundo
+    int quedaMs;        // Intervalo entre duas descidas da peça em queda
+    double duracao;     // Segundos de execução (0 = até '0'/'q' ou o fim da entrada)
+    int margemUs;       // Espera ativa antes de cada prazo (0 = só ppoll)
+    int fdEntrada;      // Descritor de onde as teclas são lidas
+    struct Transmissao *transmissao; // Sessão publicada a cada quadro (transmissao.h), ou NULL
+} ConfigTempoReal;
+
+typedef struct {
+    long long passos;          // Passos simulados
+    long long passosAtrasados; // Passos que terminaram depois do prazo do seguinte
+    long long passosPerdidos;  // Passos descartados ao desistir de alcançar o relógio
+    long long quadros;         // Quadros emitidos
+    long long teclas;          // Teclas aplicadas (códigos 1 a 5)
+    long long teclasRecusadas; // Ações recusadas (AVISO)
+    long long teclasDescartadas; // Teclas perdidas com o buffer de teclas cheio
+    long long quedas;          // Peças jogadas pela gravidade
+    double decorrido;          // Segundos entre o primeiro e o último passo
+    HistogramaLatencia atrasoAcordar;
+    HistogramaLatencia latenciaTecla;
+} RelatorioTempoReal;
+
+// --- Protótipos das Funções ---
+
+void histogramaRegistrar(HistogramaLatencia *h, uint64_t ns);
+uint64_t histogramaPercentil(const HistogramaLatencia *h, double q);
+void histogramaExibir(FILE *saida, const char *nome, const HistogramaLatencia *h);
+
+bool tempoRealExecutar(FilaPecas *fila, PilhaPecas *pilha, const ConfigTempoReal *config,
+                       RelatorioTempoReal *relatorio);
+void tempoRealExibirRelatorio(FILE *saida, const ConfigTempoReal *config, const RelatorioTempoReal *relatorio);
+int executarTempoReal(FilaPecas *fila, PilhaPecas *pilha, int hz, int quedaMs, double duracao, int margemUs,
+                      struct Transmissao *transmissao);
+
+#endif // TEMPO_REAL_H
@@ -1,62 +1,63 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime (CLOCK_MONOTONIC)
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+
+#include <unistd.h>
+
+#include "tetris_stack_mestre.h"
+#include "sessoes.h"
+#include "canal_pecas.h"
+#include "diario_acoes.h"
+#include "instantaneo.h"
+#include "historico_acoes.h"
+#include "estatisticas_acoes.h"
+#include "tabuleiro.h"
+#include "jogador_automatico.h"
+#include "planejador.h"
+#include "analisador_pecas.h"
+#include "tempo_real.h"
+#include "servidor.h"
+#include "transmissao.h"
+#include "peca_compacta.h"
+#include "../Comum/anel_circular.h"
+#include "buffer_quadro.h"
 
 // --- Constantes ---
-#define MAX_FILA 5   // Capacidade máxima da Fila de Peças Futuras
-#define MAX_PILHA 3  // Capacidade máxima da Pilha de Reserva
+#define TAM_BUFFER_LOTE 65536 // Bytes lidos por vez do roteiro de ações no modo em lote
+#define TAM_LINHA_COMANDOS 4096 // Bytes lidos por vez no modo interativo
 
-// --- Estruturas de Dados ---
+// --- Configuração Global ---
 
-// Estrutura para representar uma peça
-typedef struct {
-    char nome; // Tipo da peça ('I', 'O', 'T', 'L')
-    int id;    // Identificador único da peça
-} Peca;
+bool modoSilencioso = false;
+int tamanhoTroca = N_TROCA;
 
-// Estrutura para a Fila Circular (FIFO)
-typedef struct {
-    Peca itens[MAX_FILA];
-    int frente;   // Índice da frente (remoção)
-    int tras;     // Índice do final (inserção)
-    int contador; // Número atual de elementos
-    int proximo_id; // Contador para gerar IDs únicos
-} FilaPecas;
-
-// Estrutura para a Pilha Linear (LIFO)
+// --- Renderização ---
+
+// Buffers reaproveitados entre quadros pela exibição do estado e do menu.
 typedef struct {
-    Peca itens[MAX_PILHA];
-    int topo;     // Índice do topo (-1 para pilha vazia)
-} PilhaPecas;
-
-// --- Protótipos das Funções ---
-
-// Funções de Utilitários e Inicialização
-Peca gerarPeca(FilaPecas *fila);
-void exibirEstadoAtual(FilaPecas *fila, PilhaPecas *pilha);
-void inicializarFila(FilaPecas *fila);
-void inicializarPilha(PilhaPecas *pilha);
-
-// Funções de Operações Básicas (Fila)
-bool estaCheiaFila(FilaPecas *fila);
-bool estaVaziaFila(FilaPecas *fila);
-void enqueue(FilaPecas *fila, Peca novaPeca);
-Peca dequeue(FilaPecas *fila);
-
-// Funções de Operações Básicas (Pilha)
-bool estaCheiaPilha(PilhaPecas *pilha);
-bool estaVaziaPilha(PilhaPecas *pilha);
-void push(PilhaPecas *pilha, Peca peca);
-Peca pop(PilhaPecas *pilha);
-int getTamanhoPilha(PilhaPecas *pilha);
-
-// Funções de Lógica do Jogo (Ações do Usuário)
-void jogarPeca(FilaPecas *fila);
-void reservarPeca(FilaPecas *fila, PilhaPecas *pilha);
-void usarPecaReservada(PilhaPecas *pilha);
-void trocarPecaSimples(FilaPecas *fila, PilhaPecas *pilha);
-void trocarPecaMultipla(FilaPecas *fila, PilhaPecas *pilha);
+    BufferQuadro quadro;        // Quadro completo a ser emitido
+    BufferQuadro secaoFila;     // Seção da fila no quadro atual
+    BufferQuadro secaoPilha;    // Seção da pilha no quadro atual
+    BufferQuadro anteriorFila;  // Seção da fila no último quadro emitido
+    BufferQuadro anteriorPilha; // Seção da pilha no último quadro emitido
+    BufferQuadro secaoTabuleiro;    // Seção do tabuleiro no quadro atual (--tabuleiro)
+    BufferQuadro anteriorTabuleiro; // Seção do tabuleiro no último quadro emitido
+    bool temAnterior;           // Já houve um quadro completo
+    bool menuExibido;           // O menu completo já foi emitido
+    bool modoDiferencial;       // Emite apenas as seções que mudaram (--diferencial)
+    bool opcoesHistorico;       // O menu inclui desfazer e refazer (--historico)
+} Renderizador;
+
+static Renderizador renderizador;
+
+// Transmissão da sessão principal (--transmitir), ou NULL
+static Transmissao *transmissaoPrincipal = NULL;
 
 // --- Implementação das Funções Utilitárias e de Inicialização ---
 
@@ -67,140 +68,310 @@ void trocarPecaMultipla(FilaPecas *fila, PilhaPecas *pilha);
  */
 Peca gerarPeca(FilaPecas *fila) {
     Peca novaPeca;
-    const char tipos[] = {'I', 'O', 'T', 'L'};
-    int num_tipos = sizeof(tipos) / sizeof(tipos[0]);
-    
-    // Sorteia um tipo de peça
-    novaPeca.nome = tipos[rand() % num_tipos];
+
+    // Com um canal ligado, a peça já foi gerada pela thread produtora
+    if (fila->canal != NULL) {
+        novaPeca = canalReceber(fila->canal);
+        fila->proximo_id = novaPeca.id + 1;
+        return novaPeca;
+    }
     
-    // Atribui e incrementa o ID único
-    novaPeca.id = fila->proximo_id++;
+    // Sorteia um tipo de peça e atribui o próximo ID único
+    return nucleoCriarPeca(fila, geradorSortearTipo(&fila->gerador));
+}
+
+/**
+ * @brief Gera n peças de uma vez, na mesma sequência que n chamadas a gerarPeca.
+ * @param destino Vetor com espaço para n peças.
+ */
+void gerarPecas(FilaPecas *fila, Peca *destino, int n) {
+    GeradorPecas *gerador = &fila->gerador;
+    int i = 0;
+
+    // Consome primeiro os tipos que sobraram na reserva do gerador
+    while (i < n && gerador->tiposRestantes > 0) {
+        destino[i++] = gerarPeca(fila);
+    }
+
+    // Cada saída de 64 bits rende GERADOR_TIPOS_POR_SAIDA peças
+    int id = fila->proximo_id;
+    for (; n - i >= GERADOR_TIPOS_POR_SAIDA; i += GERADOR_TIPOS_POR_SAIDA) {
+        uint64_t bits = geradorProximo64(gerador);
+        for (int j = 0; j < GERADOR_TIPOS_POR_SAIDA; j++) {
+            destino[i + j].nome = TIPOS_PECA[bits & (GERADOR_NUM_TIPOS - 1)];
+            bits >>= GERADOR_BITS_TIPO;
+            destino[i + j].id = id + j;
+        }
+        id += GERADOR_TIPOS_POR_SAIDA;
+    }
+    fila->proximo_id = id;
+
+    // O restante passa pela reserva, mantendo a sequência de gerarPeca
+    while (i < n) {
+        destino[i++] = gerarPeca(fila);
+    }
+}
+
+/**
+ * @brief Sugere uma semente quando o usuário não informa --semente.
+ * * A semente usada é sempre exibida para que a sessão possa ser reproduzida.
+ */
+uint64_t gerarSemente(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ((uint64_t)ts.tv_sec << 30) ^ (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Monta a seção da Fila (cabeçalho e peças da frente ao final).
+ */
+static void renderizarFila(BufferQuadro *buffer, FilaPecas *fila) {
+    bufferLimpar(buffer);
+    bufferAcrescentarTexto(buffer, "Fila de pecas futuras (Capacidade: ");
+    bufferAcrescentarInt(buffer, fila->capacidade);
+    bufferAcrescentarTexto(buffer, " | Ocupacao: ");
+    bufferAcrescentarInt(buffer, fila->contador);
+    bufferAcrescentarTexto(buffer, "):\nFila (Frente -> Final): ");
     
-    return novaPeca;
+    if (estaVaziaFila(fila)) {
+        bufferAcrescentarTexto(buffer, "[VAZIA]\n");
+        return;
+    }
+
+    int i = fila->frente;
+    for (int exibidos = 0; exibidos < fila->contador; exibidos++) {
+        if (exibidos > 0) bufferAcrescentarChar(buffer, ' ');
+        bufferAcrescentarChar(buffer, '[');
+        bufferAcrescentarChar(buffer, fila->itens[i].nome);
+        bufferAcrescentarChar(buffer, ' ');
+        bufferAcrescentarInt(buffer, fila->itens[i].id);
+        bufferAcrescentarChar(buffer, ']');
+        i = ANEL_AVANCAR_DINAMICO(i, fila->capacidade); // Avança circularmente
+    }
+    bufferAcrescentarChar(buffer, '\n');
 }
 
 /**
- * @brief Exibe o estado atual da Fila e da Pilha.
+ * @brief Monta a seção da Pilha (cabeçalho e peças do topo à base).
+ */
+static void renderizarPilha(BufferQuadro *buffer, PilhaPecas *pilha) {
+    bufferLimpar(buffer);
+    bufferAcrescentarTexto(buffer, "Pilha de reserva (Capacidade: ");
+    bufferAcrescentarInt(buffer, pilha->capacidade);
+    bufferAcrescentarTexto(buffer, " | Ocupacao: ");
+    bufferAcrescentarInt(buffer, getTamanhoPilha(pilha));
+    bufferAcrescentarTexto(buffer, "):\nPilha (Topo -> Base): ");
+
+    if (estaVaziaPilha(pilha)) {
+        bufferAcrescentarTexto(buffer, "[VAZIA]\n");
+        return;
+    }
+
+    // Exibe do topo (pilha->topo) até a base (0)
+    for (int i = pilha->topo; i >= 0; i--) {
+        bufferAcrescentarChar(buffer, '[');
+        bufferAcrescentarChar(buffer, pilha->itens[i].nome);
+        bufferAcrescentarChar(buffer, ' ');
+        bufferAcrescentarInt(buffer, pilha->itens[i].id);
+        bufferAcrescentarChar(buffer, ']');
+        if (i > 0) bufferAcrescentarChar(buffer, ' ');
+    }
+    bufferAcrescentarChar(buffer, '\n');
+}
+
+/**
+ * @brief Monta a seção do Tabuleiro (área visível de cima para baixo e contadores).
+ */
+static void renderizarTabuleiro(BufferQuadro *buffer, const Tabuleiro *tabuleiro) {
+    bufferLimpar(buffer);
+    bufferAcrescentarTexto(buffer, "Tabuleiro (Pecas: ");
+    bufferAcrescentarInt(buffer, tabuleiro->pecas);
+    bufferAcrescentarTexto(buffer, " | Linhas: ");
+    bufferAcrescentarInt(buffer, tabuleiro->linhasEliminadas);
+    bufferAcrescentarTexto(buffer, " | Partidas encerradas: ");
+    bufferAcrescentarInt(buffer, tabuleiro->partidas);
+    bufferAcrescentarTexto(buffer, "):\n");
+
+    for (int i = TABULEIRO_ALTURA_VISIVEL - 1; i >= 0; i--) {
+        uint16_t linha = tabuleiro->linhas[i];
+        bufferAcrescentarChar(buffer, '|');
+        for (int c = 0; c < TABULEIRO_LARGURA; c++) {
+            bufferAcrescentarChar(buffer, (linha >> c) & 1u ? '#' : '.');
+        }
+        bufferAcrescentarTexto(buffer, "|\n");
+    }
+    bufferAcrescentarTexto(buffer, "+----------+\n");
+}
+
+/**
+ * @brief Exibe o estado atual da Fila e da Pilha (e do Tabuleiro, se houver).
+ * * O quadro inteiro é montado em um buffer reutilizável e emitido com uma
+ * única escrita. No modo diferencial, após o primeiro quadro, apenas as
+ * seções (Fila e/ou Pilha) que mudaram desde o último quadro são emitidas.
  * @param fila Ponteiro para a FilaPecas.
  * @param pilha Ponteiro para a PilhaPecas.
  */
 void exibirEstadoAtual(FilaPecas *fila, PilhaPecas *pilha) {
-    printf("\n=======================================================\n");
-    printf("              ESTADO ATUAL (Nivel Mestre)\n");
-    printf("=======================================================\n");
+    exibirEstadoComRodape(fila, pilha, NULL, 0);
+}
 
-    // --- Exibição da Fila (FIFO) ---
-    printf("Fila de pecas futuras (Capacidade: %d | Ocupacao: %d):\n", MAX_FILA, fila->contador);
-    printf("Fila (Frente -> Final): ");
-    
-    if (estaVaziaFila(fila)) {
-        printf("[VAZIA]\n");
+/**
+ * @brief Exibe o estado atual com 'tamanho' bytes de 'rodape' ao final, na
+ * mesma escrita do quadro (o laço em tempo real mostra ali a peça em queda).
+ */
+void exibirEstadoComRodape(FilaPecas *fila, PilhaPecas *pilha, const char *rodape, size_t tamanho) {
+    Renderizador *r = &renderizador;
+    BufferQuadro *quadro = &r->quadro;
+
+    renderizarFila(&r->secaoFila, fila);
+    renderizarPilha(&r->secaoPilha, pilha);
+    if (fila->tabuleiro != NULL) {
+        renderizarTabuleiro(&r->secaoTabuleiro, fila->tabuleiro);
     } else {
-        int i = fila->frente;
-        int elementos_exibidos = 0;
-        
-        while (elementos_exibidos < fila->contador) {
-            printf("[%c %d]", fila->itens[i].nome, fila->itens[i].id);
-            if (elementos_exibidos < fila->contador - 1) {
-                printf(" ");
-            }
-            i = (i + 1) % MAX_FILA; // Avança circularmente
-            elementos_exibidos++;
-        }
-        printf("\n");
+        bufferLimpar(&r->secaoTabuleiro);
     }
-    
-    // --- Exibição da Pilha (LIFO) ---
-    printf("\n");
-    printf("Pilha de reserva (Capacidade: %d | Ocupacao: %d):\n", MAX_PILHA, getTamanhoPilha(pilha));
-    printf("Pilha (Topo -> Base): ");
-    
-    if (estaVaziaPilha(pilha)) {
-        printf("[VAZIA]\n");
+    bufferLimpar(quadro);
+
+    if (r->modoDiferencial && r->temAnterior) {
+        bool mudouFila = !bufferIguais(&r->secaoFila, &r->anteriorFila);
+        bool mudouPilha = !bufferIguais(&r->secaoPilha, &r->anteriorPilha);
+        bool mudouTabuleiro = !bufferIguais(&r->secaoTabuleiro, &r->anteriorTabuleiro);
+
+        bufferAcrescentarChar(quadro, '\n');
+        if (mudouFila) bufferAcrescentar(quadro, r->secaoFila.dados, r->secaoFila.tamanho);
+        if (mudouPilha) bufferAcrescentar(quadro, r->secaoPilha.dados, r->secaoPilha.tamanho);
+        if (mudouTabuleiro) bufferAcrescentar(quadro, r->secaoTabuleiro.dados, r->secaoTabuleiro.tamanho);
+        if (!mudouFila && !mudouPilha && !mudouTabuleiro) {
+            bufferAcrescentarTexto(quadro, "(Fila e Pilha sem alteracoes)\n");
+        }
     } else {
-        // Exibe do topo (pilha->topo) até a base (0)
-        for (int i = pilha->topo; i >= 0; i--) {
-            printf("[%c %d]", pilha->itens[i].nome, pilha->itens[i].id);
-            if (i > 0) {
-                printf(" ");
-            }
+        bufferAcrescentarTexto(quadro,
+            "\n=======================================================\n"
+            "              ESTADO ATUAL (Nivel Mestre)\n"
+            "=======================================================\n");
+        bufferAcrescentar(quadro, r->secaoFila.dados, r->secaoFila.tamanho);
+        bufferAcrescentarChar(quadro, '\n');
+        bufferAcrescentar(quadro, r->secaoPilha.dados, r->secaoPilha.tamanho);
+        if (r->secaoTabuleiro.tamanho > 0) {
+            bufferAcrescentarChar(quadro, '\n');
+            bufferAcrescentar(quadro, r->secaoTabuleiro.dados, r->secaoTabuleiro.tamanho);
         }
-        printf("\n");
+        bufferAcrescentarTexto(quadro, "-------------------------------------------------------\n");
     }
-    printf("-------------------------------------------------------\n");
+    if (tamanho > 0) bufferAcrescentar(quadro, rodape, tamanho);
+    bufferEmitir(quadro, STDOUT_FILENO);
+
+    // As seções atuais passam a ser a referência do próximo quadro
+    BufferQuadro temp = r->anteriorFila;
+    r->anteriorFila = r->secaoFila;
+    r->secaoFila = temp;
+    temp = r->anteriorPilha;
+    r->anteriorPilha = r->secaoPilha;
+    r->secaoPilha = temp;
+    temp = r->anteriorTabuleiro;
+    r->anteriorTabuleiro = r->secaoTabuleiro;
+    r->secaoTabuleiro = temp;
+    r->temAnterior = true;
 }
 
 /**
- * @brief Inicializa a fila de peças, preenchendo-a com MAX_FILA peças iniciais.
+ * @brief Aloca a fila com a capacidade pedida e a preenche com peças iniciais.
+ * @return false se a capacidade for inválida ou a alocação falhar.
  */
-void inicializarFila(FilaPecas *fila) {
-    fila->frente = 0;
-    fila->tras = MAX_FILA - 1; 
-    fila->contador = 0;
-    fila->proximo_id = 0;
-    srand((unsigned int)time(NULL));
-
-    for (int i = 0; i < MAX_FILA; i++) {
-        Peca p = gerarPeca(fila);
-        fila->itens[i] = p;
-        fila->contador++;
+bool inicializarFila(FilaPecas *fila, int capacidade, uint64_t semente) {
+    fila->itens = capacidade > 0 ? malloc((size_t)capacidade * sizeof(Peca)) : NULL;
+    if (fila->itens == NULL) {
+        fprintf(stderr, "ERRO: Nao foi possivel alocar a fila com capacidade %d.\n", capacidade);
+        return false;
     }
-    printf("Fila inicializada com %d pecas.\n", fila->contador);
+    fila->capacidade = capacidade;
+    nucleoIniciarFila(fila);
+    fila->canal = NULL;
+    fila->tabuleiro = NULL;
+    geradorSemear(&fila->gerador, semente);
+
+    gerarPecas(fila, fila->itens, capacidade);
+    fila->contador = capacidade;
+    MENSAGEM("Fila inicializada com %d pecas (semente: %llu).\n",
+             fila->contador, (unsigned long long)semente);
+    return true;
 }
 
 /**
- * @brief Inicializa a pilha de peças, definindo o topo como -1 (vazia).
+ * @brief Aloca a pilha com a capacidade pedida, definindo o topo como -1 (vazia).
+ * @return false se a capacidade for inválida ou a alocação falhar.
  */
-void inicializarPilha(PilhaPecas *pilha) {
+bool inicializarPilha(PilhaPecas *pilha, int capacidade) {
+    pilha->itens = capacidade > 0 ? malloc((size_t)capacidade * sizeof(Peca)) : NULL;
+    if (pilha->itens == NULL) {
+        fprintf(stderr, "ERRO: Nao foi possivel alocar a pilha com capacidade %d.\n", capacidade);
+        return false;
+    }
+    pilha->capacidade = capacidade;
+    nucleoIniciarPilha(pilha);
+    MENSAGEM("Pilha de reserva inicializada.\n");
+    return true;
+}
+
+void liberarFila(FilaPecas *fila) {
+    free(fila->itens);
+    fila->itens = NULL;
+    fila->capacidade = fila->contador = 0;
+}
+
+void liberarPilha(PilhaPecas *pilha) {
+    free(pilha->itens);
+    pilha->itens = NULL;
+    pilha->capacidade = 0;
     pilha->topo = -1;
-    printf("Pilha de reserva inicializada.\n");
 }
 
 // --- Funções de Operações Básicas (Fila) ---
+// Delegam para o núcleo compartilhado (Comum/nucleo_pecas.h); as ações
+// abaixo chamam o núcleo diretamente, e o compilador o expande no lugar.
 
-bool estaCheiaFila(FilaPecas *fila) { return fila->contador == MAX_FILA; }
-bool estaVaziaFila(FilaPecas *fila) { return fila->contador == 0; }
+bool estaCheiaFila(FilaPecas *fila) { return nucleoFilaCheia(fila); }
+bool estaVaziaFila(FilaPecas *fila) { return nucleoFilaVazia(fila); }
 
 void enqueue(FilaPecas *fila, Peca novaPeca) {
-    if (estaCheiaFila(fila)) return;
-    
-    fila->tras = (fila->tras + 1) % MAX_FILA;
-    fila->itens[fila->tras] = novaPeca;
-    fila->contador++;
+    nucleoEnqueue(fila, novaPeca);
 }
 
 Peca dequeue(FilaPecas *fila) {
     Peca pecaRemovida = {'\0', -1}; 
-    if (estaVaziaFila(fila)) return pecaRemovida;
-    
-    pecaRemovida = fila->itens[fila->frente];
-    fila->frente = (fila->frente + 1) % MAX_FILA;
-    fila->contador--;
-    
+    nucleoDequeue(fila, &pecaRemovida);
     return pecaRemovida;
 }
 
+// Operações em bloco: movem n peças com no máximo duas cópias contíguas
+// (antes e depois do ponto em que o anel volta ao início do vetor).
+
+bool enqueueN(FilaPecas *fila, const Peca *pecas, int n) {
+    return nucleoEnqueueN(fila, pecas, n);
+}
+
+bool dequeueN(FilaPecas *fila, Peca *destino, int n) {
+    return nucleoDequeueN(fila, destino, n);
+}
+
+bool peekN(const FilaPecas *fila, Peca *destino, int n) {
+    return nucleoEspiarN(fila, destino, n);
+}
+
 
 // --- Funções de Operações Básicas (Pilha) ---
 
-bool estaCheiaPilha(PilhaPecas *pilha) { return pilha->topo == MAX_PILHA - 1; }
-bool estaVaziaPilha(PilhaPecas *pilha) { return pilha->topo == -1; }
-int getTamanhoPilha(PilhaPecas *pilha) { return pilha->topo + 1; }
+bool estaCheiaPilha(PilhaPecas *pilha) { return nucleoPilhaCheia(pilha); }
+bool estaVaziaPilha(PilhaPecas *pilha) { return nucleoPilhaVazia(pilha); }
+int getTamanhoPilha(PilhaPecas *pilha) { return nucleoTamanhoPilha(pilha); }
 
 void push(PilhaPecas *pilha, Peca peca) {
-    if (estaCheiaPilha(pilha)) return;
-    
-    pilha->topo++;
-    pilha->itens[pilha->topo] = peca;
+    nucleoPush(pilha, peca);
 }
 
 Peca pop(PilhaPecas *pilha) {
     Peca pecaRemovida = {'\0', -1};
-    if (estaVaziaPilha(pilha)) return pecaRemovida;
-    
-    pecaRemovida = pilha->itens[pilha->topo];
-    pilha->topo--;
-    
+    nucleoPop(pilha, &pecaRemovida);
     return pecaRemovida;
 }
 
@@ -209,189 +380,946 @@ Peca pop(PilhaPecas *pilha) {
 /**
  * @brief Executa Dequeue na fila e Enqueue de nova peça.
  */
-void jogarPeca(FilaPecas *fila) {
-    if (estaVaziaFila(fila)) {
-        printf("\nAVISO: Nao e possivel jogar. A fila esta vazia.\n");
-        return;
+bool jogarPeca(FilaPecas *fila) {
+    Peca pecaJogada;
+    if (!nucleoDequeue(fila, &pecaJogada)) {
+        MENSAGEM("\nAVISO: Nao e possivel jogar. A fila esta vazia.\n");
+        return false;
     }
 
-    Peca pecaJogada = dequeue(fila);
-    printf("\nAcao 1: Jogando peca [%c %d] (dequeue da fila).\n", pecaJogada.nome, pecaJogada.id);
+    MENSAGEM("\nAcao 1: Jogando peca [%c %d] (dequeue da fila).\n", pecaJogada.nome, pecaJogada.id);
+
+    // Com um tabuleiro ligado, a peça jogada cai nele
+    if (fila->tabuleiro != NULL) {
+        JogadaTabuleiro jogada = tabuleiroJogar(fila->tabuleiro, indiceTipoPeca(pecaJogada.nome));
+        MENSAGEM("--> Peca colocada na coluna %d (rotacao %d, linha %d): %d linha(s) eliminada(s).\n",
+                 jogada.coluna + 1, jogada.rotacao, jogada.linha + 1, jogada.eliminadas);
+        if (jogada.fimPartida) MENSAGEM("--> O tabuleiro transbordou: partida encerrada, tabuleiro esvaziado.\n");
+    }
     
     // Reposicao automatica
     Peca novaPeca = gerarPeca(fila);
-    enqueue(fila, novaPeca);
-    printf("--> Peça de reposicao [%c %d] gerada e inserida no final da fila.\n", novaPeca.nome, novaPeca.id);
+    nucleoEnqueue(fila, novaPeca);
+    MENSAGEM("--> Peça de reposicao [%c %d] gerada e inserida no final da fila.\n", novaPeca.nome, novaPeca.id);
+    return true;
 }
 
 /**
  * @brief Move a peça da frente da fila para o topo da pilha.
  * Ação: Dequeue da Fila + Push na Pilha + Enqueue de nova peça.
  */
-void reservarPeca(FilaPecas *fila, PilhaPecas *pilha) {
-    if (estaCheiaPilha(pilha)) {
-        printf("\nAVISO: Pilha de reserva cheia! Nao e possivel reservar mais pecas.\n");
-        return;
+bool reservarPeca(FilaPecas *fila, PilhaPecas *pilha) {
+    if (nucleoPilhaCheia(pilha)) {
+        MENSAGEM("\nAVISO: Pilha de reserva cheia! Nao e possivel reservar mais pecas.\n");
+        return false;
     }
-    if (estaVaziaFila(fila)) {
-        printf("\nAVISO: Fila vazia! Nao ha pecas para reservar.\n");
-        return;
+    Peca pecaReservar;
+    if (!nucleoDequeue(fila, &pecaReservar)) {
+        MENSAGEM("\nAVISO: Fila vazia! Nao ha pecas para reservar.\n");
+        return false;
     }
 
-    Peca pecaReservar = dequeue(fila);
-    printf("\nAcao 2: Reservando peca [%c %d] (Fila -> Pilha).\n", pecaReservar.nome, pecaReservar.id);
+    MENSAGEM("\nAcao 2: Reservando peca [%c %d] (Fila -> Pilha).\n", pecaReservar.nome, pecaReservar.id);
     
-    push(pilha, pecaReservar);
+    nucleoPush(pilha, pecaReservar);
     
     // Reposicao automatica
     Peca novaPeca = gerarPeca(fila);
-    enqueue(fila, novaPeca);
-    printf("--> Peça de reposicao [%c %d] gerada e inserida no final da fila.\n", novaPeca.nome, novaPeca.id);
+    nucleoEnqueue(fila, novaPeca);
+    MENSAGEM("--> Peça de reposicao [%c %d] gerada e inserida no final da fila.\n", novaPeca.nome, novaPeca.id);
+    return true;
 }
 
 /**
  * @brief Executa Pop na pilha.
  */
-void usarPecaReservada(PilhaPecas *pilha) {
-    if (estaVaziaPilha(pilha)) {
-        printf("\nAVISO: Nao e possivel usar. A pilha de reserva esta vazia.\n");
-        return;
+bool usarPecaReservada(PilhaPecas *pilha) {
+    Peca pecaUsada;
+    if (!nucleoPop(pilha, &pecaUsada)) {
+        MENSAGEM("\nAVISO: Nao e possivel usar. A pilha de reserva esta vazia.\n");
+        return false;
     }
 
-    Peca pecaUsada = pop(pilha);
-    printf("\nAcao 3: Usando peca reservada [%c %d] (pop da Pilha).\n", pecaUsada.nome, pecaUsada.id);
+    MENSAGEM("\nAcao 3: Usando peca reservada [%c %d] (pop da Pilha).\n", pecaUsada.nome, pecaUsada.id);
+    return true;
 }
 
 /**
  * @brief Troca a peça da FRENTE da fila com a peça do TOPO da pilha.
  */
-void trocarPecaSimples(FilaPecas *fila, PilhaPecas *pilha) {
-    if (estaVaziaFila(fila) || estaVaziaPilha(pilha)) {
-        printf("\nAVISO: Troca Simples nao pode ser realizada. Fila ou Pilha estao vazias.\n");
-        return;
+bool trocarPecaSimples(FilaPecas *fila, PilhaPecas *pilha) {
+    if (!nucleoTrocarFrenteTopo(fila, pilha)) {
+        MENSAGEM("\nAVISO: Troca Simples nao pode ser realizada. Fila ou Pilha estao vazias.\n");
+        return false;
     }
     
-    // Pega as peças a serem trocadas
-    Peca pecaFila = fila->itens[fila->frente];
-    Peca pecaPilha = pilha->itens[pilha->topo];
-    
-    // Realiza a troca:
-    // 1. A peça da pilha vai para a frente da fila
-    fila->itens[fila->frente] = pecaPilha;
-    // 2. A peça da fila vai para o topo da pilha
-    pilha->itens[pilha->topo] = pecaFila;
-    
-    printf("\nAcao 4: Troca Simples realizada.\n");
-    printf("   [Fila] %c %d <--> [Pilha] %c %d\n", pecaFila.nome, pecaFila.id, pecaPilha.nome, pecaPilha.id);
+    // Após a troca, a peça que era da fila está no topo da pilha e vice-versa
+    MENSAGEM("\nAcao 4: Troca Simples realizada.\n");
+    MENSAGEM("   [Fila] %c %d <--> [Pilha] %c %d\n", pilha->itens[pilha->topo].nome, pilha->itens[pilha->topo].id,
+             fila->itens[fila->frente].nome, fila->itens[fila->frente].id);
     
     // Nenhuma reposição é necessária pois não há remoção
+    return true;
 }
 
 /**
- * @brief Troca as 3 primeiras peças da fila com as 3 peças da pilha.
- * (Requer que ambas tenham no mínimo 3 elementos)
+ * @brief Troca as n primeiras peças da fila com as n peças do topo da pilha.
+ * (Requer que ambas tenham no mínimo n elementos)
  */
-void trocarPecaMultipla(FilaPecas *fila, PilhaPecas *pilha) {
-    const int N_TROCA = 3;
-
-    if (fila->contador < N_TROCA || getTamanhoPilha(pilha) < N_TROCA) {
-        printf("\nAVISO: Troca Multipla nao pode ser realizada.\n");
-        printf("   Requer %d pecas na Fila (atual: %d) e %d na Pilha (atual: %d).\n", 
-               N_TROCA, fila->contador, N_TROCA, getTamanhoPilha(pilha));
-        return;
+bool trocarPecaMultipla(FilaPecas *fila, PilhaPecas *pilha, int n) {
+    if (!nucleoTrocarBloco(fila, pilha, n)) {
+        MENSAGEM("\nAVISO: Troca Multipla nao pode ser realizada.\n");
+        MENSAGEM("   Requer %d pecas na Fila (atual: %d) e %d na Pilha (atual: %d).\n", 
+               n, fila->contador, n, getTamanhoPilha(pilha));
+        return false;
     }
     
-    printf("\nAcao 5: Troca Multipla (Bloco) de %d pecas realizada.\n", N_TROCA);
-    
-    // A troca é realizada movendo-se 3 elementos de cada estrutura
-    for (int i = 0; i < N_TROCA; i++) {
-        // Índice da fila (circular)
-        int idx_fila = (fila->frente + i) % MAX_FILA;
-        // Índice da pilha (linear, do topo para baixo)
+    MENSAGEM("\nAcao 5: Troca Multipla (Bloco) de %d pecas realizada.\n", n);
+    if (modoSilencioso) return true;
+
+    // Lista os pares já trocados: Fila (antes) <--> Pilha (antes)
+    for (int i = 0; i < n; i++) {
+        int idx_fila = ANEL_INDICE_DINAMICO(fila->frente, i, fila->capacidade);
         int idx_pilha = pilha->topo - i;
-        
-        // Troca os valores (swap)
-        Peca temp = fila->itens[idx_fila];
-        fila->itens[idx_fila] = pilha->itens[idx_pilha];
-        pilha->itens[idx_pilha] = temp;
-        
         printf("   Bloco #%d: Fila [%c %d] <--> Pilha [%c %d]\n", 
                i+1, pilha->itens[idx_pilha].nome, pilha->itens[idx_pilha].id, 
                fila->itens[idx_fila].nome, fila->itens[idx_fila].id);
     }
+    return true;
+}
+
+/**
+ * @brief Executa a ação correspondente ao código do menu (1 a 5).
+ * @return true se a ação foi executada, false se foi recusada ou o código é inválido.
+ */
+bool executarAcao(FilaPecas *fila, PilhaPecas *pilha, int opcao) {
+    switch (opcao) {
+        case 1: return jogarPeca(fila);
+        case 2: return reservarPeca(fila, pilha);
+        case 3: return usarPecaReservada(pilha);
+        case 4: return trocarPecaSimples(fila, pilha);
+        case 5: return trocarPecaMultipla(fila, pilha, tamanhoTroca);
+        default: return false;
+    }
+}
+
+// --- Modo em Lote (Headless) ---
+
+/**
+ * @brief Retorna o instante atual de um relógio monotônico, em segundos.
+ */
+double tempoAtual(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Executa a ação do menu, pelo histórico quando houver um (códigos 6 e 7),
+ * a registra nas estatísticas e publica o novo estado para os espectadores.
+ */
+static bool aplicarAcao(FilaPecas *fila, PilhaPecas *pilha, HistoricoAcoes *historico, int opcao) {
+    uint64_t inicio = estatisticasInicio();
+    bool executada = historico != NULL ? historicoAplicar(historico, fila, pilha, opcao)
+                                       : executarAcao(fila, pilha, opcao);
+    estatisticasRegistrar(opcao - 1, executada, inicio);
+    if (executada && transmissaoPrincipal != NULL) transmissaoPublicar(transmissaoPrincipal, 0, fila, pilha);
+    return executada;
+}
+
+// --- Leitura de Comandos ---
+
+// Estado do leitor de comandos, alimentado um caractere por vez.
+// Um comando é um código de um dígito, opcionalmente seguido de 'x' e um
+// número de repetições ("1x1000"); qualquer outro caractere separa comandos.
+typedef struct {
+    int codigo;           // Código sendo lido (-1 = nenhum dígito pendente)
+    long long repeticoes; // Repetições lidas após 'x' (-1 = sem 'x')
+} LeitorComandos;
+
+static inline void leitorIniciar(LeitorComandos *leitor) {
+    leitor->codigo = -1;
+    leitor->repeticoes = -1;
+}
+
+/**
+ * @brief Consome um caractere.
+ * @return true se o caractere encerrou um comando, devolvido em *codigo e *vezes.
+ * * "1x" e "1x0" têm zero repetições; códigos com mais de um dígito viram 10 (inválido).
+ */
+static inline bool leitorConsumir(LeitorComandos *leitor, char c, int *codigo, long long *vezes) {
+    if (c >= '0' && c <= '9') {
+        if (leitor->repeticoes >= 0) {
+            // Satura em vez de transbordar
+            if (leitor->repeticoes < LLONG_MAX / 10 - 9) leitor->repeticoes = leitor->repeticoes * 10 + (c - '0');
+        } else {
+            // Números com mais de um dígito são sempre inválidos (satura em 10)
+            leitor->codigo = (leitor->codigo < 0) ? c - '0' : 10;
+        }
+        return false;
+    }
+    if ((c == 'x' || c == 'X') && leitor->codigo >= 0 && leitor->repeticoes < 0) {
+        leitor->repeticoes = 0;
+        return false;
+    }
+    if (leitor->codigo < 0) return false;
+
+    *codigo = leitor->codigo;
+    *vezes = leitor->repeticoes >= 0 ? leitor->repeticoes : 1;
+    leitorIniciar(leitor);
+    return true;
+}
+
+/**
+ * @brief Encerra o comando pendente no fim da entrada.
+ * @return true se havia um comando pendente.
+ */
+static inline bool leitorFinalizar(LeitorComandos *leitor, int *codigo, long long *vezes) {
+    return leitorConsumir(leitor, '\n', codigo, vezes);
+}
+
+/**
+ * @brief Contadores do modo em lote.
+ */
+typedef struct {
+    long long executadas; // Ações aceitas
+    long long recusadas;  // Ações recusadas (caminhos de AVISO)
+    long long invalidas;  // Códigos fora do intervalo 1 a 5
+} ResumoLote;
+
+/**
+ * @brief Executa um código lido do roteiro e atualiza o resumo.
+ * @return false se o código for 0 (fim do roteiro), true caso contrário.
+ */
+static bool processarCodigoLote(FilaPecas *fila, PilhaPecas *pilha, int codigo, DiarioAcoes *diario,
+                                HistoricoAcoes *historico, ResumoLote *resumo) {
+    if (codigo == 0) return false;
+
+    if (codigo > (historico != NULL ? ACAO_REFAZER : 5)) {
+        resumo->invalidas++;
+        return true;
+    }
+
+    bool executada = aplicarAcao(fila, pilha, historico, codigo);
+    if (executada) {
+        resumo->executadas++;
+    } else {
+        resumo->recusadas++;
+    }
+    if (diario != NULL) diarioRegistrar(diario, codigo, executada, fila, pilha);
+    return true;
 }
 
 /**
- * @brief Exibe o menu de acoes para o usuario.
+ * @brief Executa um comando lido do roteiro 'vezes' vezes.
+ * * Repetições de um código inválido contam como um único código inválido.
+ * @return false se o código for 0 (fim do roteiro), true caso contrário.
+ */
+static bool processarComandoLote(FilaPecas *fila, PilhaPecas *pilha, int codigo, long long vezes,
+                                 DiarioAcoes *diario, HistoricoAcoes *historico, ResumoLote *resumo) {
+    if (codigo == 0) return false;
+    if (vezes == 0 || codigo > (historico != NULL ? ACAO_REFAZER : 5)) {
+        resumo->invalidas++;
+        return true;
+    }
+    for (long long i = 0; i < vezes; i++) {
+        processarCodigoLote(fila, pilha, codigo, diario, historico, resumo);
+    }
+    return true;
+}
+
+/**
+ * @brief Executa um roteiro de ações (códigos 1 a 5, e 6/7 com histórico) sem nenhuma impressão.
+ * * O roteiro é lido em blocos de TAM_BUFFER_LOTE bytes. Os códigos podem estar
+ * separados por qualquer caractere não numérico e repetidos com "x" ("1x1000");
+ * o código 0 encerra o roteiro.
+ * Ao final, exibe o estado da Fila e da Pilha e a taxa de ações por segundo.
+ * @param entrada Arquivo (ou stdin) com o roteiro de ações.
+ * @param diario Diário onde as ações são registradas, ou NULL.
+ * @param historico Histórico de desfazer/refazer, ou NULL.
+ * @return 0 em caso de sucesso, 1 se houve erro de leitura.
+ */
+int executarLote(FILE *entrada, FilaPecas *fila, PilhaPecas *pilha, DiarioAcoes *diario,
+                 HistoricoAcoes *historico) {
+    static char buffer[TAM_BUFFER_LOTE];
+    ResumoLote resumo = {0, 0, 0};
+    LeitorComandos leitor;
+    int codigo;
+    long long vezes;
+    bool continuar = true;
+    size_t lidos;
+
+    leitorIniciar(&leitor);
+
+    modoSilencioso = true;
+    double inicio = tempoAtual();
+
+    while (continuar && (lidos = fread(buffer, 1, sizeof(buffer), entrada)) > 0) {
+        for (size_t i = 0; i < lidos && continuar; i++) {
+            if (leitorConsumir(&leitor, buffer[i], &codigo, &vezes)) {
+                continuar = processarComandoLote(fila, pilha, codigo, vezes, diario, historico, &resumo);
+            }
+        }
+    }
+    if (continuar && leitorFinalizar(&leitor, &codigo, &vezes)) {
+        processarComandoLote(fila, pilha, codigo, vezes, diario, historico, &resumo);
+    }
+
+    double decorrido = tempoAtual() - inicio;
+    modoSilencioso = false;
+
+    if (ferror(entrada)) {
+        fprintf(stderr, "ERRO: Falha ao ler o roteiro de acoes.\n");
+        return 1;
+    }
+
+    long long total = resumo.executadas + resumo.recusadas;
+    exibirEstadoAtual(fila, pilha);
+    printf("Modo em lote: %lld acoes (%lld executadas, %lld recusadas, %lld codigos invalidos)\n",
+           total, resumo.executadas, resumo.recusadas, resumo.invalidas);
+    printf("Semente: %llu\n", (unsigned long long)fila->gerador.semente);
+    printf("Tempo: %.6f s | Taxa: %.0f acoes/s\n",
+           decorrido, decorrido > 0 ? (double)total / decorrido : 0.0);
+    return 0;
+}
+
+/**
+ * @brief Exibe o menu de acoes para o usuario (montado e emitido de uma vez).
+ * * No modo diferencial o menu completo aparece só uma vez; depois, apenas o prompt.
  */
 void exibirMenu(void) {
-    printf("\n==================================\n");
-    printf("        Opcoes de Acao\n");
-    printf("==================================\n");
-    printf("Codigo | Acao\n");
-    printf("----------------------------------\n");
-    printf("  1    | Jogar peca (dequeue da Fila)\n");
-    printf("  2    | Enviar peca (Fila -> Pilha)\n");
-    printf("  3    | Usar peca (pop da Pilha)\n");
-    printf("  4    | Trocar peca simples (Frente Fila <-> Topo Pilha)\n");
-    printf("  5    | Trocar multipla (3 Fila <-> 3 Pilha)\n");
-    printf("  0    | Sair\n");
-    printf("----------------------------------\n");
-    printf("Digite o codigo da acao: ");
+    BufferQuadro *quadro = &renderizador.quadro;
+
+    bufferLimpar(quadro);
+    if (renderizador.modoDiferencial && renderizador.menuExibido) {
+        bufferAcrescentarTexto(quadro, "\nDigite o codigo da acao: ");
+        bufferEmitir(quadro, STDOUT_FILENO);
+        return;
+    }
+    renderizador.menuExibido = true;
+
+    bufferAcrescentarTexto(quadro,
+        "\n==================================\n"
+        "        Opcoes de Acao\n"
+        "==================================\n"
+        "Codigo | Acao\n"
+        "----------------------------------\n"
+        "  1    | Jogar peca (dequeue da Fila)\n"
+        "  2    | Enviar peca (Fila -> Pilha)\n"
+        "  3    | Usar peca (pop da Pilha)\n"
+        "  4    | Trocar peca simples (Frente Fila <-> Topo Pilha)\n"
+        "  5    | Trocar multipla (");
+    bufferAcrescentarInt(quadro, tamanhoTroca);
+    bufferAcrescentarTexto(quadro, " Fila <-> ");
+    bufferAcrescentarInt(quadro, tamanhoTroca);
+    bufferAcrescentarTexto(quadro, " Pilha)\n");
+    if (renderizador.opcoesHistorico) {
+        bufferAcrescentarTexto(quadro,
+            "  6    | Desfazer ultima acao\n"
+            "  7    | Refazer acao desfeita\n");
+    }
+    if (ESTATISTICAS_COMPILADAS) {
+        bufferAcrescentarTexto(quadro, "  8    | Exibir estatisticas\n");
+    }
+    bufferAcrescentarTexto(quadro,
+        "  0    | Sair\n"
+        "----------------------------------\n"
+        "Digite o codigo da acao: ");
+    bufferEmitir(quadro, STDOUT_FILENO);
 }
 
 // --- Função Principal ---
 
-int main() {
+// TETRIS_SEM_MAIN permite incluir este arquivo em outro programa (ex.: benchmarks).
+#ifndef TETRIS_SEM_MAIN
+
+/**
+ * @brief Lê um inteiro positivo de um argumento da linha de comando.
+ * @return false se o texto não for um inteiro positivo.
+ */
+static bool lerInteiroPositivo(const char *texto, int *valor) {
+    char *fim;
+    long v = strtol(texto, &fim, 10);
+    if (*texto == '\0' || *fim != '\0' || v <= 0 || v > 0x7FFFFFFF) return false;
+    *valor = (int)v;
+    return true;
+}
+
+/**
+ * @brief Como lerInteiroPositivo, mas aceita 0 (ex.: --espera-ativa 0 desliga a espera ativa).
+ */
+static bool lerInteiroNaoNegativo(const char *texto, int *valor) {
+    if (strcmp(texto, "0") == 0) {
+        *valor = 0;
+        return true;
+    }
+    return lerInteiroPositivo(texto, valor);
+}
+
+/**
+ * @brief Lê uma contagem positiva de 64 bits (ex.: bilhões de peças) de um argumento.
+ * @return false se o texto não for um inteiro positivo.
+ */
+static bool lerContagemPositiva(const char *texto, long long *valor) {
+    char *fim;
+    long long v = strtoll(texto, &fim, 10);
+    if (*texto == '\0' || *fim != '\0' || v <= 0 || v == LLONG_MAX) return false;
+    *valor = v;
+    return true;
+}
+
+/**
+ * @brief Executa um comando digitado no modo interativo.
+ * * Um comando repetido ("1x1000") roda sem as mensagens de cada ação e
+ * termina com um resumo; os demais se comportam como uma opção do menu.
+ * @return false se o comando for 0 (sair).
+ */
+static bool executarComandoInterativo(FilaPecas *fila, PilhaPecas *pilha, HistoricoAcoes *historico,
+                                      DiarioAcoes *diario, int opcao, long long vezes) {
+    bool acao = (opcao >= 1 && opcao <= 5) || ((opcao == 6 || opcao == 7) && historico != NULL);
+
+    if (vezes == 1 && opcao == 0) {
+        printf("\nSaindo do simulador Mestre. O gerenciamento de pecas foi um sucesso!\n");
+        return false;
+    }
+    if (vezes == 1 && opcao == 8 && ESTATISTICAS_COMPILADAS) {
+        estatisticasExibir(stdout, ESTATISTICAS_TEXTO);
+        return true;
+    }
+    if (!acao || vezes == 0) {
+        printf("\nOPCAO INVALIDA. Por favor, digite 1, 2, 3, 4, 5 ou 0.\n");
+        return true;
+    }
+
+    if (vezes == 1) {
+        bool executada = aplicarAcao(fila, pilha, historico, opcao);
+        if (diario != NULL) diarioRegistrar(diario, opcao, executada, fila, pilha);
+        return true;
+    }
+
+    ResumoLote resumo = {0, 0, 0};
+    modoSilencioso = true;
+    processarComandoLote(fila, pilha, opcao, vezes, diario, historico, &resumo);
+    modoSilencioso = false;
+    printf("\nAcao %d repetida %lld vezes: %lld executadas, %lld recusadas.\n",
+           opcao, vezes, resumo.executadas, resumo.recusadas);
+    return true;
+}
+
+/**
+ * @brief Cria a fila e a pilha da sessão, ou as restaura de um instantâneo.
+ * @param restaurar Caminho do instantâneo (--restaurar), ou NULL.
+ * @param tabuleiro Tabuleiro a esvaziar e ligar à fila (--tabuleiro), ou NULL.
+ * @return false em caso de erro (nada fica alocado).
+ */
+static bool iniciarSessao(FilaPecas *fila, PilhaPecas *pilha, int capacidadeFila, int capacidadePilha,
+                          uint64_t semente, const char *restaurar, Tabuleiro *tabuleiro) {
+    if (restaurar != NULL) {
+        if (!instantaneoRestaurar(fila, pilha, restaurar)) return false;
+    } else {
+        if (!inicializarPilha(pilha, capacidadePilha)) return false;
+        if (!inicializarFila(fila, capacidadeFila, semente)) {
+            liberarPilha(pilha);
+            return false;
+        }
+    }
+
+    // O tabuleiro não faz parte do instantâneo: sempre recomeça vazio
+    if (tabuleiro != NULL) {
+        tabuleiroLimpar(tabuleiro);
+        fila->tabuleiro = tabuleiro;
+    }
+    return true;
+}
+
+/**
+ * @brief Cria a transmissão da sessão principal (--transmitir) e publica o estado inicial.
+ * @return false em caso de erro (nada fica aberto).
+ */
+static bool iniciarTransmissao(Transmissao *transmissao, const char *caminho, FilaPecas *fila, PilhaPecas *pilha) {
+    if (!transmissaoCriar(transmissao, caminho, 1, fila->capacidade, pilha->capacidade)) return false;
+    transmissaoPublicar(transmissao, 0, fila, pilha);
+    transmissaoPrincipal = transmissao;
+    return true;
+}
+
+/**
+ * @brief Marca a transmissão da sessão principal como encerrada, se houver uma.
+ */
+static void encerrarTransmissao(void) {
+    if (transmissaoPrincipal == NULL) return;
+    transmissaoFechar(transmissaoPrincipal);
+    transmissaoPrincipal = NULL;
+}
+
+static void exibirUso(const char *programa) {
+    fprintf(stderr, "Uso: %s [--fila N] [--pilha N] [--troca N] [--semente N] [--diferencial] [--canal N] [--historico N]\n"
+                    "          [--interativo] [--tabuleiro] [--estatisticas texto|json] [--diario <arquivo>] [--restaurar <arquivo>] [--salvar <arquivo>] [--lote <arquivo|->]\n"
+                    "          [--transmitir <arquivo>]\n"
+                    "       %s --jogador N [--feixe W] [--tempo-jogada MS] [--trabalhadores T] [--fila N] [--pilha N]\n"
+                    "          [--semente N] [--restaurar <arquivo>] [--salvar <arquivo>]\n"
+                    "       %s --planejar <ordem> [--max-acoes N] [--fila N] [--pilha N] [--troca N] [--semente N]\n"
+                    "          [--restaurar <arquivo>]\n"
+                    "       %s --analisar N [--passos M] [--trabalhadores T] [--fila N] [--pilha N] [--troca N] [--semente N]\n"
+                    "       %s --tempo-real HZ [--queda MS] [--duracao S] [--espera-ativa US] [--fila N] [--pilha N] [--troca N] [--semente N]\n"
+                    "          [--tabuleiro] [--diferencial] [--canal N] [--restaurar <arquivo>] [--salvar <arquivo>] [--transmitir <arquivo>]\n"
+                    "       %s --servidor <socket> [--max-clientes N] [--duracao S] [--fila N] [--pilha N] [--troca N] [--semente N]\n"
+                    "          [--transmitir <arquivo>]\n"
+                    "       %s --cliente <socket> [--clientes N] [--acoes M] [--semente N]\n"
+                    "       %s --assistir <arquivo> [--sessao K] [--intervalo MS] [--duracao S]\n"
+                    "       %s --reproduzir <diario>\n"
+                    "       %s --sessoes N [--trabalhadores T] [--acoes M] [--fila N] [--pilha N] [--troca N] [--semente N]\n"
+                    "          [--tabuleiro] [--restaurar <arquivo>] [--salvar <arquivo>] [--transmitir <arquivo>]\n",
+            programa, programa, programa, programa, programa, programa, programa, programa, programa, programa);
+}
+
+int main(int argc, char *argv[]) {
     FilaPecas filaPrincipal;
     PilhaPecas pilhaReserva;
-    int opcao = -1;
+    int capacidadeFila = MAX_FILA;
+    int capacidadePilha = MAX_PILHA;
+    uint64_t semente = gerarSemente();
+    const char *roteiro = NULL;
+    int numSessoes = 0;
+    int numTrabalhadores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int numAcoes = 10000000;
+    int capacidadeCanal = 0; // 0 = gerar as peças na própria thread do jogo
+    CanalPecas canal;
+    const char *caminhoDiario = NULL;     // --diario: grava as ações neste arquivo
+    const char *caminhoReproducao = NULL; // --reproduzir: reexecuta este diário
+    DiarioAcoes diario;
+    DiarioAcoes *diarioAtivo = NULL;
+    const char *caminhoRestaurar = NULL; // --restaurar: retoma a sessão de um instantâneo
+    const char *caminhoSalvar = NULL;    // --salvar: grava um instantâneo ao final
+    int capacidadeHistorico = 0;         // --historico: ações que podem ser desfeitas (0 = desligado)
+    HistoricoAcoes historico;
+    HistoricoAcoes *historicoAtivo = NULL;
+    bool exibirEstatisticas = false;     // --estatisticas: exibe as estatísticas ao final
+    FormatoEstatisticas formatoEstatisticas = ESTATISTICAS_TEXTO;
+    bool usarTabuleiro = false;          // --tabuleiro: a ação 1 solta as peças em um tabuleiro
+    bool forcarInterativo = false;       // --interativo: menu e quadros mesmo sem terminal
+    Tabuleiro tabuleiro;
+    int numJogadas = 0;                  // --jogador: jogadas do jogador automático
+    int larguraFeixe = JOGADOR_LARGURA_PADRAO;
+    int tempoJogadaMs = 0;               // --tempo-jogada: limite da busca por jogada (0 = sem limite)
+    const char *ordemPlanejada = NULL;   // --planejar: ordem de peças (ex.: "TLI") a planejar
+    int maxAcoesPlano = PLANEJADOR_ACOES_PADRAO;
+    long long numPecasAnalise = 0;       // --analisar: peças sorteadas pelo analisador
+    long long numPassosAnalise = ANALISADOR_PASSOS_PADRAO;
+    int hzTempoReal = 0;                 // --tempo-real: passos por segundo do laço em tempo real
+    int quedaMs = TEMPO_REAL_QUEDA_PADRAO_MS;
+    int duracao = 0;                     // --duracao: segundos de --tempo-real, --servidor ou --assistir (0 = sem limite)
+    int margemTempoRealUs = TEMPO_REAL_MARGEM_PADRAO_US; // --espera-ativa: us girando antes de cada prazo
+    const char *caminhoServidor = NULL;  // --servidor: atende clientes neste socket Unix
+    int maxClientes = SERVIDOR_MAX_CLIENTES_PADRAO;
+    const char *caminhoCliente = NULL;   // --cliente: gera carga contra o servidor neste socket
+    int numClientes = SERVIDOR_CLIENTES_PADRAO;
+    const char *caminhoTransmitir = NULL; // --transmitir: publica as sessões para espectadores
+    Transmissao transmissao;
+    const char *caminhoAssistir = NULL;  // --assistir: exibe uma sessão transmitida por outro processo
+    int sessaoAssistida = 0;
+    int intervaloMs = TRANSMISSAO_INTERVALO_PADRAO_MS;
+
+    // Opções: capacidades, tamanho da troca múltipla e modo em lote
+    // (--lote <arquivo>, ou "-" para ler da entrada padrão)
+    for (int i = 1; i < argc; i++) {
+        bool temValor = i + 1 < argc;
+        if (strcmp(argv[i], "--fila") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &capacidadeFila)) {
+            i++;
+        } else if (strcmp(argv[i], "--pilha") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &capacidadePilha)) {
+            i++;
+        } else if (strcmp(argv[i], "--troca") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &tamanhoTroca)) {
+            i++;
+        } else if (strcmp(argv[i], "--semente") == 0 && temValor && geradorLerSemente(argv[i + 1], &semente)) {
+            i++;
+        } else if (strcmp(argv[i], "--sessoes") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &numSessoes)) {
+            i++;
+        } else if (strcmp(argv[i], "--trabalhadores") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &numTrabalhadores)) {
+            i++;
+        } else if (strcmp(argv[i], "--acoes") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &numAcoes)) {
+            i++;
+        } else if (strcmp(argv[i], "--canal") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &capacidadeCanal)) {
+            i++;
+        } else if (strcmp(argv[i], "--historico") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &capacidadeHistorico)) {
+            i++;
+        } else if (strcmp(argv[i], "--estatisticas") == 0 && temValor &&
+                   (strcmp(argv[i + 1], "texto") == 0 || strcmp(argv[i + 1], "json") == 0)) {
+            exibirEstatisticas = true;
+            formatoEstatisticas = strcmp(argv[++i], "json") == 0 ? ESTATISTICAS_JSON : ESTATISTICAS_TEXTO;
+        } else if (strcmp(argv[i], "--jogador") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &numJogadas)) {
+            i++;
+        } else if (strcmp(argv[i], "--feixe") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &larguraFeixe)) {
+            i++;
+        } else if (strcmp(argv[i], "--tempo-jogada") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &tempoJogadaMs)) {
+            i++;
+        } else if (strcmp(argv[i], "--planejar") == 0 && temValor) {
+            ordemPlanejada = argv[++i];
+        } else if (strcmp(argv[i], "--max-acoes") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &maxAcoesPlano)) {
+            i++;
+        } else if (strcmp(argv[i], "--analisar") == 0 && temValor && lerContagemPositiva(argv[i + 1], &numPecasAnalise)) {
+            i++;
+        } else if (strcmp(argv[i], "--passos") == 0 && temValor && lerContagemPositiva(argv[i + 1], &numPassosAnalise)) {
+            i++;
+        } else if (strcmp(argv[i], "--tempo-real") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &hzTempoReal)) {
+            i++;
+        } else if (strcmp(argv[i], "--queda") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &quedaMs)) {
+            i++;
+        } else if (strcmp(argv[i], "--duracao") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &duracao)) {
+            i++;
+        } else if (strcmp(argv[i], "--espera-ativa") == 0 && temValor && lerInteiroNaoNegativo(argv[i + 1], &margemTempoRealUs)) {
+            i++;
+        } else if (strcmp(argv[i], "--servidor") == 0 && temValor) {
+            caminhoServidor = argv[++i];
+        } else if (strcmp(argv[i], "--max-clientes") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &maxClientes)) {
+            i++;
+        } else if (strcmp(argv[i], "--cliente") == 0 && temValor) {
+            caminhoCliente = argv[++i];
+        } else if (strcmp(argv[i], "--clientes") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &numClientes)) {
+            i++;
+        } else if (strcmp(argv[i], "--transmitir") == 0 && temValor) {
+            caminhoTransmitir = argv[++i];
+        } else if (strcmp(argv[i], "--assistir") == 0 && temValor) {
+            caminhoAssistir = argv[++i];
+        } else if (strcmp(argv[i], "--sessao") == 0 && temValor && lerInteiroNaoNegativo(argv[i + 1], &sessaoAssistida)) {
+            i++;
+        } else if (strcmp(argv[i], "--intervalo") == 0 && temValor && lerInteiroPositivo(argv[i + 1], &intervaloMs)) {
+            i++;
+        } else if (strcmp(argv[i], "--tabuleiro") == 0) {
+            usarTabuleiro = true;
+        } else if (strcmp(argv[i], "--interativo") == 0) {
+            forcarInterativo = true;
+        } else if (strcmp(argv[i], "--diferencial") == 0) {
+            renderizador.modoDiferencial = true;
+        } else if (strcmp(argv[i], "--diario") == 0 && temValor) {
+            caminhoDiario = argv[++i];
+        } else if (strcmp(argv[i], "--reproduzir") == 0 && temValor) {
+            caminhoReproducao = argv[++i];
+        } else if (strcmp(argv[i], "--restaurar") == 0 && temValor) {
+            caminhoRestaurar = argv[++i];
+        } else if (strcmp(argv[i], "--salvar") == 0 && temValor) {
+            caminhoSalvar = argv[++i];
+        } else if (strcmp(argv[i], "--lote") == 0 && temValor) {
+            roteiro = argv[++i];
+        } else {
+            exibirUso(argv[0]);
+            return 1;
+        }
+    }
+
+    // O diário é reproduzido a partir da semente, e o canal adianta o gerador da fila
+    if (caminhoDiario != NULL && caminhoRestaurar != NULL) {
+        fprintf(stderr, "ERRO: --diario nao pode ser usado com --restaurar.\n");
+        return 1;
+    }
+    if (caminhoSalvar != NULL && capacidadeCanal > 0) {
+        fprintf(stderr, "ERRO: --salvar nao pode ser usado com --canal.\n");
+        return 1;
+    }
+    if (capacidadeHistorico > 0 && capacidadeCanal > 0) {
+        fprintf(stderr, "ERRO: --historico nao pode ser usado com --canal.\n");
+        return 1;
+    }
+
+    if (numJogadas > 0 && (caminhoDiario != NULL || capacidadeHistorico > 0 || roteiro != NULL)) {
+        fprintf(stderr, "ERRO: --jogador nao pode ser usado com --diario, --historico ou --lote.\n");
+        return 1;
+    }
+
+    if (ordemPlanejada != NULL && (numJogadas > 0 || caminhoDiario != NULL || capacidadeHistorico > 0 || roteiro != NULL)) {
+        fprintf(stderr, "ERRO: --planejar nao pode ser usado com --jogador, --diario, --historico ou --lote.\n");
+        return 1;
+    }
+
+    if (numPecasAnalise > 0 && (numJogadas > 0 || ordemPlanejada != NULL || numSessoes > 0 || caminhoDiario != NULL ||
+                                caminhoRestaurar != NULL || caminhoSalvar != NULL || roteiro != NULL)) {
+        fprintf(stderr, "ERRO: --analisar nao pode ser usado com outros modos nem com --diario, --restaurar, --salvar ou --lote.\n");
+        return 1;
+    }
+
+    if (hzTempoReal > 0 && (numJogadas > 0 || ordemPlanejada != NULL || numPecasAnalise > 0 || numSessoes > 0 ||
+                            caminhoDiario != NULL || capacidadeHistorico > 0 || roteiro != NULL)) {
+        fprintf(stderr, "ERRO: --tempo-real nao pode ser usado com outros modos nem com --diario, --historico ou --lote.\n");
+        return 1;
+    }
+
+    if (caminhoServidor != NULL && caminhoCliente != NULL) {
+        fprintf(stderr, "ERRO: --servidor nao pode ser usado com --cliente.\n");
+        return 1;
+    }
+    if ((caminhoServidor != NULL || caminhoCliente != NULL) &&
+        (numJogadas > 0 || ordemPlanejada != NULL || numPecasAnalise > 0 || numSessoes > 0 || hzTempoReal > 0 ||
+         caminhoDiario != NULL || capacidadeHistorico > 0 || capacidadeCanal > 0 || usarTabuleiro ||
+         caminhoRestaurar != NULL || caminhoSalvar != NULL || roteiro != NULL)) {
+        fprintf(stderr, "ERRO: --servidor e --cliente nao podem ser usados com outros modos nem com --diario, --historico,\n"
+                        "      --canal, --tabuleiro, --restaurar, --salvar ou --lote.\n");
+        return 1;
+    }
+
+    if (caminhoAssistir != NULL &&
+        (numJogadas > 0 || ordemPlanejada != NULL || numPecasAnalise > 0 || numSessoes > 0 || hzTempoReal > 0 ||
+         caminhoServidor != NULL || caminhoCliente != NULL || caminhoReproducao != NULL || caminhoTransmitir != NULL ||
+         caminhoDiario != NULL || capacidadeHistorico > 0 || capacidadeCanal > 0 || usarTabuleiro ||
+         caminhoRestaurar != NULL || caminhoSalvar != NULL || roteiro != NULL)) {
+        fprintf(stderr, "ERRO: --assistir nao pode ser usado com outros modos nem com --transmitir, --diario, --historico,\n"
+                        "      --canal, --tabuleiro, --restaurar, --salvar ou --lote.\n");
+        return 1;
+    }
+    if (caminhoTransmitir != NULL &&
+        (numJogadas > 0 || ordemPlanejada != NULL || numPecasAnalise > 0 || caminhoCliente != NULL || caminhoReproducao != NULL)) {
+        fprintf(stderr, "ERRO: --transmitir nao pode ser usado com --jogador, --planejar, --analisar, --cliente ou --reproduzir.\n");
+        return 1;
+    }
+
+    // Espectador: exibe uma sessão publicada por outro processo com --transmitir
+    if (caminhoAssistir != NULL) {
+        return executarEspectador(caminhoAssistir, sessaoAssistida, intervaloMs, duracao);
+    }
+
+    // Reprodução de um diário gravado com --diario
+    if (caminhoReproducao != NULL) {
+        return diarioReproduzir(caminhoReproducao);
+    }
+
+    // Teste de carga com várias sessões simultâneas
+    if (numSessoes > 0) {
+        modoSilencioso = true;
+        return executarCargaSessoes(numSessoes, numTrabalhadores, numAcoes,
+                                    capacidadeFila, capacidadePilha, semente,
+                                    caminhoRestaurar, caminhoSalvar, usarTabuleiro, caminhoTransmitir);
+    }
+
+    // Servidor local: uma sessão por conexão no socket Unix
+    if (caminhoServidor != NULL) {
+        modoSilencioso = true;
+        return executarServidor(caminhoServidor, maxClientes, capacidadeFila, capacidadePilha, semente, duracao,
+                                 caminhoTransmitir);
+    }
+
+    // Cliente de carga do servidor: numClientes jogadores simulados
+    if (caminhoCliente != NULL) {
+        return executarClienteServidor(caminhoCliente, numClientes, numAcoes, semente);
+    }
+
+    // Analisador: estatísticas da sequência de peças, em todas as threads
+    if (numPecasAnalise > 0) {
+        modoSilencioso = true;
+        return executarAnalisador(numPecasAnalise, numPassosAnalise, numTrabalhadores, semente,
+                                  capacidadeFila, capacidadePilha);
+    }
+
+    // Jogador automático: joga sozinho em um tabuleiro e mede a vazão
+    if (numJogadas > 0) {
+        modoSilencioso = true;
+        if (!iniciarSessao(&filaPrincipal, &pilhaReserva, capacidadeFila, capacidadePilha, semente,
+                           caminhoRestaurar, &tabuleiro)) {
+            return 1;
+        }
+        int status = executarJogador(&filaPrincipal, &pilhaReserva, numJogadas, larguraFeixe,
+                                     numTrabalhadores, tempoJogadaMs / 1e3);
+        if (status == 0 && caminhoSalvar != NULL && !instantaneoSalvar(&filaPrincipal, &pilhaReserva, caminhoSalvar)) {
+            status = 1;
+        }
+        liberarFila(&filaPrincipal);
+        liberarPilha(&pilhaReserva);
+        return status;
+    }
+
+    // Planejador: procura as ações que jogam as peças na ordem pedida (a sessão não é alterada)
+    if (ordemPlanejada != NULL) {
+        if (!iniciarSessao(&filaPrincipal, &pilhaReserva, capacidadeFila, capacidadePilha, semente,
+                           caminhoRestaurar, NULL)) {
+            return 1;
+        }
+        int status = executarPlanejador(&filaPrincipal, &pilhaReserva, ordemPlanejada, maxAcoesPlano);
+        liberarFila(&filaPrincipal);
+        liberarPilha(&pilhaReserva);
+        return status;
+    }
+
+    // Laço em tempo real: passos fixos, gravidade e teclas sem esperar pelo menu
+    if (hzTempoReal > 0) {
+        if (!iniciarSessao(&filaPrincipal, &pilhaReserva, capacidadeFila, capacidadePilha, semente,
+                           caminhoRestaurar, usarTabuleiro ? &tabuleiro : NULL)) {
+            return 1;
+        }
+        if ((caminhoTransmitir != NULL &&
+             !iniciarTransmissao(&transmissao, caminhoTransmitir, &filaPrincipal, &pilhaReserva)) ||
+            (capacidadeCanal > 0 && !canalIniciar(&canal, &filaPrincipal, (uint64_t)capacidadeCanal))) {
+            encerrarTransmissao();
+            liberarFila(&filaPrincipal);
+            liberarPilha(&pilhaReserva);
+            return 1;
+        }
+        int status = executarTempoReal(&filaPrincipal, &pilhaReserva, hzTempoReal, quedaMs, duracao,
+                                       margemTempoRealUs, transmissaoPrincipal);
+        encerrarTransmissao();
+        if (filaPrincipal.canal != NULL) canalEncerrar(&canal, &filaPrincipal);
+        if (status == 0 && caminhoSalvar != NULL && !instantaneoSalvar(&filaPrincipal, &pilhaReserva, caminhoSalvar)) {
+            status = 1;
+        }
+        liberarFila(&filaPrincipal);
+        liberarPilha(&pilhaReserva);
+        return status;
+    }
+
+    // O histórico só é criado depois de iniciarSessao: --restaurar troca
+    // tamanhoTroca pelo do instantâneo, e o delta da ação 5 depende dele
+    renderizador.opcoesHistorico = capacidadeHistorico > 0;
+
+    // Entrada redirecionada (pipe ou arquivo): sem menu nem quadros, como em --lote -
+    if (roteiro == NULL && !forcarInterativo && !isatty(STDIN_FILENO)) roteiro = "-";
+
+    if (roteiro != NULL) {
+        FILE *entrada = strcmp(roteiro, "-") == 0 ? stdin : fopen(roteiro, "rb");
+        if (entrada == NULL) {
+            fprintf(stderr, "ERRO: Nao foi possivel abrir o roteiro '%s'.\n", roteiro);
+            return 1;
+        }
 
-    // 1. Inicializa as estruturas
-    inicializarPilha(&pilhaReserva);
-    inicializarFila(&filaPrincipal);
+        modoSilencioso = true;
+        estatisticas.ativa = exibirEstatisticas;
+        int status = 1;
+        if (iniciarSessao(&filaPrincipal, &pilhaReserva, capacidadeFila, capacidadePilha, semente, caminhoRestaurar,
+                          usarTabuleiro ? &tabuleiro : NULL)) {
+            bool pronto = true;
+            if (capacidadeHistorico > 0) {
+                pronto = historicoInicializar(&historico, capacidadeHistorico, tamanhoTroca, usarTabuleiro);
+                if (pronto) historicoAtivo = &historico;
+            }
+            if (pronto && caminhoDiario != NULL &&
+                diarioAbrir(&diario, caminhoDiario, &filaPrincipal, &pilhaReserva, capacidadeHistorico)) {
+                diarioAtivo = &diario;
+            }
+            if (pronto && (caminhoDiario == NULL || diarioAtivo != NULL) &&
+                (caminhoTransmitir == NULL ||
+                 iniciarTransmissao(&transmissao, caminhoTransmitir, &filaPrincipal, &pilhaReserva)) &&
+                (capacidadeCanal == 0 || canalIniciar(&canal, &filaPrincipal, (uint64_t)capacidadeCanal))) {
+                status = executarLote(entrada, &filaPrincipal, &pilhaReserva, diarioAtivo, historicoAtivo);
+            }
+            encerrarTransmissao();
+            if (diarioAtivo != NULL && !diarioFechar(diarioAtivo)) status = 1;
+            if (filaPrincipal.canal != NULL) {
+                // Só depois de encerrar a thread produtora os contadores dela ficam finais
+                canalEncerrar(&canal, &filaPrincipal);
+                printf("Canal de pecas: %llu posicoes | esperas do jogo: %llu | esperas do produtor: %llu\n",
+                       (unsigned long long)canal.capacidade,
+                       (unsigned long long)canal.esperasConsumidor,
+                       (unsigned long long)canal.esperasProdutor);
+            }
+            if (status == 0 && exibirEstatisticas) estatisticasExibir(stdout, formatoEstatisticas);
+            if (status == 0 && caminhoSalvar != NULL && !instantaneoSalvar(&filaPrincipal, &pilhaReserva, caminhoSalvar)) {
+                status = 1;
+            }
+            liberarFila(&filaPrincipal);
+            liberarPilha(&pilhaReserva);
+        }
+        if (historicoAtivo != NULL) historicoLiberar(historicoAtivo);
+        if (entrada != stdin) fclose(entrada);
+        return status;
+    }
+
+    // 1. Inicializa (ou restaura) as estruturas
+    if (!iniciarSessao(&filaPrincipal, &pilhaReserva, capacidadeFila, capacidadePilha, semente, caminhoRestaurar,
+                          usarTabuleiro ? &tabuleiro : NULL)) {
+        return 1;
+    }
+    if (capacidadeHistorico > 0) {
+        if (!historicoInicializar(&historico, capacidadeHistorico, tamanhoTroca, usarTabuleiro)) {
+            liberarFila(&filaPrincipal);
+            liberarPilha(&pilhaReserva);
+            return 1;
+        }
+        historicoAtivo = &historico;
+    }
+    if (caminhoDiario != NULL && !diarioAbrir(&diario, caminhoDiario, &filaPrincipal, &pilhaReserva, capacidadeHistorico)) {
+        if (historicoAtivo != NULL) historicoLiberar(historicoAtivo);
+        liberarFila(&filaPrincipal);
+        liberarPilha(&pilhaReserva);
+        return 1;
+    }
+    if (caminhoDiario != NULL) diarioAtivo = &diario;
+    if ((caminhoTransmitir != NULL &&
+         !iniciarTransmissao(&transmissao, caminhoTransmitir, &filaPrincipal, &pilhaReserva)) ||
+        (capacidadeCanal > 0 && !canalIniciar(&canal, &filaPrincipal, (uint64_t)capacidadeCanal))) {
+        encerrarTransmissao();
+        if (diarioAtivo != NULL) diarioFechar(diarioAtivo);
+        if (historicoAtivo != NULL) historicoLiberar(historicoAtivo);
+        liberarFila(&filaPrincipal);
+        liberarPilha(&pilhaReserva);
+        return 1;
+    }
     
+    // No modo interativo a coleta fica sempre ligada (o custo é irrelevante perto do terminal)
+    estatisticas.ativa = true;
+
+    static char linha[TAM_LINHA_COMANDOS];
+    LeitorComandos leitor;
+    int codigo;
+    long long vezes;
+    bool continuar = true;
+
+    leitorIniciar(&leitor);
     do {
         // 2. Exibe o estado atual
+        uint64_t inicioQuadro = estatisticasInicio();
         exibirEstadoAtual(&filaPrincipal, &pilhaReserva);
         
         // 3. Exibe o menu e solicita a opção
         exibirMenu();
+        estatisticasRegistrar(ESTAT_RENDERIZAR, true, inicioQuadro);
         
-        // Leitura e validação básica da entrada
-        if (scanf("%d", &opcao) != 1) {
-            while (getchar() != '\n'); 
-            opcao = -1; 
-            printf("\nERRO: Entrada invalida. Por favor, digite um numero.\n");
-            continue;
-        }
-        
-        // 4. Executa a ação escolhida
-        switch (opcao) {
-            case 1:
-                jogarPeca(&filaPrincipal);
-                break;
-            case 2:
-                reservarPeca(&filaPrincipal, &pilhaReserva);
-                break;
-            case 3:
-                usarPecaReservada(&pilhaReserva);
-                break;
-            case 4:
-                trocarPecaSimples(&filaPrincipal, &pilhaReserva);
-                break;
-            case 5:
-                trocarPecaMultipla(&filaPrincipal, &pilhaReserva);
-                break;
-            case 0:
-                printf("\nSaindo do simulador Mestre. O gerenciamento de pecas foi um sucesso!\n");
-                break;
-            default:
-                printf("\nOPCAO INVALIDA. Por favor, digite 1, 2, 3, 4, 5 ou 0.\n");
+        // 4. Lê uma linha e executa os comandos dela, na ordem: várias ações
+        // ("1 1 2 4") e repetições ("1x1000") custam um único quadro
+        bool algumComando = false;
+        bool algumTexto = false;
+        bool fimLinha = false;
+        while (continuar && !fimLinha) {
+            if (fgets(linha, sizeof(linha), stdin) == NULL) {
+                // Fim da entrada: executa o comando pendente e sai
+                if (leitorFinalizar(&leitor, &codigo, &vezes)) {
+                    continuar = executarComandoInterativo(&filaPrincipal, &pilhaReserva, historicoAtivo,
+                                                          diarioAtivo, codigo, vezes);
+                }
+                if (continuar) continuar = executarComandoInterativo(&filaPrincipal, &pilhaReserva, historicoAtivo,
+                                                                     diarioAtivo, 0, 1);
                 break;
+            }
+            for (const char *c = linha; *c != '\0' && continuar; c++) {
+                if (*c != ' ' && *c != '\t' && *c != '\r' && *c != '\n') algumTexto = true;
+                if (leitorConsumir(&leitor, *c, &codigo, &vezes)) {
+                    algumComando = true;
+                    continuar = executarComandoInterativo(&filaPrincipal, &pilhaReserva, historicoAtivo,
+                                                          diarioAtivo, codigo, vezes);
+                }
+            }
+            fimLinha = strchr(linha, '\n') != NULL;
+        }
+
+        if (continuar && algumTexto && !algumComando) {
+            printf("\nERRO: Entrada invalida. Por favor, digite um numero.\n");
         }
 
-    } while (opcao != 0);
+    } while (continuar);
 
+    if (exibirEstatisticas) estatisticasExibir(stdout, formatoEstatisticas);
+
+    encerrarTransmissao();
+    if (filaPrincipal.canal != NULL) canalEncerrar(&canal, &filaPrincipal);
+    if (diarioAtivo != NULL) diarioFechar(diarioAtivo);
+    if (historicoAtivo != NULL) historicoLiberar(historicoAtivo);
+    if (caminhoSalvar != NULL && instantaneoSalvar(&filaPrincipal, &pilhaReserva, caminhoSalvar)) {
+        printf("Sessao salva em '%s'.\n", caminhoSalvar);
+    }
+    liberarFila(&filaPrincipal);
+    liberarPilha(&pilhaReserva);
+    bufferLiberar(&renderizador.quadro);
+    bufferLiberar(&renderizador.secaoFila);
+    bufferLiberar(&renderizador.secaoPilha);
+    bufferLiberar(&renderizador.anteriorFila);
+    bufferLiberar(&renderizador.anteriorPilha);
+    bufferLiberar(&renderizador.secaoTabuleiro);
+    bufferLiberar(&renderizador.anteriorTabuleiro);
     return 0;
-}
\ No newline at end of file
+}
+
+#endif // TETRIS_SEM_MAIN
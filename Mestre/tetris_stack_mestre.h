@@ -0,0 +1,98 @@
+#ifndef TETRIS_STACK_MESTRE_H
+#define TETRIS_STACK_MESTRE_H
+
+// Tipos e funções do simulador Mestre (Fila de peças futuras + Pilha de reserva),
+// compartilhados entre tetris_stack_mestre.c e os demais módulos do nível.
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../Comum/gerador_pecas.h"
+
+// --- Constantes ---
+#define MAX_FILA 5   // Capacidade padrão da Fila de Peças Futuras (--fila N)
+#define MAX_PILHA 3  // Capacidade padrão da Pilha de Reserva (--pilha N)
+#define N_TROCA 3    // Tamanho padrão do bloco da Troca Múltipla (--troca N)
+
+// --- Configuração Global ---
+
+// Quando verdadeiro, as ações não imprimem nada (modo em lote / headless).
+extern bool modoSilencioso;
+
+// Quantidade de peças trocadas pela ação 5 (Troca Múltipla).
+extern int tamanhoTroca;
+
+// Imprime a mensagem somente fora do modo silencioso.
+#define MENSAGEM(...) do { if (!modoSilencioso) printf(__VA_ARGS__); } while (0)
+
+// --- Estruturas de Dados ---
+
+struct CanalPecas;     // Canal de peças pré-geradas (canal_pecas.h)
+struct DiarioAcoes;    // Diário binário de ações (diario_acoes.h)
+struct HistoricoAcoes; // Histórico de desfazer/refazer (historico_acoes.h)
+struct Tabuleiro;      // Tabuleiro em bitboard (tabuleiro.h)
+struct Transmissao;    // Transmissão para espectadores (transmissao.h)
+
+// Peca, FilaPecas e PilhaPecas vêm do núcleo compartilhado, com capacidades
+// dinâmicas, pilha de reserva, trocas e os campos próprios do Mestre:
+//   gerador:   gerador de tipos da sessão (determinístico pela semente);
+//   canal:     se não for NULL, gerarPeca consome deste canal;
+//   tabuleiro: se não for NULL, jogarPeca solta a peça neste tabuleiro.
+#define NUCLEO_COM_RESERVA
+#define NUCLEO_COM_TROCA
+#define NUCLEO_FILA_EXTRA        \
+    GeradorPecas gerador;        \
+    struct CanalPecas *canal;    \
+    struct Tabuleiro *tabuleiro;
+#include "../Comum/nucleo_pecas.h"
+
+_Static_assert(GERADOR_NUM_TIPOS == NUCLEO_NUM_TIPOS, "um tipo de peca por valor sorteado");
+
+// --- Protótipos das Funções ---
+
+// Funções de Utilitários e Inicialização
+Peca gerarPeca(FilaPecas *fila);
+void gerarPecas(FilaPecas *fila, Peca *destino, int n);
+uint64_t gerarSemente(void);
+void exibirEstadoAtual(FilaPecas *fila, PilhaPecas *pilha);
+void exibirEstadoComRodape(FilaPecas *fila, PilhaPecas *pilha, const char *rodape, size_t tamanho);
+bool inicializarFila(FilaPecas *fila, int capacidade, uint64_t semente);
+bool inicializarPilha(PilhaPecas *pilha, int capacidade);
+void liberarFila(FilaPecas *fila);
+void liberarPilha(PilhaPecas *pilha);
+
+// Funções de Operações Básicas (Fila)
+bool estaCheiaFila(FilaPecas *fila);
+bool estaVaziaFila(FilaPecas *fila);
+void enqueue(FilaPecas *fila, Peca novaPeca);
+Peca dequeue(FilaPecas *fila);
+
+// Funções de Operações em Bloco (Fila)
+// Retornam false, sem alterar a fila, se n < 0 ou se faltar espaço/peças para as n.
+bool enqueueN(FilaPecas *fila, const Peca *pecas, int n);
+bool dequeueN(FilaPecas *fila, Peca *destino, int n);
+bool peekN(const FilaPecas *fila, Peca *destino, int n);
+
+// Funções de Operações Básicas (Pilha)
+bool estaCheiaPilha(PilhaPecas *pilha);
+bool estaVaziaPilha(PilhaPecas *pilha);
+void push(PilhaPecas *pilha, Peca peca);
+Peca pop(PilhaPecas *pilha);
+int getTamanhoPilha(PilhaPecas *pilha);
+
+// Funções de Lógica do Jogo (Ações do Usuário)
+// Retornam true se a ação foi executada e false se foi recusada (AVISO).
+bool jogarPeca(FilaPecas *fila);
+bool reservarPeca(FilaPecas *fila, PilhaPecas *pilha);
+bool usarPecaReservada(PilhaPecas *pilha);
+bool trocarPecaSimples(FilaPecas *fila, PilhaPecas *pilha);
+bool trocarPecaMultipla(FilaPecas *fila, PilhaPecas *pilha, int n);
+bool executarAcao(FilaPecas *fila, PilhaPecas *pilha, int opcao);
+
+// Funções do Modo em Lote (Headless)
+int executarLote(FILE *entrada, FilaPecas *fila, PilhaPecas *pilha, struct DiarioAcoes *diario,
+                 struct HistoricoAcoes *historico);
+double tempoAtual(void);
+
+#endif // TETRIS_STACK_MESTRE_H
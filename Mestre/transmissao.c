@@ -0,0 +1,333 @@
+#define _POSIX_C_SOURCE 200809L // mmap, ftruncate, nanosleep, kill
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "transmissao.h"
+#include "canal_pecas.h" // canalPausar
+
+// --- Funções Auxiliares ---
+
+static size_t tamanhoSessaoTransmitida(int capacidadeFila, int capacidadePilha) {
+    size_t bytes = sizeof(SessaoTransmitida) + (size_t)(capacidadeFila + capacidadePilha) * sizeof(uint32_t);
+    return (bytes + TRANSMISSAO_ALINHAMENTO - 1) & ~(size_t)(TRANSMISSAO_ALINHAMENTO - 1);
+}
+
+static inline SessaoTransmitida *sessaoTransmitida(unsigned char *mapa, size_t tamanhoSessao, int sessao) {
+    return (SessaoTransmitida *)(mapa + sizeof(CabecalhoTransmissao) + (size_t)sessao * tamanhoSessao);
+}
+
+/**
+ * @brief Abre a escrita de uma sessão (sequência ímpar).
+ * @return A sequência par anterior, para fecharEscrita.
+ */
+static inline uint32_t abrirEscrita(SessaoTransmitida *s) {
+    uint32_t sequencia = atomic_load_explicit(&s->sequencia, memory_order_relaxed);
+    atomic_store_explicit(&s->sequencia, sequencia + 1, memory_order_relaxed);
+    // Os campos gravados a seguir não ficam visíveis antes da sequência ímpar
+    atomic_thread_fence(memory_order_release);
+    return sequencia;
+}
+
+static inline void fecharEscrita(SessaoTransmitida *s, uint32_t sequencia) {
+    atomic_store_explicit(&s->sequencia, sequencia + 2, memory_order_release);
+}
+
+// --- Escritor ---
+
+/**
+ * @brief Cria o arquivo da transmissão com numSessoes sessões inativas e o mapeia.
+ * @return false se os parâmetros forem inválidos ou o arquivo não puder ser criado.
+ */
+bool transmissaoCriar(Transmissao *t, const char *caminho, int numSessoes, int capacidadeFila, int capacidadePilha) {
+    memset(t, 0, sizeof(*t));
+    if (numSessoes <= 0 || capacidadeFila <= 0 || capacidadePilha <= 0) return false;
+
+    t->numSessoes = numSessoes;
+    t->capacidadeFila = capacidadeFila;
+    t->capacidadePilha = capacidadePilha;
+    t->tamanhoSessao = tamanhoSessaoTransmitida(capacidadeFila, capacidadePilha);
+    t->tamanhoMapa = sizeof(CabecalhoTransmissao) + (size_t)numSessoes * t->tamanhoSessao;
+
+    size_t tamanhoCaminho = strlen(caminho);
+    char *temporario = malloc(tamanhoCaminho + sizeof(".tmp"));
+    if (temporario == NULL) return false;
+    memcpy(temporario, caminho, tamanhoCaminho);
+    memcpy(temporario + tamanhoCaminho, ".tmp", sizeof(".tmp"));
+
+    // O arquivo novo nasce zerado: todas as sessões inativas, com sequência 0
+    bool ok = false;
+    int fd = open(temporario, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0 && ftruncate(fd, (off_t)t->tamanhoMapa) == 0) {
+        void *mapa = mmap(NULL, t->tamanhoMapa, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapa != MAP_FAILED) {
+            t->mapa = mapa;
+            t->cabecalho = mapa;
+            memcpy(t->cabecalho->magica, TRANSMISSAO_MAGICA, sizeof(t->cabecalho->magica));
+            t->cabecalho->versao = TRANSMISSAO_VERSAO;
+            t->cabecalho->ordemBytes = TRANSMISSAO_ORDEM_BYTES;
+            t->cabecalho->numSessoes = numSessoes;
+            t->cabecalho->capacidadeFila = capacidadeFila;
+            t->cabecalho->capacidadePilha = capacidadePilha;
+            t->cabecalho->tamanhoSessao = (uint32_t)t->tamanhoSessao;
+            t->cabecalho->pidEscritor = (int64_t)getpid();
+            ok = true;
+        }
+    }
+    if (fd >= 0) close(fd);
+    if (ok) ok = rename(temporario, caminho) == 0;
+
+    if (!ok) {
+        fprintf(stderr, "ERRO: Nao foi possivel criar a transmissao '%s'.\n", caminho);
+        if (t->mapa != NULL) munmap(t->mapa, t->tamanhoMapa);
+        t->mapa = NULL;
+        unlink(temporario);
+    }
+    free(temporario);
+    return ok;
+}
+
+/**
+ * @brief Publica o estado atual da sessão (só a thread dona da sessão escreve nela).
+ * * Custo: duas escritas da sequência e uma por peça; nenhuma espera.
+ */
+void transmissaoPublicar(Transmissao *t, int sessao, const FilaPecas *fila, const PilhaPecas *pilha) {
+    SessaoTransmitida *s = sessaoTransmitida(t->mapa, t->tamanhoSessao, sessao);
+    uint32_t sequencia = abrirEscrita(s);
+
+    atomic_store_explicit(&s->ativa, 1, memory_order_relaxed);
+    atomic_store_explicit(&s->publicacoes, atomic_load_explicit(&s->publicacoes, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+    atomic_store_explicit(&s->frente, fila->frente, memory_order_relaxed);
+    atomic_store_explicit(&s->contadorFila, fila->contador, memory_order_relaxed);
+    atomic_store_explicit(&s->topo, pilha->topo, memory_order_relaxed);
+    atomic_store_explicit(&s->proximoId, fila->proximo_id, memory_order_relaxed);
+    for (int i = 0; i < t->capacidadeFila; i++) {
+        atomic_store_explicit(&s->pecas[i], compactarPeca(fila->itens[i]), memory_order_relaxed);
+    }
+    for (int i = 0; i <= pilha->topo; i++) {
+        atomic_store_explicit(&s->pecas[t->capacidadeFila + i], compactarPeca(pilha->itens[i]), memory_order_relaxed);
+    }
+
+    fecharEscrita(s, sequencia);
+}
+
+/**
+ * @brief Marca a sessão como inativa (ex.: a conexão do servidor foi fechada).
+ */
+void transmissaoRetirar(Transmissao *t, int sessao) {
+    SessaoTransmitida *s = sessaoTransmitida(t->mapa, t->tamanhoSessao, sessao);
+    uint32_t sequencia = abrirEscrita(s);
+    atomic_store_explicit(&s->ativa, 0, memory_order_relaxed);
+    fecharEscrita(s, sequencia);
+}
+
+/**
+ * @brief Marca a transmissão como encerrada e desfaz o mapeamento. O arquivo
+ * fica com o último estado de cada sessão.
+ */
+void transmissaoFechar(Transmissao *t) {
+    if (t->mapa == NULL) return;
+    atomic_store_explicit(&t->cabecalho->encerrada, 1, memory_order_release);
+    munmap(t->mapa, t->tamanhoMapa);
+    memset(t, 0, sizeof(*t));
+}
+
+// --- Espectador ---
+
+/**
+ * @brief Mapeia a transmissão só para leitura e confere o cabeçalho.
+ * @return false se o arquivo não existir ou não for uma transmissão válida.
+ */
+bool transmissaoAbrir(LeitorTransmissao *l, const char *caminho) {
+    memset(l, 0, sizeof(*l));
+
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "ERRO: Nao foi possivel abrir a transmissao '%s'.\n", caminho);
+        return false;
+    }
+    struct stat info;
+    bool valido = fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(CabecalhoTransmissao);
+    void *mapa = valido ? mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        fprintf(stderr, "ERRO: '%s' nao e uma transmissao valida.\n", caminho);
+        return false;
+    }
+
+    // O layout é determinado pelas contagens: basta recalculá-lo e comparar
+    const CabecalhoTransmissao *cabecalho = mapa;
+    valido = memcmp(cabecalho->magica, TRANSMISSAO_MAGICA, sizeof(cabecalho->magica)) == 0 &&
+             cabecalho->versao == TRANSMISSAO_VERSAO && cabecalho->ordemBytes == TRANSMISSAO_ORDEM_BYTES &&
+             cabecalho->numSessoes > 0 && cabecalho->capacidadeFila > 0 && cabecalho->capacidadePilha > 0 &&
+             cabecalho->tamanhoSessao == tamanhoSessaoTransmitida(cabecalho->capacidadeFila, cabecalho->capacidadePilha) &&
+             (size_t)info.st_size == sizeof(CabecalhoTransmissao) +
+                                     (size_t)cabecalho->numSessoes * cabecalho->tamanhoSessao;
+    if (!valido) {
+        fprintf(stderr, "ERRO: '%s' nao e uma transmissao valida (versao %d, desta arquitetura).\n",
+                caminho, TRANSMISSAO_VERSAO);
+        munmap(mapa, (size_t)info.st_size);
+        return false;
+    }
+
+    l->mapa = mapa;
+    l->tamanhoMapa = (size_t)info.st_size;
+    l->cabecalho = cabecalho;
+    l->numSessoes = cabecalho->numSessoes;
+    l->capacidadeFila = cabecalho->capacidadeFila;
+    l->capacidadePilha = cabecalho->capacidadePilha;
+    l->tamanhoSessao = cabecalho->tamanhoSessao;
+    return true;
+}
+
+/**
+ * @brief Copia o estado coerente de uma sessão, sem bloquear o escritor.
+ * * A cópia é refeita enquanto o escritor estiver no meio de uma publicação,
+ * até TRANSMISSAO_MAX_TENTATIVAS vezes.
+ * @return false se a sessão não existir ou o escritor não deu uma janela.
+ */
+bool transmissaoLer(const LeitorTransmissao *l, int sessao, EstadoTransmitido *estado) {
+    if (sessao < 0 || sessao >= l->numSessoes) return false;
+    SessaoTransmitida *s = sessaoTransmitida((unsigned char *)l->mapa, l->tamanhoSessao, sessao);
+    int totalPecas = l->capacidadeFila + l->capacidadePilha;
+    unsigned tentativasPausa = 0;
+
+    for (int tentativa = 0; tentativa < TRANSMISSAO_MAX_TENTATIVAS; tentativa++) {
+        uint32_t antes = atomic_load_explicit(&s->sequencia, memory_order_acquire);
+        if (antes & 1u) {
+            canalPausar(&tentativasPausa);
+            continue;
+        }
+
+        estado->ativa = atomic_load_explicit(&s->ativa, memory_order_relaxed) != 0;
+        estado->publicacoes = atomic_load_explicit(&s->publicacoes, memory_order_relaxed);
+        estado->frente = atomic_load_explicit(&s->frente, memory_order_relaxed);
+        estado->contadorFila = atomic_load_explicit(&s->contadorFila, memory_order_relaxed);
+        estado->topo = atomic_load_explicit(&s->topo, memory_order_relaxed);
+        estado->proximoId = atomic_load_explicit(&s->proximoId, memory_order_relaxed);
+        for (int i = 0; i < totalPecas; i++) {
+            estado->pecas[i] = atomic_load_explicit(&s->pecas[i], memory_order_relaxed);
+        }
+
+        // As leituras acima terminam antes da releitura da sequência
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&s->sequencia, memory_order_relaxed) == antes) {
+            estado->sequencia = antes;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief O escritor encerrou a transmissão, ou o processo dele não existe mais
+ * (terminou sem transmissaoFechar, ex.: SIGKILL).
+ */
+bool transmissaoEncerrada(const LeitorTransmissao *l) {
+    CabecalhoTransmissao *cabecalho = (CabecalhoTransmissao *)l->cabecalho;
+    if (atomic_load_explicit(&cabecalho->encerrada, memory_order_acquire) != 0) return true;
+    return kill((pid_t)cabecalho->pidEscritor, 0) != 0 && errno == ESRCH;
+}
+
+void transmissaoLiberarLeitor(LeitorTransmissao *l) {
+    if (l->mapa != NULL) munmap((void *)l->mapa, l->tamanhoMapa);
+    memset(l, 0, sizeof(*l));
+}
+
+// --- Modo Espectador ---
+
+/**
+ * @brief Monta uma FilaPecas/PilhaPecas com o estado copiado, para o renderizador.
+ * @return false se o estado for incoerente com as capacidades.
+ */
+static bool montarSessao(const LeitorTransmissao *l, const EstadoTransmitido *estado, FilaPecas *fila, PilhaPecas *pilha) {
+    if (estado->frente < 0 || estado->frente >= l->capacidadeFila || estado->contadorFila < 0 ||
+        estado->contadorFila > l->capacidadeFila || estado->topo < -1 || estado->topo >= l->capacidadePilha) {
+        return false;
+    }
+    for (int i = 0; i < l->capacidadeFila; i++) fila->itens[i] = expandirPeca(estado->pecas[i]);
+    for (int i = 0; i <= estado->topo; i++) pilha->itens[i] = expandirPeca(estado->pecas[l->capacidadeFila + i]);
+    fila->frente = estado->frente;
+    fila->contador = estado->contadorFila;
+    fila->tras = (estado->frente + estado->contadorFila + l->capacidadeFila - 1) % l->capacidadeFila;
+    fila->proximo_id = estado->proximoId;
+    pilha->topo = estado->topo;
+    return true;
+}
+
+/**
+ * @brief Modo --assistir: lê a sessão a cada intervaloMs e exibe um quadro
+ * quando ela muda, até o escritor encerrar a transmissão (ou a duração acabar).
+ * * Toda a renderização acontece neste processo; o escritor só publica.
+ * @param duracao Segundos de execução (0 = até o escritor encerrar).
+ * @return Código de saída do programa.
+ */
+int executarEspectador(const char *caminho, int sessao, int intervaloMs, double duracao) {
+    LeitorTransmissao leitor;
+    if (!transmissaoAbrir(&leitor, caminho)) return 1;
+    if (sessao < 0 || sessao >= leitor.numSessoes) {
+        fprintf(stderr, "ERRO: A transmissao '%s' tem %d sessoes (0 a %d).\n",
+                caminho, leitor.numSessoes, leitor.numSessoes - 1);
+        transmissaoLiberarLeitor(&leitor);
+        return 1;
+    }
+
+    FilaPecas fila = {0};
+    PilhaPecas pilha = {0};
+    EstadoTransmitido estado;
+    fila.capacidade = leitor.capacidadeFila;
+    pilha.capacidade = leitor.capacidadePilha;
+    fila.itens = malloc((size_t)leitor.capacidadeFila * sizeof(Peca));
+    pilha.itens = malloc((size_t)leitor.capacidadePilha * sizeof(Peca));
+    estado.pecas = malloc((size_t)(leitor.capacidadeFila + leitor.capacidadePilha) * sizeof(PecaCompacta));
+    if (fila.itens == NULL || pilha.itens == NULL || estado.pecas == NULL) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para o espectador.\n");
+        free(fila.itens);
+        free(pilha.itens);
+        free(estado.pecas);
+        transmissaoLiberarLeitor(&leitor);
+        return 1;
+    }
+
+    struct timespec pausa = {intervaloMs / 1000, (long)(intervaloMs % 1000) * 1000000L};
+    double fim = duracao > 0 ? tempoAtual() + duracao : 0;
+    uint32_t ultimaSequencia = UINT32_MAX;
+    long long leituras = 0, quadros = 0, desistencias = 0;
+    bool encerrada = false;
+
+    while (!encerrada && (fim == 0 || tempoAtual() < fim)) {
+        // Lida antes da sessão: o último estado publicado ainda é exibido
+        encerrada = transmissaoEncerrada(&leitor);
+        if (!transmissaoLer(&leitor, sessao, &estado)) {
+            desistencias++;
+        } else {
+            leituras++;
+            if (estado.sequencia != ultimaSequencia && estado.ativa && montarSessao(&leitor, &estado, &fila, &pilha)) {
+                char rodape[128];
+                int tamanho = snprintf(rodape, sizeof(rodape), "Espectador: sessao %d | publicacao %u%s\n",
+                                       sessao, estado.publicacoes, encerrada ? " | transmissao encerrada" : "");
+                exibirEstadoComRodape(&fila, &pilha, rodape, (size_t)tamanho);
+                ultimaSequencia = estado.sequencia;
+                quadros++;
+            }
+        }
+        if (!encerrada) nanosleep(&pausa, NULL);
+    }
+
+    fprintf(stderr, "Espectador: %lld leituras | %lld quadros | %lld desistencias (escritor no meio de uma publicacao)\n",
+            leituras, quadros, desistencias);
+    free(fila.itens);
+    free(pilha.itens);
+    free(estado.pecas);
+    transmissaoLiberarLeitor(&leitor);
+    return 0;
+}
@@ -0,0 +1,123 @@
+#ifndef TRANSMISSAO_H
+#define TRANSMISSAO_H
+
+// Transmissão das sessões para espectadores (--transmitir <arquivo>).
+//
+// O simulador publica a fila e a pilha de cada sessão em uma região de
+// memória compartilhada (um arquivo mapeado com MAP_SHARED; em /dev/shm ele
+// nunca vai para o disco). Qualquer número de processos espectadores
+// (--assistir <arquivo>) mapeia o arquivo só para leitura e lê cópias
+// coerentes sem travas: o escritor nunca espera por eles nem sabe que existem.
+//
+// Cada sessão é protegida por um seqlock, com um único escritor (a thread
+// dona da sessão):
+//   escritor: sequencia++ (ímpar), grava os campos, sequencia++ (par);
+//   leitor:   lê a sequencia (par), copia os campos e relê a sequencia; se
+//             mudou, a cópia pode estar misturada e é refeita.
+// Os campos são atômicos lidos e gravados com memory_order_relaxed (sem
+// corrida de dados no sentido do C11), e as cercas de liberação/aquisição
+// ordenam os campos em relação à sequência.
+//
+// Layout: um CabecalhoTransmissao de 64 bytes seguido de numSessoes blocos
+// de tamanhoSessao bytes (múltiplo de 64, uma sessão nunca divide linha de
+// cache com outra). As peças vão como PecaCompacta nas posições físicas
+// (fila: índices do anel; pilha: níveis a partir da base).
+//
+// O arquivo é criado como '<arquivo>.tmp' e renomeado, como o instantâneo:
+// um espectador que ainda mapeia o arquivo anterior continua lendo o antigo
+// (e vê a marca de encerrado), sem SIGBUS por truncamento.
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tetris_stack_mestre.h"
+#include "peca_compacta.h"
+
+// --- Constantes ---
+#define TRANSMISSAO_MAGICA "TTRSTRAN"
+#define TRANSMISSAO_VERSAO 1
+#define TRANSMISSAO_ORDEM_BYTES 0x01020304u
+#define TRANSMISSAO_ALINHAMENTO 64
+#define TRANSMISSAO_MAX_TENTATIVAS 1000    // Releituras do seqlock antes de desistir (escritor muito ativo)
+#define TRANSMISSAO_INTERVALO_PADRAO_MS 100 // Período de leitura do espectador (--intervalo)
+
+// --- Estruturas de Dados ---
+
+typedef struct {
+    char magica[8];             // TRANSMISSAO_MAGICA (sem o '\0')
+    uint32_t versao;            // TRANSMISSAO_VERSAO
+    uint32_t ordemBytes;        // TRANSMISSAO_ORDEM_BYTES
+    int32_t numSessoes;
+    int32_t capacidadeFila;
+    int32_t capacidadePilha;
+    uint32_t tamanhoSessao;     // Bytes de cada sessão
+    int64_t pidEscritor;
+    _Atomic uint32_t encerrada; // O escritor terminou: as sessões não mudam mais
+    uint8_t reservado[20];
+} CabecalhoTransmissao;
+
+_Static_assert(sizeof(CabecalhoTransmissao) == TRANSMISSAO_ALINHAMENTO, "cabecalho em uma linha de cache");
+
+typedef struct {
+    _Atomic uint32_t sequencia;    // Par: estável; ímpar: escrita em andamento
+    _Atomic uint32_t ativa;        // 0 = sessão sem dono (conexão fechada, ainda não publicada)
+    _Atomic uint32_t publicacoes;  // Publicações desde a criação
+    _Atomic int32_t frente;
+    _Atomic int32_t contadorFila;
+    _Atomic int32_t topo;
+    _Atomic int32_t proximoId;
+    _Atomic uint32_t reservado;
+    _Atomic uint32_t pecas[];      // capacidadeFila peças da fila e capacidadePilha da pilha
+} SessaoTransmitida;
+
+// Lado do escritor
+typedef struct Transmissao {
+    unsigned char *mapa;
+    size_t tamanhoMapa;
+    CabecalhoTransmissao *cabecalho;
+    int numSessoes;
+    int capacidadeFila;
+    int capacidadePilha;
+    size_t tamanhoSessao;
+} Transmissao;
+
+// Lado do espectador
+typedef struct {
+    const unsigned char *mapa;
+    size_t tamanhoMapa;
+    const CabecalhoTransmissao *cabecalho;
+    int numSessoes;
+    int capacidadeFila;
+    int capacidadePilha;
+    size_t tamanhoSessao;
+} LeitorTransmissao;
+
+// Cópia coerente de uma sessão (as capacidades vêm do cabeçalho)
+typedef struct {
+    uint32_t sequencia;
+    bool ativa;
+    uint32_t publicacoes;
+    int frente;
+    int contadorFila;
+    int topo;
+    int proximoId;
+    PecaCompacta *pecas; // Vetor do chamador com capacidadeFila + capacidadePilha posições
+} EstadoTransmitido;
+
+// --- Protótipos das Funções ---
+
+bool transmissaoCriar(Transmissao *t, const char *caminho, int numSessoes, int capacidadeFila, int capacidadePilha);
+void transmissaoPublicar(Transmissao *t, int sessao, const FilaPecas *fila, const PilhaPecas *pilha);
+void transmissaoRetirar(Transmissao *t, int sessao);
+void transmissaoFechar(Transmissao *t);
+
+bool transmissaoAbrir(LeitorTransmissao *l, const char *caminho);
+bool transmissaoLer(const LeitorTransmissao *l, int sessao, EstadoTransmitido *estado);
+bool transmissaoEncerrada(const LeitorTransmissao *l);
+void transmissaoLiberarLeitor(LeitorTransmissao *l);
+
+int executarEspectador(const char *caminho, int sessao, int intervaloMs, double duracao);
+
+#endif // TRANSMISSAO_H
@@ -2,30 +2,25 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdbool.h>
+#include <string.h>
 
 // Definição do tamanho máximo da fila de peças
 #define MAX_SIZE 5
 
 // --- Estrutura de Dados ---
 
-// Estrutura para representar uma peça
-typedef struct {
-    char nome; // Tipo da peça ('I', 'O', 'T', 'L')
-    int id;    // Identificador único da peça
-} Peca;
+// Peca e FilaPecas vêm do núcleo compartilhado: fila de capacidade fixa,
+// sem pilha de reserva nem trocas.
+#define NUCLEO_CAPACIDADE_FILA MAX_SIZE
+#define NUCLEO_FILA_EXTRA GeradorPecas gerador; // Gerador de tipos da partida
+#include "../Comum/gerador_pecas.h"
+#include "../Comum/nucleo_pecas.h"
 
-// Estrutura para a Fila Circular
-typedef struct {
-    Peca itens[MAX_SIZE];
-    int frente;   // Índice da frente da fila (onde a remoção ocorre)
-    int tras;     // Índice do final da fila (onde a inserção ocorre)
-    int contador; // Número atual de elementos na fila
-    int proximo_id; // Contador para gerar IDs únicos
-} FilaPecas;
+_Static_assert(GERADOR_NUM_TIPOS == NUCLEO_NUM_TIPOS, "um tipo de peca por valor sorteado");
 
 // --- Protótipos das Funções ---
 
-void inicializarFila(FilaPecas *fila);
+void inicializarFila(FilaPecas *fila, uint64_t semente);
 Peca gerarPeca(FilaPecas *fila);
 bool estaCheia(FilaPecas *fila);
 bool estaVazia(FilaPecas *fila);
@@ -39,30 +34,27 @@ void executarAcao(FilaPecas *fila, int opcao);
 
 /**
  * @brief Inicializa a fila de peças.
- * * Define os índices de frente, trás e o contador de elementos como zero.
+ * * Zera a frente e o contador (a primeira inserção vai para a posição 0).
  * Pré-popula a fila com peças geradas automaticamente.
  * * @param fila Ponteiro para a estrutura FilaPecas.
+ * @param semente Semente do gerador de tipos da partida.
  */
-void inicializarFila(FilaPecas *fila) {
-    fila->frente = 0;
-    fila->tras = -1; // -1 indica que a fila está vazia (ou pode ser 0 e usar contador)
-    fila->contador = 0;
-    fila->proximo_id = 0;
+void inicializarFila(FilaPecas *fila, uint64_t semente) {
+    nucleoIniciarFila(fila);
     
-    // Inicializa o gerador de números aleatórios para o tipo da peça
-    srand((unsigned int)time(NULL));
+    // A mesma semente reproduz a mesma sequência de peças
+    geradorSemear(&fila->gerador, semente);
 
     // Pré-popula a fila com um número fixo de elementos (MAX_SIZE)
     printf("--- Inicializacao da Fila ---\n");
     for (int i = 0; i < MAX_SIZE; i++) {
         Peca p = gerarPeca(fila);
-        // O enqueue aqui é simplificado para a inicialização
-        fila->tras = (fila->tras + 1) % MAX_SIZE;
-        fila->itens[fila->tras] = p;
-        fila->contador++;
+        // Enqueue sem a mensagem de sucesso da ação 2
+        nucleoEnqueue(fila, p);
         printf("Peca inicial gerada e inserida: [%c %d]\n", p.nome, p.id);
     }
-    printf("Fila de pecas inicializada com %d elementos.\n\n", fila->contador);
+    printf("Fila de pecas inicializada com %d elementos (semente: %llu).\n\n",
+           fila->contador, (unsigned long long)semente);
 }
 
 /**
@@ -73,19 +65,8 @@ void inicializarFila(FilaPecas *fila) {
  * @return Peca A nova peça gerada.
  */
 Peca gerarPeca(FilaPecas *fila) {
-    Peca novaPeca;
-    
-    // Tipos de peças disponíveis
-    const char tipos[] = {'I', 'O', 'T', 'L'};
-    int num_tipos = sizeof(tipos) / sizeof(tipos[0]);
-    
-    // Sorteia um tipo de peça
-    novaPeca.nome = tipos[rand() % num_tipos];
-    
-    // Atribui e incrementa o ID único
-    novaPeca.id = fila->proximo_id++;
-    
-    return novaPeca;
+    // Sorteia um tipo de peça e atribui o próximo ID único
+    return nucleoCriarPeca(fila, geradorSortearTipo(&fila->gerador));
 }
 
 /**
@@ -96,7 +77,7 @@ Peca gerarPeca(FilaPecas *fila) {
  * @return true se a fila estiver cheia, false caso contrário.
  */
 bool estaCheia(FilaPecas *fila) {
-    return fila->contador == MAX_SIZE;
+    return nucleoFilaCheia(fila);
 }
 
 /**
@@ -106,7 +87,7 @@ bool estaCheia(FilaPecas *fila) {
  * @return true se a fila estiver vazia, false caso contrário.
  */
 bool estaVazia(FilaPecas *fila) {
-    return fila->contador == 0;
+    return nucleoFilaVazia(fila);
 }
 
 /**
@@ -117,16 +98,11 @@ bool estaVazia(FilaPecas *fila) {
  * @param novaPeca A peça a ser inserida.
  */
 void enqueue(FilaPecas *fila, Peca novaPeca) {
-    if (estaCheia(fila)) {
+    if (!nucleoEnqueue(fila, novaPeca)) {
         printf("\nERRO: A fila esta cheia! Nao e possivel adicionar mais pecas.\n");
         return;
     }
     
-    // Move o índice 'tras' circularmente
-    fila->tras = (fila->tras + 1) % MAX_SIZE;
-    fila->itens[fila->tras] = novaPeca;
-    fila->contador++;
-    
     printf("\nSUCESSO: Peça [%c %d] inserida (enqueue) no final da fila.\n", novaPeca.nome, novaPeca.id);
 }
 
@@ -140,18 +116,11 @@ void enqueue(FilaPecas *fila, Peca novaPeca) {
 Peca dequeue(FilaPecas *fila) {
     Peca pecaRemovida = {'\0', -1}; // Peça de retorno padrão para erro
     
-    if (estaVazia(fila)) {
+    if (!nucleoDequeue(fila, &pecaRemovida)) {
         printf("\nERRO: A fila esta vazia! Nao ha pecas para jogar (dequeue).\n");
         return pecaRemovida;
     }
     
-    // Pega a peça na frente
-    pecaRemovida = fila->itens[fila->frente];
-    
-    // Atualiza o índice 'frente' circularmente
-    fila->frente = (fila->frente + 1) % MAX_SIZE;
-    fila->contador--;
-    
     printf("\nSUCESSO: Peça [%c %d] jogada (dequeue) da frente da fila.\n", pecaRemovida.nome, pecaRemovida.id);
     return pecaRemovida;
 }
@@ -231,13 +200,22 @@ void executarAcao(FilaPecas *fila, int opcao) {
 
 // --- Função Principal ---
 
-int main() {
+// TETRIS_SEM_MAIN permite incluir este arquivo em outro programa (ex.: benchmarks).
+#ifndef TETRIS_SEM_MAIN
+
+int main(int argc, char *argv[]) {
     // Declaração da variável que irá armazenar a fila
     FilaPecas filaPrincipal;
     int opcao = -1; // Inicializa com valor diferente de 0
 
     // 1. Inicializa a estrutura da fila e a pré-popula
-    inicializarFila(&filaPrincipal);
+    // Sem --semente, a semente vem do relógio (e é exibida para reproduzir a partida)
+    uint64_t semente = (uint64_t)time(NULL);
+    if (argc != 1 && !(argc == 3 && strcmp(argv[1], "--semente") == 0 && geradorLerSemente(argv[2], &semente))) {
+        fprintf(stderr, "Uso: %s [--semente N]\n", argv[0]);
+        return 1;
+    }
+    inicializarFila(&filaPrincipal, semente);
     
     do {
         // 2. Exibe o estado atual da fila
@@ -262,4 +240,6 @@ int main() {
     } while (opcao != 0);
 
     return 0;
-}
\ No newline at end of file
+}
+
+#endif // TETRIS_SEM_MAIN
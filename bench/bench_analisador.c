@@ -0,0 +1,51 @@
+// Micro-benchmark do analisador de peças (Mestre/analisador_pecas.h):
+//   - custo por peça das secas e repetições, com 1 thread e com todos os núcleos;
+//   - custo por passo das políticas jogadas em sessões reais.
+
+#include "bench_comum.h"
+
+#define TETRIS_SEM_MAIN
+#include "../Mestre/tetris_stack_mestre.c"
+#include "../Mestre/diario_acoes.c"
+#include "../Mestre/historico_acoes.c"
+#include "../Mestre/estatisticas_acoes.c"
+#include "../Mestre/tabuleiro.c"
+#include "../Mestre/analisador_pecas.c"
+
+#define AMOSTRAS 5
+#define PECAS (1LL << 24)   // Peças por amostra
+#define PASSOS (1LL << 20)  // Passos de cada política por amostra
+
+static double amostras[AMOSTRAS];
+static HistogramasPecas resultado;
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "analisador");
+    modoSilencioso = true;
+
+    int nucleos = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int threads[] = {1, nucleos};
+
+    for (int k = 0; k < (nucleos > 1 ? 2 : 1); k++) {
+        for (int a = 0; a < AMOSTRAS; a++) {
+            double inicio = benchAgoraNs();
+            analisarPecas(PECAS, 0, threads[k], 42 + (uint64_t)a, MAX_FILA, MAX_PILHA, &resultado);
+            amostras[a] = (benchAgoraNs() - inicio) / (double)PECAS;
+            benchSumidouro += resultado.repeticoes;
+        }
+        char operacao[32];
+        snprintf(operacao, sizeof(operacao), "sequencia_threads_%d", threads[k]);
+        benchRegistrar(operacao, amostras, AMOSTRAS);
+    }
+
+    for (int a = 0; a < AMOSTRAS; a++) {
+        double inicio = benchAgoraNs();
+        analisarPecas(1, PASSOS, 1, 42 + (uint64_t)a, MAX_FILA, MAX_PILHA, &resultado);
+        amostras[a] = (benchAgoraNs() - inicio) / (double)(PASSOS * NUM_POLITICAS);
+        benchSumidouro += resultado.trocaAceita[0];
+    }
+    benchRegistrar("politicas_passo", amostras, AMOSTRAS);
+
+    benchFinalizar();
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Micro-benchmark do avanço de índices do buffer circular:
+// operador '%' (forma original da FilaPecas) x anel especializado
+// (máscara para potências de dois, comparação para as demais capacidades).
+
+#include "bench_comum.h"
+#include "../Comum/anel_circular.h"
+
+// --- Anel com '%' (forma original) ---
+
+#define ANEL_MODULO_DEFINIR(NOME, CAP)                                       \
+    typedef struct { int itens[CAP]; int frente, tras, contador; } NOME;     \
+    static inline bool NOME##_inserir(NOME *a, int item) {                   \
+        if (a->contador == (CAP)) return false;                              \
+        a->tras = (a->tras + 1) % (CAP);                                     \
+        a->itens[a->tras] = item;                                            \
+        a->contador++;                                                       \
+        return true;                                                         \
+    }                                                                        \
+    static inline bool NOME##_remover(NOME *a, int *item) {                  \
+        if (a->contador == 0) return false;                                  \
+        *item = a->itens[a->frente];                                         \
+        a->frente = (a->frente + 1) % (CAP);                                 \
+        a->contador--;                                                       \
+        return true;                                                         \
+    }
+
+ANEL_MODULO_DEFINIR(AnelModulo5, 5)
+ANEL_MODULO_DEFINIR(AnelModulo8, 8)
+ANEL_DEFINIR(Anel5, int, 5)
+ANEL_DEFINIR(Anel8, int, 8)
+
+// Capacidade conhecida só em tempo de execução: '%' vira uma divisão real
+static int capacidadeDinamica = 5;
+
+typedef struct { int itens[8]; int frente, tras, contador; } AnelDinamico;
+
+static inline void anelDinamicoCiclo(AnelDinamico *a, int cap, int item, int *saida) {
+    a->tras = (a->tras + 1) % cap;
+    a->itens[a->tras] = item;
+    *saida = a->itens[a->frente];
+    a->frente = (a->frente + 1) % cap;
+}
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "anel");
+
+    AnelModulo5 m5 = {{0}, 0, 4, 4};
+    AnelModulo8 m8 = {{0}, 0, 7, 7};
+    Anel5 a5;
+    Anel8 a8;
+    AnelDinamico d = {{0}, 0, 4, 4};
+    int item = 0;
+
+    Anel5_inicializar(&a5);
+    Anel8_inicializar(&a8);
+    for (int i = 0; i < 4; i++) Anel5_inserir(&a5, i);
+    for (int i = 0; i < 7; i++) Anel8_inserir(&a8, i);
+
+    BENCH_ESCAPAR(&m5); BENCH_ESCAPAR(&m8); BENCH_ESCAPAR(&a5);
+    BENCH_ESCAPAR(&a8); BENCH_ESCAPAR(&d); BENCH_ESCAPAR(&capacidadeDinamica);
+
+    // Cada operação medida é um par inserir + remover (fila em regime)
+    BENCH_MEDIR("modulo_cap5", (void)0,
+                AnelModulo5_inserir(&m5, item); AnelModulo5_remover(&m5, &item); benchSumidouro += item);
+    BENCH_MEDIR("anel_cap5", (void)0,
+                Anel5_inserir(&a5, item); Anel5_remover(&a5, &item); benchSumidouro += item);
+    BENCH_MEDIR("modulo_cap8", (void)0,
+                AnelModulo8_inserir(&m8, item); AnelModulo8_remover(&m8, &item); benchSumidouro += item);
+    BENCH_MEDIR("anel_cap8", (void)0,
+                Anel8_inserir(&a8, item); Anel8_remover(&a8, &item); benchSumidouro += item);
+    BENCH_MEDIR("modulo_dinamico_cap5", (void)0,
+                anelDinamicoCiclo(&d, capacidadeDinamica, item, &item); benchSumidouro += item);
+
+    benchFinalizar();
+    return 0;
+}
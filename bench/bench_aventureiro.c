@@ -0,0 +1,39 @@
+// Micro-benchmark das primitivas do Nível Aventureiro (enqueue/dequeue/push/pop).
+// Obs.: push imprime uma mensagem de SUCESSO; o custo do printf
+// (redirecionado para /dev/null) faz parte do tempo medido.
+
+#include "bench_comum.h"
+
+#define TETRIS_SEM_MAIN
+#include "../Aventureiro/tetris_stack_aventureiro.c"
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "aventureiro");
+
+    FilaPecas fila;
+    PilhaPecas pilha;
+    inicializarFila(&fila, 42);
+    inicializarPilha(&pilha);
+    Peca peca = gerarPeca(&fila);
+    BENCH_ESCAPAR(&fila);
+    BENCH_ESCAPAR(&pilha);
+
+    BENCH_MEDIR("enqueue",
+                fila.contador = MAX_FILA - 1,
+                enqueue(&fila, peca); fila.contador--);
+
+    BENCH_MEDIR("dequeue",
+                fila.contador = MAX_FILA,
+                benchSumidouro += dequeue(&fila).id; fila.contador++);
+
+    BENCH_MEDIR("push",
+                pilha.topo = MAX_PILHA - 2,
+                push(&pilha, peca); pilha.topo--);
+
+    BENCH_MEDIR("pop",
+                pilha.topo = MAX_PILHA - 1,
+                benchSumidouro += pop(&pilha).id; pilha.topo++);
+
+    benchFinalizar();
+    return 0;
+}
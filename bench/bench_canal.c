@@ -0,0 +1,63 @@
+// Micro-benchmark do canal de peças (produtor/consumidor sem travas):
+//   - latência individual de jogarPeca com geração na hora x canal;
+//   - vazão do consumidor e esperas dos dois lados para várias capacidades
+//     do canal (capacidades pequenas aumentam a disputa pelos índices).
+
+#include "bench_comum.h"
+
+#define TETRIS_SEM_MAIN
+#include "../Mestre/tetris_stack_mestre.c"
+#include "../Mestre/diario_acoes.c"
+#include "../Mestre/historico_acoes.c"
+#include "../Mestre/estatisticas_acoes.c"
+#include "../Mestre/tabuleiro.c"
+#include "../Mestre/canal_pecas.c"
+
+#define LATENCIAS 1000000     // Ações com latência medida individualmente
+#define PECAS_VAZAO 20000000  // Peças consumidas por capacidade testada
+
+static double latencias[LATENCIAS];
+
+static void medirLatenciaJogar(const char *operacao, FilaPecas *fila) {
+    for (int i = 0; i < LATENCIAS; i++) {
+        double inicio = benchAgoraNs();
+        jogarPeca(fila);
+        latencias[i] = benchAgoraNs() - inicio;
+    }
+    benchRegistrarLatencias(operacao, latencias, LATENCIAS);
+}
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "canal");
+    modoSilencioso = true;
+
+    FilaPecas fila;
+    CanalPecas canal;
+    inicializarFila(&fila, MAX_FILA, 42);
+
+    medirLatenciaJogar("jogarPeca_gerador_inline", &fila);
+
+    canalIniciar(&canal, &fila, CANAL_CAPACIDADE_PADRAO);
+    medirLatenciaJogar("jogarPeca_canal_4096", &fila);
+    canalEncerrar(&canal, &fila);
+
+    const uint64_t capacidades[] = {16, 256, 4096, 65536};
+    for (size_t c = 0; c < sizeof(capacidades) / sizeof(capacidades[0]); c++) {
+        canalIniciar(&canal, &fila, capacidades[c]);
+        double inicio = benchAgoraNs();
+        for (int i = 0; i < PECAS_VAZAO; i++) {
+            benchSumidouro += canalReceber(&canal).id;
+        }
+        double ns = (benchAgoraNs() - inicio) / PECAS_VAZAO;
+        canalEncerrar(&canal, &fila); // Contadores do produtor finais
+        fprintf(benchSaida,
+                "{\"nivel\":\"canal\",\"op\":\"canalReceber_vazao\",\"rotulo\":\"%s\",\"capacidade\":%llu,"
+                "\"pecas\":%d,\"ns_peca\":%.3f,\"pecas_s\":%.0f,\"esperas_consumidor\":%llu,\"esperas_produtor\":%llu}\n",
+                benchRotulo, (unsigned long long)canal.capacidade, PECAS_VAZAO, ns, 1e9 / ns,
+                (unsigned long long)canal.esperasConsumidor, (unsigned long long)canal.esperasProdutor);
+    }
+
+    liberarFila(&fila);
+    benchFinalizar();
+    return 0;
+}
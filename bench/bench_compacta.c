@@ -0,0 +1,65 @@
+// Micro-benchmark das representações compactas de peças (Mestre/peca_compacta.h):
+// conversão Peca <-> PecaCompacta, fila de tipos de 2 bits por peça e
+// preenchimento da fila de tipos direto do gerador.
+
+#include "bench_comum.h"
+
+#define TETRIS_SEM_MAIN
+#include "../Mestre/tetris_stack_mestre.c"
+#include "../Mestre/diario_acoes.c"
+#include "../Mestre/historico_acoes.c"
+#include "../Mestre/estatisticas_acoes.c"
+#include "../Mestre/tabuleiro.c"
+#include "../Mestre/peca_compacta.h"
+
+#define ANTEVISAO (1 << 20) // Peças na fila de antevisão longa
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "compacta");
+    modoSilencioso = true;
+
+    FilaPecas fila;
+    FilaTipos tipos;
+    inicializarFila(&fila, MAX_FILA, 42);
+    filaTiposInicializar(&tipos, ANTEVISAO, 0);
+    BENCH_ESCAPAR(&fila);
+    BENCH_ESCAPAR(&tipos);
+
+    Peca peca = gerarPeca(&fila);
+    PecaCompacta compacta = compactarPeca(peca);
+
+    BENCH_MEDIR("compactarPeca", (void)0,
+                benchSumidouro += compactarPeca(peca); peca.id++);
+    BENCH_MEDIR("expandirPeca", (void)0,
+                benchSumidouro += expandirPeca(compacta).id; compacta += 4);
+
+    // Par inserir + remover com a fila de tipos em regime
+    filaTiposPreencher(&tipos, &fila.gerador);
+    filaTiposRemover(&tipos);
+    BENCH_MEDIR("filaTipos_inserir_remover", (void)0,
+                filaTiposInserir(&tipos, (int)(benchSumidouro & 3)); benchSumidouro += filaTiposRemover(&tipos));
+
+    // Reabastecimento da antevisão inteira (ns por peça)
+    // (uma chamada por amostra: BENCH_MEDIR repetiria o reabastecimento 2^18 vezes)
+    double amostras[BENCH_AMOSTRAS];
+    for (int a = 0; a < BENCH_AMOSTRAS; a++) {
+        tipos.contador = 0;
+        tipos.frente = 0;
+        double inicio = benchAgoraNs();
+        filaTiposPreencher(&tipos, &fila.gerador);
+        BENCH_BARREIRA();
+        amostras[a] = (benchAgoraNs() - inicio) / ANTEVISAO;
+    }
+    benchRegistrar("filaTiposPreencher_por_peca", amostras, BENCH_AMOSTRAS);
+
+    fprintf(benchSaida,
+            "{\"nivel\":\"compacta\",\"op\":\"memoria_antevisao\",\"rotulo\":\"%s\",\"pecas\":%d,"
+            "\"bytes_peca\":%zu,\"bytes_peca_compacta\":%zu,\"bytes_fila_tipos\":%zu}\n",
+            benchRotulo, ANTEVISAO, (size_t)ANTEVISAO * sizeof(Peca),
+            (size_t)ANTEVISAO * sizeof(PecaCompacta), (size_t)ANTEVISAO / 4);
+
+    filaTiposLiberar(&tipos);
+    liberarFila(&fila);
+    benchFinalizar();
+    return 0;
+}
@@ -0,0 +1,133 @@
+#ifndef BENCH_COMUM_H
+#define BENCH_COMUM_H
+
+// Infraestrutura comum dos micro-benchmarks das primitivas de Fila e Pilha.
+// Cada nível (Novato, Aventureiro, Mestre) tem seu próprio executável, que
+// inclui o .c do nível com TETRIS_SEM_MAIN e usa as macros abaixo.
+//
+// Saída: uma linha JSON por primitiva (JSON Lines), para comparar execuções
+// entre commits. Tudo o que as primitivas imprimem é descartado.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+// --- Constantes ---
+#define BENCH_AMOSTRAS 25           // Repetições de cada medição
+#define BENCH_ITERACOES (1 << 18)   // Operações por repetição
+
+// --- Estado do Benchmark ---
+
+static FILE *benchSaida = NULL;          // Destino dos resultados (stdout original)
+static const char *benchNivel = "";      // Nível medido ("novato", "aventureiro", "mestre")
+static const char *benchRotulo = "";     // Rótulo livre (ex.: hash do commit)
+static volatile long long benchSumidouro; // Impede que o compilador descarte as operações
+
+// Torna o objeto visível ao "mundo externo" para o otimizador e impede que
+// as escritas feitas a cada iteração sejam eliminadas como mortas.
+#define BENCH_ESCAPAR(ptr) __asm__ __volatile__("" : : "g"(ptr) : "memory")
+#define BENCH_BARREIRA() __asm__ __volatile__("" : : : "memory")
+
+/**
+ * @brief Retorna o instante atual de um relógio monotônico, em nanossegundos.
+ */
+static inline double benchAgoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Prepara a saída dos resultados e silencia a saída padrão.
+ * * Os resultados vão para uma cópia do stdout original; o stdout das
+ * primitivas (mensagens de SUCESSO/ERRO) passa a apontar para /dev/null.
+ * @param argv argv[1] opcional é usado como rótulo da execução.
+ */
+static void benchIniciar(int argc, char *argv[], const char *nivel) {
+    benchNivel = nivel;
+    benchRotulo = argc > 1 ? argv[1] : "";
+
+    fflush(stdout);
+    benchSaida = fdopen(dup(STDOUT_FILENO), "w");
+    if (benchSaida == NULL || freopen("/dev/null", "w", stdout) == NULL) {
+        fprintf(stderr, "ERRO: Nao foi possivel preparar a saida do benchmark.\n");
+        exit(1);
+    }
+}
+
+static void benchFinalizar(void) {
+    fflush(benchSaida);
+}
+
+static int benchCompararDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Calcula as estatísticas das amostras (ns/op) e emite uma linha JSON.
+ */
+static void benchRegistrar(const char *operacao, double amostras[], int n) {
+    double soma = 0.0, somaQuadrados = 0.0;
+    for (int i = 0; i < n; i++) soma += amostras[i];
+    double media = soma / n;
+    for (int i = 0; i < n; i++) somaQuadrados += (amostras[i] - media) * (amostras[i] - media);
+    double desvio = n > 1 ? sqrt(somaQuadrados / (n - 1)) : 0.0;
+
+    qsort(amostras, (size_t)n, sizeof(double), benchCompararDouble);
+    double mediana = amostras[n / 2];
+
+    fprintf(benchSaida,
+            "{\"nivel\":\"%s\",\"op\":\"%s\",\"rotulo\":\"%s\",\"amostras\":%d,\"iteracoes\":%d,"
+            "\"ns_op_media\":%.3f,\"ns_op_mediana\":%.3f,\"ns_op_min\":%.3f,\"ns_op_max\":%.3f,"
+            "\"ns_op_desvio\":%.3f,\"ops_s\":%.0f}\n",
+            benchNivel, operacao, benchRotulo, n, BENCH_ITERACOES,
+            media, mediana, amostras[0], amostras[n - 1], desvio, media > 0 ? 1e9 / media : 0.0);
+}
+
+/**
+ * @brief Emite os percentis de um conjunto de latências individuais (ns).
+ */
+static void benchRegistrarLatencias(const char *operacao, double latencias[], int n) {
+    qsort(latencias, (size_t)n, sizeof(double), benchCompararDouble);
+    double soma = 0.0;
+    for (int i = 0; i < n; i++) soma += latencias[i];
+
+    fprintf(benchSaida,
+            "{\"nivel\":\"%s\",\"op\":\"%s\",\"rotulo\":\"%s\",\"amostras\":%d,"
+            "\"ns_media\":%.1f,\"ns_p50\":%.1f,\"ns_p90\":%.1f,\"ns_p99\":%.1f,"
+            "\"ns_p999\":%.1f,\"ns_max\":%.1f}\n",
+            benchNivel, operacao, benchRotulo, n, soma / n,
+            latencias[n / 2], latencias[(int)(n * 0.9)], latencias[(int)(n * 0.99)],
+            latencias[(int)(n * 0.999)], latencias[n - 1]);
+}
+
+/**
+ * @brief Mede uma primitiva.
+ * * PREPARO roda uma vez antes de cada amostra (fora do tempo medido);
+ * CORPO roda BENCH_ITERACOES vezes por amostra e deve devolver a estrutura
+ * ao estado inicial (ex.: enqueue seguido de contador--) para que cada
+ * iteração exercite o mesmo caminho. As estruturas usadas em CORPO devem
+ * ter sido passadas antes a BENCH_ESCAPAR.
+ */
+#define BENCH_MEDIR(operacao, PREPARO, CORPO)                                   \
+    do {                                                                        \
+        double amostras_[BENCH_AMOSTRAS];                                       \
+        for (int a_ = 0; a_ < BENCH_AMOSTRAS; a_++) {                           \
+            PREPARO;                                                            \
+            double inicio_ = benchAgoraNs();                                    \
+            for (int i_ = 0; i_ < BENCH_ITERACOES; i_++) {                      \
+                CORPO;                                                          \
+                BENCH_BARREIRA();                                               \
+            }                                                                   \
+            amostras_[a_] = (benchAgoraNs() - inicio_) / BENCH_ITERACOES;       \
+        }                                                                       \
+        benchRegistrar((operacao), amostras_, BENCH_AMOSTRAS);                  \
+    } while (0)
+
+#endif // BENCH_COMUM_H
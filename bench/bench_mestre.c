@@ -0,0 +1,118 @@
+// Micro-benchmark das primitivas do Nível Mestre
+// (enqueue/dequeue/push/pop/trocarPecaSimples/trocarPecaMultipla),
+// operações em bloco da fila, geração de peças, desfazer/refazer e
+// renderização do estado.
+
+#include "bench_comum.h"
+
+#define TETRIS_SEM_MAIN
+#include "../Mestre/tetris_stack_mestre.c"
+#include "../Mestre/diario_acoes.c"
+#include "../Mestre/historico_acoes.c"
+#include "../Mestre/estatisticas_acoes.c"
+#include "../Mestre/tabuleiro.c"
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "mestre");
+    modoSilencioso = true;
+
+    FilaPecas fila;
+    PilhaPecas pilha;
+    inicializarFila(&fila, MAX_FILA, 42);
+    inicializarPilha(&pilha, MAX_PILHA);
+    Peca peca = gerarPeca(&fila);
+    BENCH_ESCAPAR(&fila);
+    BENCH_ESCAPAR(&pilha);
+
+    // Geração de peças: uma a uma (ns por peça) e em lote (ns por chamada de
+    // 4096 peças). Os ids recomeçam a cada amostra: o lote gera peças demais
+    // para caber no int de proximo_id
+    static Peca lote[4096];
+    BENCH_MEDIR("gerarPeca", fila.proximo_id = 0,
+                benchSumidouro += gerarPeca(&fila).nome);
+    BENCH_MEDIR("gerarPecas_4096", fila.proximo_id = 0,
+                gerarPecas(&fila, lote, 4096); benchSumidouro += lote[4095].nome);
+
+    BENCH_MEDIR("enqueue",
+                fila.contador = MAX_FILA - 1,
+                enqueue(&fila, peca); fila.contador--);
+
+    BENCH_MEDIR("dequeue",
+                fila.contador = MAX_FILA,
+                benchSumidouro += dequeue(&fila).id; fila.contador++);
+
+    BENCH_MEDIR("push",
+                pilha.topo = MAX_PILHA - 2,
+                push(&pilha, peca); pilha.topo--);
+
+    BENCH_MEDIR("pop",
+                pilha.topo = MAX_PILHA - 1,
+                benchSumidouro += pop(&pilha).id; pilha.topo++);
+
+    // As trocas são involuções: repetir a ação alterna entre dois estados válidos
+    BENCH_MEDIR("trocarPecaSimples",
+                fila.contador = MAX_FILA; pilha.topo = MAX_PILHA - 1,
+                benchSumidouro += trocarPecaSimples(&fila, &pilha));
+
+    BENCH_MEDIR("trocarPecaMultipla",
+                fila.contador = MAX_FILA; pilha.topo = MAX_PILHA - 1,
+                benchSumidouro += trocarPecaMultipla(&fila, &pilha, N_TROCA));
+
+    // Operações em bloco: 256 peças por chamada numa fila de 512 que dá a
+    // volta no vetor (frente no meio), comparadas à mesma cópia peça a peça
+    FilaPecas grande;
+    PilhaPecas reserva;
+    inicializarFila(&grande, 2 * 256, 42);
+    inicializarPilha(&reserva, 256);
+    reserva.topo = 256 - 1;
+    BENCH_ESCAPAR(&grande);
+    BENCH_ESCAPAR(&reserva);
+#define PREPARAR_GRANDE grande.frente = 400; grande.tras = 400 - 1; grande.contador = 0
+    BENCH_MEDIR("enqueue_x256",
+                PREPARAR_GRANDE,
+                for (int k = 0; k < 256; k++) enqueue(&grande, lote[k]);
+                grande.contador = 0; grande.tras = 400 - 1);
+    BENCH_MEDIR("enqueueN_256",
+                PREPARAR_GRANDE,
+                enqueueN(&grande, lote, 256);
+                grande.contador = 0; grande.tras = 400 - 1);
+    BENCH_MEDIR("dequeue_x256",
+                PREPARAR_GRANDE; enqueueN(&grande, lote, 256),
+                for (int k = 0; k < 256; k++) lote[k] = dequeue(&grande);
+                grande.contador = 256; grande.frente = 400);
+    BENCH_MEDIR("dequeueN_256",
+                PREPARAR_GRANDE; enqueueN(&grande, lote, 256),
+                dequeueN(&grande, lote, 256);
+                grande.contador = 256; grande.frente = 400);
+    BENCH_MEDIR("peekN_256",
+                PREPARAR_GRANDE; enqueueN(&grande, lote, 256),
+                benchSumidouro += peekN(&grande, lote, 256));
+    BENCH_MEDIR("trocarPecaMultipla_256",
+                PREPARAR_GRANDE; enqueueN(&grande, lote, 256),
+                benchSumidouro += trocarPecaMultipla(&grande, &reserva, 256));
+#undef PREPARAR_GRANDE
+    liberarFila(&grande);
+    liberarPilha(&reserva);
+
+    // Ação registrada no histórico seguida de desfazer (o estado volta ao inicial)
+    HistoricoAcoes historico;
+    historicoInicializar(&historico, HISTORICO_CAPACIDADE_PADRAO, N_TROCA, false);
+    BENCH_ESCAPAR(&historico);
+    BENCH_MEDIR("historico_jogar_desfazer",
+                fila.contador = MAX_FILA; pilha.topo = -1,
+                historicoAplicar(&historico, &fila, &pilha, 1);
+                benchSumidouro += historicoDesfazer(&historico, &fila, &pilha));
+    BENCH_MEDIR("historico_desfazer_refazer",
+                fila.contador = MAX_FILA; pilha.topo = -1; historicoAplicar(&historico, &fila, &pilha, 2),
+                historicoDesfazer(&historico, &fila, &pilha);
+                benchSumidouro += historicoRefazer(&historico, &fila, &pilha));
+    historicoLiberar(&historico);
+
+    // Renderização do quadro completo (emitido em /dev/null)
+    BENCH_MEDIR("exibirEstadoAtual",
+                fila.contador = MAX_FILA; pilha.topo = MAX_PILHA - 1,
+                exibirEstadoAtual(&fila, &pilha));
+
+    benchFinalizar();
+    return 0;
+}
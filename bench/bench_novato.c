@@ -0,0 +1,30 @@
+// Micro-benchmark das primitivas do Nível Novato (enqueue/dequeue).
+// Obs.: no Novato as primitivas imprimem mensagens; o custo do printf
+// (redirecionado para /dev/null) faz parte do tempo medido.
+
+#include "bench_comum.h"
+
+#define TETRIS_SEM_MAIN
+#include "../Novato/tetris_stack_fila.c"
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "novato");
+
+    FilaPecas fila;
+    inicializarFila(&fila, 42);
+    Peca peca = gerarPeca(&fila);
+    BENCH_ESCAPAR(&fila);
+
+    // enqueue: a fila fica com uma vaga; o contador é restaurado a cada iteração
+    BENCH_MEDIR("enqueue",
+                fila.contador = MAX_SIZE - 1,
+                enqueue(&fila, peca); fila.contador--);
+
+    // dequeue: a fila fica cheia; o contador é restaurado a cada iteração
+    BENCH_MEDIR("dequeue",
+                fila.contador = MAX_SIZE,
+                benchSumidouro += dequeue(&fila).id; fila.contador++);
+
+    benchFinalizar();
+    return 0;
+}
@@ -0,0 +1,69 @@
+// Micro-benchmark do planejador de ações (Mestre/planejador.h):
+//   - latência de uma consulta em sessões sorteadas, para filas de 5 a 64
+//     peças e a pilha padrão, com a ordem pedida sorteada entre 2 e 8 peças;
+//   - estados visitados por consulta e fração das ordens com plano.
+
+#include "bench_comum.h"
+
+#define TETRIS_SEM_MAIN
+#include "../Mestre/tetris_stack_mestre.c"
+#include "../Mestre/diario_acoes.c"
+#include "../Mestre/historico_acoes.c"
+#include "../Mestre/estatisticas_acoes.c"
+#include "../Mestre/tabuleiro.c"
+#include "../Mestre/planejador.c"
+
+#define CONSULTAS 2000 // Consultas por tamanho de fila
+#define ACOES_ANTES 8  // Ações sorteadas antes de cada consulta (pilha não vazia)
+
+static const int TAMANHOS_FILA[] = {5, 16, 32, 64};
+static double latencias[CONSULTAS];
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "planejador");
+    modoSilencioso = true;
+
+    Planejador planejador;
+    if (!planejadorCriar(&planejador, PLANEJADOR_BITS_TABELA)) return 1;
+    GeradorPecas gerador;
+    geradorSemear(&gerador, 42);
+
+    for (size_t f = 0; f < sizeof(TAMANHOS_FILA) / sizeof(TAMANHOS_FILA[0]); f++) {
+        long long nos = 0, encontrados = 0;
+
+        for (int c = 0; c < CONSULTAS; c++) {
+            FilaPecas fila;
+            PilhaPecas pilha;
+            inicializarFila(&fila, TAMANHOS_FILA[f], geradorProximo64(&gerador));
+            inicializarPilha(&pilha, MAX_PILHA);
+            for (int i = 0; i < ACOES_ANTES; i++) executarAcao(&fila, &pilha, 1 + (int)(geradorProximo64(&gerador) % 5));
+
+            char ordem[9];
+            int tamanho = 2 + (int)(geradorProximo64(&gerador) % 7);
+            for (int i = 0; i < tamanho; i++) ordem[i] = TIPOS_PECA[geradorSortearTipo(&gerador)];
+            ordem[tamanho] = '\0';
+
+            PlanoAcoes plano;
+            double inicio = benchAgoraNs();
+            planejar(&planejador, &fila, &pilha, ordem, PLANEJADOR_ACOES_PADRAO, &plano);
+            latencias[c] = benchAgoraNs() - inicio;
+            nos += plano.nos;
+            encontrados += plano.encontrado;
+
+            liberarFila(&fila);
+            liberarPilha(&pilha);
+        }
+
+        char operacao[32];
+        snprintf(operacao, sizeof(operacao), "planejar_fila_%d", TAMANHOS_FILA[f]);
+        benchRegistrarLatencias(operacao, latencias, CONSULTAS);
+        fprintf(benchSaida,
+                "{\"nivel\":\"planejador\",\"op\":\"resumo_fila_%d\",\"rotulo\":\"%s\",\"nos_por_consulta\":%.1f,"
+                "\"com_plano\":%.3f}\n",
+                TAMANHOS_FILA[f], benchRotulo, (double)nos / CONSULTAS, (double)encontrados / CONSULTAS);
+    }
+
+    planejadorDestruir(&planejador);
+    benchFinalizar();
+    return 0;
+}
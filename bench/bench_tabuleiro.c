@@ -0,0 +1,82 @@
+// Micro-benchmark do tabuleiro em bitboard (Mestre/tabuleiro.h):
+//   - teste de colisão de uma forma;
+//   - colocação em rotação e coluna fixas e com a escolha da posição
+//     (tabuleiroSoltarPeca), com tipos sorteados pelo gerador;
+//   - jogarPeca com e sem tabuleiro ligado à fila;
+//   - latência de uma jogada do jogador automático (busca em feixe, 1 thread).
+
+#include "bench_comum.h"
+
+#define TETRIS_SEM_MAIN
+#include "../Mestre/tetris_stack_mestre.c"
+#include "../Mestre/diario_acoes.c"
+#include "../Mestre/historico_acoes.c"
+#include "../Mestre/estatisticas_acoes.c"
+#include "../Mestre/tabuleiro.c"
+#include "../Mestre/jogador_automatico.c"
+
+#define JOGADAS_JOGADOR 2000 // Jogadas com latência medida individualmente
+
+static double latencias[JOGADAS_JOGADOR];
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "tabuleiro");
+    modoSilencioso = true;
+
+    Tabuleiro tabuleiro;
+    GeradorPecas gerador;
+    FilaPecas fila;
+    tabuleiroLimpar(&tabuleiro);
+    geradorSemear(&gerador, 42);
+    inicializarFila(&fila, MAX_FILA, 42);
+    BENCH_ESCAPAR(&tabuleiro);
+    BENCH_ESCAPAR(&gerador);
+    BENCH_ESCAPAR(&fila);
+
+    // Tabuleiro em regime (algumas centenas de peças já colocadas)
+    for (int i = 0; i < 500; i++) tabuleiroSoltarPeca(&tabuleiro, geradorSortearTipo(&gerador));
+
+    const FormaPeca *forma = tabuleiroForma(2, 0); // T
+    BENCH_MEDIR("tabuleiroColide", (void)0,
+                benchSumidouro += tabuleiroColide(&tabuleiro, forma, (int)(benchSumidouro & 7),
+                                                  (int)(benchSumidouro & 15)));
+    BENCH_MEDIR("tabuleiroColocar", (void)0,
+                benchSumidouro += tabuleiroColocar(&tabuleiro, 0, 0, (int)(benchSumidouro & 3) * 2).eliminadas);
+    BENCH_MEDIR("tabuleiroSoltarPeca", (void)0,
+                benchSumidouro += tabuleiroSoltarPeca(&tabuleiro, geradorSortearTipo(&gerador)).linha);
+
+    BENCH_MEDIR("jogarPeca_sem_tabuleiro", (void)0, benchSumidouro += jogarPeca(&fila));
+    fila.tabuleiro = &tabuleiro;
+    BENCH_MEDIR("jogarPeca_com_tabuleiro", (void)0, benchSumidouro += jogarPeca(&fila));
+
+    fprintf(benchSaida,
+            "{\"nivel\":\"tabuleiro\",\"op\":\"resumo\",\"rotulo\":\"%s\",\"pecas\":%lld,"
+            "\"linhas_eliminadas\":%lld,\"partidas\":%lld,\"bytes_tabuleiro\":%zu}\n",
+            benchRotulo, tabuleiro.pecas, tabuleiro.linhasEliminadas, tabuleiro.partidas, sizeof(Tabuleiro));
+
+    // Jogador automático na fila padrão (5 peças de antevisão)
+    JogadorAutomatico jogador;
+    PilhaPecas pilha;
+    inicializarPilha(&pilha, MAX_PILHA);
+    tabuleiroLimpar(&tabuleiro);
+    jogadorCriar(&jogador, JOGADOR_LARGURA_PADRAO, 1, 0.0);
+    double inicioJogador = benchAgoraNs();
+    for (int i = 0; i < JOGADAS_JOGADOR; i++) {
+        double inicio = benchAgoraNs();
+        jogadorJogar(&jogador, &fila, &pilha);
+        latencias[i] = benchAgoraNs() - inicio;
+    }
+    double nsJogador = benchAgoraNs() - inicioJogador;
+    benchRegistrarLatencias("jogadorJogar_feixe_64", latencias, JOGADAS_JOGADOR);
+    fprintf(benchSaida,
+            "{\"nivel\":\"tabuleiro\",\"op\":\"jogador_vazao\",\"rotulo\":\"%s\",\"feixe\":%d,\"threads\":1,"
+            "\"nos_s\":%.0f,\"linhas_por_peca\":%.3f}\n",
+            benchRotulo, JOGADOR_LARGURA_PADRAO, (double)jogadorAvaliados(&jogador) * 1e9 / nsJogador,
+            tabuleiro.pecas > 0 ? (double)tabuleiro.linhasEliminadas / (double)tabuleiro.pecas : 0.0);
+    jogadorDestruir(&jogador);
+    liberarPilha(&pilha);
+
+    liberarFila(&fila);
+    benchFinalizar();
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Benchmark do laço em tempo real (Mestre/tempo_real.h): um jogador simulado
+// escreve teclas em um pipe em instantes sorteados (0 a 2 períodos entre duas
+// teclas) enquanto o laço roda a 120 passos/s; mede o atraso ao acordar e a
+// latência tecla -> quadro, só com ppoll e com a espera ativa padrão.
+
+#define _GNU_SOURCE // ppoll (tempo_real.c), antes de qualquer cabeçalho do sistema
+
+#include "bench_comum.h"
+
+#include <pthread.h>
+
+#define TETRIS_SEM_MAIN
+#include "../Mestre/tetris_stack_mestre.c"
+#include "../Mestre/diario_acoes.c"
+#include "../Mestre/historico_acoes.c"
+#include "../Mestre/estatisticas_acoes.c"
+#include "../Mestre/tabuleiro.c"
+#include "../Mestre/entrada_terminal.c"
+#include "../Mestre/tempo_real.c"
+#include "../Mestre/transmissao.c"
+
+#define HZ 120
+#define DURACAO 3.0 // Segundos por configuração
+
+typedef struct {
+    int fd;          // Extremidade de escrita do pipe
+    double duracao;
+    uint64_t semente;
+} JogadorSimulado;
+
+static void *jogarTeclas(void *arg) {
+    JogadorSimulado *j = arg;
+    GeradorPecas gerador;
+    geradorSemear(&gerador, j->semente);
+    double fim = benchAgoraNs() + j->duracao * 1e9;
+    while (benchAgoraNs() < fim) {
+        // Ações 1 a 4: a 5 seria quase sempre recusada com a pilha padrão
+        char tecla = (char)('1' + geradorSortearTipo(&gerador));
+        if (write(j->fd, &tecla, 1) != 1) break;
+        uint64_t espera = geradorProximo64(&gerador) % (2 * 1000000000ULL / HZ);
+        struct timespec ts = {0, (long)espera};
+        nanosleep(&ts, NULL);
+    }
+    close(j->fd);
+    return NULL;
+}
+
+static void registrarHistograma(const char *operacao, const HistogramaLatencia *h) {
+    fprintf(benchSaida,
+            "{\"nivel\":\"%s\",\"op\":\"%s\",\"rotulo\":\"%s\",\"amostras\":%llu,"
+            "\"ns_media\":%.1f,\"ns_p50\":%llu,\"ns_p90\":%llu,\"ns_p99\":%llu,"
+            "\"ns_p999\":%llu,\"ns_max\":%llu}\n",
+            benchNivel, operacao, benchRotulo, (unsigned long long)h->contagem,
+            h->contagem > 0 ? (double)h->somaNs / (double)h->contagem : 0.0,
+            (unsigned long long)histogramaPercentil(h, 0.50), (unsigned long long)histogramaPercentil(h, 0.90),
+            (unsigned long long)histogramaPercentil(h, 0.99), (unsigned long long)histogramaPercentil(h, 0.999),
+            (unsigned long long)h->maxNs);
+}
+
+static RelatorioTempoReal relatorio;
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "tempo_real");
+    modoSilencioso = true;
+
+    int margens[] = {0, TEMPO_REAL_MARGEM_PADRAO_US};
+    for (int k = 0; k < 2; k++) {
+        FilaPecas fila;
+        PilhaPecas pilha;
+        inicializarFila(&fila, MAX_FILA, 42);
+        inicializarPilha(&pilha, MAX_PILHA);
+
+        int tubo[2];
+        if (pipe(tubo) != 0) return 1;
+        JogadorSimulado jogador = {tubo[1], DURACAO, 7 + (uint64_t)k};
+        pthread_t thread;
+        pthread_create(&thread, NULL, jogarTeclas, &jogador);
+
+        ConfigTempoReal config = {HZ, TEMPO_REAL_QUEDA_PADRAO_MS, DURACAO, margens[k], tubo[0], NULL};
+        tempoRealExecutar(&fila, &pilha, &config, &relatorio);
+        pthread_join(thread, NULL);
+        close(tubo[0]);
+
+        char operacao[64];
+        snprintf(operacao, sizeof(operacao), "atraso_acordar_espera_%dus", margens[k]);
+        registrarHistograma(operacao, &relatorio.atrasoAcordar);
+        snprintf(operacao, sizeof(operacao), "tecla_quadro_espera_%dus", margens[k]);
+        registrarHistograma(operacao, &relatorio.latenciaTecla);
+
+        liberarFila(&fila);
+        liberarPilha(&pilha);
+    }
+
+    benchFinalizar();
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Benchmark da transmissão para espectadores (Mestre/transmissao.h): custo de
+// uma jogada sozinha, seguida de um quadro completo (o que o modo interativo
+// paga por jogada) e seguida de uma publicação no seqlock (o que o simulador
+// paga com --transmitir); e custo de uma leitura coerente do espectador, sem
+// escritor e com um escritor publicando sem parar em outra thread.
+
+#include "bench_comum.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define TETRIS_SEM_MAIN
+#include "../Mestre/tetris_stack_mestre.c"
+#include "../Mestre/diario_acoes.c"
+#include "../Mestre/historico_acoes.c"
+#include "../Mestre/estatisticas_acoes.c"
+#include "../Mestre/tabuleiro.c"
+#include "../Mestre/transmissao.c"
+
+typedef struct {
+    Transmissao *transmissao;
+    atomic_bool parar;
+} EscritorContinuo;
+
+static void *publicarSemParar(void *arg) {
+    EscritorContinuo *e = arg;
+    FilaPecas fila;
+    PilhaPecas pilha;
+    inicializarFila(&fila, MAX_FILA, 7);
+    inicializarPilha(&pilha, MAX_PILHA);
+    while (!atomic_load_explicit(&e->parar, memory_order_relaxed)) {
+        jogarPeca(&fila);
+        transmissaoPublicar(e->transmissao, 1, &fila, &pilha);
+    }
+    liberarFila(&fila);
+    liberarPilha(&pilha);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    benchIniciar(argc, argv, "transmissao");
+    modoSilencioso = true;
+
+    // Em /dev/shm o arquivo nunca vai para o disco
+    char caminho[64];
+    snprintf(caminho, sizeof(caminho), "%s/bench_transmissao_%d",
+             access("/dev/shm", W_OK) == 0 ? "/dev/shm" : "/tmp", (int)getpid());
+
+    FilaPecas fila;
+    PilhaPecas pilha;
+    inicializarFila(&fila, MAX_FILA, 42);
+    inicializarPilha(&pilha, MAX_PILHA);
+    push(&pilha, gerarPeca(&fila));
+    push(&pilha, gerarPeca(&fila));
+
+    Transmissao transmissao;
+    LeitorTransmissao leitor;
+    if (!transmissaoCriar(&transmissao, caminho, 2, MAX_FILA, MAX_PILHA) || !transmissaoAbrir(&leitor, caminho)) {
+        return 1;
+    }
+    BENCH_ESCAPAR(&fila);
+    BENCH_ESCAPAR(&pilha);
+    BENCH_ESCAPAR(&transmissao);
+
+    // A jogada mantém a fila cheia: o estado é válido em qualquer iteração
+    BENCH_MEDIR("jogarPeca", (void)0,
+                benchSumidouro += jogarPeca(&fila));
+    BENCH_MEDIR("jogarPeca_exibirEstadoAtual", (void)0,
+                jogarPeca(&fila); exibirEstadoAtual(&fila, &pilha));
+    BENCH_MEDIR("jogarPeca_transmissaoPublicar", (void)0,
+                jogarPeca(&fila); transmissaoPublicar(&transmissao, 0, &fila, &pilha));
+
+    PecaCompacta pecas[MAX_FILA + MAX_PILHA];
+    EstadoTransmitido estado = {.pecas = pecas};
+    BENCH_ESCAPAR(&estado);
+    BENCH_MEDIR("transmissaoLer", (void)0,
+                benchSumidouro += transmissaoLer(&leitor, 0, &estado) + estado.proximoId);
+
+    // Sessão 1: o escritor publica continuamente (leituras refeitas ou desistências)
+    EscritorContinuo escritor = {&transmissao, false};
+    pthread_t thread;
+    pthread_create(&thread, NULL, publicarSemParar, &escritor);
+    BENCH_MEDIR("transmissaoLer_com_escritor", (void)0,
+                benchSumidouro += transmissaoLer(&leitor, 1, &estado) + estado.proximoId);
+    atomic_store_explicit(&escritor.parar, true, memory_order_relaxed);
+    pthread_join(thread, NULL);
+
+    transmissaoLiberarLeitor(&leitor);
+    transmissaoFechar(&transmissao);
+    unlink(caminho);
+    liberarFila(&fila);
+    liberarPilha(&pilha);
+    benchFinalizar();
+    return 0;
+}
@@ -0,0 +1,43 @@
+#!/bin/sh
+# Compara as variantes de build (make release/lto/pgo) nos caminhos sem
+# terminal do Mestre. Cada carga roda REPETICOES vezes e vale o menor tempo
+# informado pelo próprio programa ("Tempo: X s"). O roteiro usa outra
+# semente que o do treino de PGO.
+# Uso: bench/comparar_variantes.sh [variante...] > resultados.jsonl
+
+set -e
+
+RAIZ=$(dirname "$0")
+BUILD=$RAIZ/../build
+REPETICOES=${REPETICOES:-5}
+TEMP=$(mktemp -d)
+trap 'rm -rf "$TEMP"' EXIT
+
+"$RAIZ/gerar_roteiro.sh" 5000000 99 > "$TEMP/roteiro.txt"
+
+# medir <variante> <carga> <argumentos...>
+medir() {
+    variante=$1
+    carga=$2
+    shift 2
+    melhor=""
+    i=0
+    while [ $i -lt "$REPETICOES" ]; do
+        tempo=$("$BUILD/$variante/tetris_mestre" "$@" | sed -n 's/^Tempo: \([0-9.]*\) s.*/\1/p' | tail -n 1)
+        melhor=$(awk -v a="$tempo" -v b="$melhor" 'BEGIN { print (b == "" || a + 0 < b + 0) ? a : b }')
+        i=$((i + 1))
+    done
+    printf '{"variante":"%s","carga":"%s","segundos":%s}\n' "$variante" "$carga" "$melhor"
+}
+
+for variante in ${*:-release lto pgo}; do
+    if [ ! -x "$BUILD/$variante/tetris_mestre" ]; then
+        echo "AVISO: build/$variante nao foi compilado (make $variante)." >&2
+        continue
+    fi
+    medir "$variante" lote --semente 42 --lote "$TEMP/roteiro.txt"
+    medir "$variante" lote_tabuleiro --semente 42 --tabuleiro --lote "$TEMP/roteiro.txt"
+    medir "$variante" lote_historico --semente 42 --historico 256 --lote "$TEMP/roteiro.txt"
+    medir "$variante" sessoes --semente 42 --sessoes 100000 --acoes 5000000 --trabalhadores 1
+    medir "$variante" analisar --semente 42 --analisar 50000000 --passos 1000000 --trabalhadores 1
+done
@@ -0,0 +1,20 @@
+#!/bin/sh
+# Compila e executa os micro-benchmarks dos três níveis, do buffer circular,
+# do canal de peças, das peças compactas, do tabuleiro, do planejador, do
+# analisador de peças, do laço em tempo real e da transmissão para espectadores.
+# Uso: bench/executar_bench.sh [rotulo] > resultados.jsonl
+# O rótulo padrão é o hash curto do commit atual.
+
+set -e
+cd "$(dirname "$0")"
+
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:-"-std=gnu11 -O2"}
+ROTULO=${1:-$(git rev-parse --short HEAD 2>/dev/null || echo local)}
+SAIDA=$(mktemp -d)
+trap 'rm -rf "$SAIDA"' EXIT
+
+for nivel in novato aventureiro mestre anel canal compacta tabuleiro planejador analisador tempo_real transmissao; do
+    $CC $CFLAGS -pthread -o "$SAIDA/bench_$nivel" "bench_$nivel.c" -lm
+    "$SAIDA/bench_$nivel" "$ROTULO"
+done
@@ -0,0 +1,18 @@
+#!/bin/sh
+# Gera um roteiro sintético de ações (códigos sorteados de 1 a <maior>),
+# 32 códigos por linha e terminado pelo código 0.
+# Uso: bench/gerar_roteiro.sh <acoes> [semente] [maior] > roteiro.txt
+# O padrão de <maior> é 5 (todas as ações do menu Mestre); use 7 com
+# --historico, 3 para o Aventureiro e 2 para o Novato.
+
+set -e
+
+ACOES=${1:?"Uso: $0 <acoes> [semente] [maior]"}
+SEMENTE=${2:-1}
+MAIOR=${3:-5}
+
+awk -v n="$ACOES" -v s="$SEMENTE" -v m="$MAIOR" 'BEGIN {
+    srand(s)
+    for (i = 0; i < n; i++) printf "%d%s", 1 + int(rand() * m), (i % 32 == 31) ? "\n" : " "
+    printf "0\n"
+}'
@@ -0,0 +1,44 @@
+#!/bin/sh
+# Carga de treino da otimização guiada por perfil (make pgo): executa os
+# binários instrumentados em <dir> com roteiros sintéticos que cobrem as
+# cinco ações do menu e os caminhos sem terminal do Mestre (--lote com as
+# várias opções, --reproduzir, --sessoes, --jogador, --planejar e
+# --analisar), além de uma sessão curta de cada menu interativo.
+# Uso: bench/treinar_pgo.sh <dir>
+
+set -e
+
+DIR=${1:?"Uso: $0 <dir>"}
+RAIZ=$(dirname "$0")
+TEMP=$(mktemp -d)
+trap 'rm -rf "$TEMP"' EXIT
+
+MESTRE=$DIR/tetris_mestre
+"$RAIZ/gerar_roteiro.sh" 2000000 1 > "$TEMP/roteiro.txt"
+"$RAIZ/gerar_roteiro.sh" 500000 2 7 > "$TEMP/roteiro_historico.txt"
+"$RAIZ/gerar_roteiro.sh" 20000 3 > "$TEMP/interativo.txt"
+"$RAIZ/gerar_roteiro.sh" 20000 4 2 | tr ' ' '\n' > "$TEMP/novato.txt"
+"$RAIZ/gerar_roteiro.sh" 20000 5 3 | tr ' ' '\n' > "$TEMP/aventureiro.txt"
+
+# Mestre: modo em lote e suas opções
+"$MESTRE" --semente 1 --lote "$TEMP/roteiro.txt" > /dev/null
+"$MESTRE" --semente 2 --fila 64 --pilha 16 --troca 8 --lote "$TEMP/roteiro.txt" > /dev/null
+"$MESTRE" --semente 3 --historico 256 --estatisticas json --lote "$TEMP/roteiro_historico.txt" > /dev/null
+"$MESTRE" --semente 4 --tabuleiro --lote "$TEMP/roteiro.txt" > /dev/null
+"$MESTRE" --semente 5 --canal 4096 --lote "$TEMP/roteiro.txt" > /dev/null
+"$MESTRE" --semente 6 --diario "$TEMP/diario.bin" --salvar "$TEMP/sessao.inst" --lote "$TEMP/roteiro.txt" > /dev/null
+"$MESTRE" --reproduzir "$TEMP/diario.bin" > /dev/null
+"$MESTRE" --restaurar "$TEMP/sessao.inst" --lote "$TEMP/roteiro.txt" > /dev/null
+
+# Mestre: demais modos sem terminal
+"$MESTRE" --semente 7 --sessoes 10000 --acoes 2000000 --tabuleiro > /dev/null
+"$MESTRE" --semente 8 --jogador 2000 > /dev/null
+for ordem in TOLI IILT OTTL LIOT; do
+    "$MESTRE" --semente 9 --fila 16 --planejar "$ordem" > /dev/null || true
+done
+"$MESTRE" --semente 10 --analisar 20000000 --passos 500000 > /dev/null
+
+# Menus interativos (mensagens de cada ação e renderização)
+"$MESTRE" --semente 11 --interativo --historico 16 < "$TEMP/interativo.txt" > /dev/null
+"$DIR/tetris_aventureiro" < "$TEMP/aventureiro.txt" > /dev/null
+"$DIR/tetris_novato" < "$TEMP/novato.txt" > /dev/null
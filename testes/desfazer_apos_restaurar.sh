@@ -0,0 +1,31 @@
+#!/bin/sh
+# Desfazer depois de --restaurar: o histórico precisa ser dimensionado com o
+# tamanho da troca do instantâneo, não com o de --troca. A ação 5 desfeita
+# deve devolver o estado restaurado, e refeita, o estado depois da ação 5.
+# Uso: testes/desfazer_apos_restaurar.sh [dir dos binários] (padrão: build/release)
+
+set -e
+
+MESTRE=${1:-build/release}/tetris_mestre
+TEMP=$(mktemp -d)
+trap 'rm -rf "$TEMP"' EXIT
+
+# Só o estado da fila e da pilha (sem tempos)
+estado() {
+    printf '%s' "$1" | "$MESTRE" --historico 10 --restaurar "$TEMP/troca5.inst" --lote - 2>/dev/null |
+        grep -E '^(Fila|Pilha) \('
+}
+
+printf '2 2 2 2 2 0' | "$MESTRE" --fila 8 --pilha 8 --troca 5 --semente 7 --salvar "$TEMP/troca5.inst" --lote - > /dev/null
+
+falhas=0
+if [ "$(estado '5 6 0')" != "$(estado '0')" ]; then
+    echo "FALHA: desfazer a acao 5 apos restaurar nao devolveu o estado restaurado" >&2
+    falhas=1
+fi
+if [ "$(estado '5 6 7 0')" != "$(estado '5 0')" ]; then
+    echo "FALHA: refazer a acao 5 apos restaurar nao repetiu a troca" >&2
+    falhas=1
+fi
+[ "$falhas" -eq 0 ] && echo "OK: desfazer/refazer da acao 5 apos restaurar"
+exit "$falhas"